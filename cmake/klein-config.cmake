@@ -9,3 +9,4 @@ find_path(
 target_include_directories(klein::klein INTERFACE ${simde_headers})
 target_include_directories(klein::klein_cxx11 INTERFACE ${simde_headers})
 target_include_directories(klein::klein_sse42 INTERFACE ${simde_headers})
+target_include_directories(klein::klein_fma INTERFACE ${simde_headers})
@@ -0,0 +1,215 @@
+#include "kernels.hpp"
+
+#include <klein/dispatch.hpp>
+
+#include <atomic>
+
+#ifdef _MSC_VER
+#    include <immintrin.h>
+#    include <intrin.h>
+#endif
+
+namespace kln
+{
+namespace dispatch
+{
+    namespace
+    {
+#ifdef _MSC_VER
+        isa detect() noexcept
+        {
+            int regs[4];
+            __cpuid(regs, 0);
+            int max_leaf = regs[0];
+
+            __cpuid(regs, 1);
+            bool sse3    = (regs[2] & (1 << 0)) != 0;
+            bool sse4_1  = (regs[2] & (1 << 19)) != 0;
+            bool osxsave = (regs[2] & (1 << 27)) != 0;
+            bool avx     = (regs[2] & (1 << 28)) != 0;
+
+            // The OS must preserve the YMM (and for AVX-512, the opmask and
+            // ZMM) state across context switches
+            unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+            bool ymm_state          = (xcr0 & 0x6) == 0x6;
+            bool zmm_state          = (xcr0 & 0xe6) == 0xe6;
+
+            bool avx2    = false;
+            bool avx512f = false;
+            if (max_leaf >= 7)
+            {
+                __cpuidex(regs, 7, 0);
+                avx2    = (regs[1] & (1 << 5)) != 0;
+                avx512f = (regs[1] & (1 << 16)) != 0;
+            }
+
+            if (avx && avx2 && avx512f && ymm_state && zmm_state)
+            {
+                return isa::avx512;
+            }
+            if (avx && avx2 && ymm_state)
+            {
+                return isa::avx2;
+            }
+            if (sse3 && sse4_1)
+            {
+                return isa::sse4_1;
+            }
+            return isa::sse3;
+        }
+#else
+        isa detect() noexcept
+        {
+            // The builtins also verify that the OS preserves the extended
+            // register state
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse4.1"))
+            {
+                return isa::sse4_1;
+            }
+            return isa::sse3;
+        }
+#endif
+
+        kernel_table const& table_for(isa tier) noexcept
+        {
+            switch (tier)
+            {
+                case isa::avx512:
+                    return avx512::table;
+                case isa::avx2:
+                    return avx2::table;
+                case isa::sse4_1:
+                    return sse4_1::table;
+                default:
+                    return sse3::table;
+            }
+        }
+
+        // The host is only queried once. Selection races are benign as every
+        // thread stores the same tier.
+        std::atomic<int> active_tier{-1};
+
+        isa current_isa() noexcept
+        {
+            int tier = active_tier.load(std::memory_order_relaxed);
+            if (tier < 0)
+            {
+                tier = static_cast<int>(best_isa());
+                active_tier.store(tier, std::memory_order_relaxed);
+            }
+            return static_cast<isa>(tier);
+        }
+
+        kernel_table const& active() noexcept
+        {
+            return table_for(current_isa());
+        }
+    } // namespace
+
+    char const* isa_name(isa tier) noexcept
+    {
+        switch (tier)
+        {
+            case isa::avx512:
+                return "AVX-512";
+            case isa::avx2:
+                return "AVX2";
+            case isa::sse4_1:
+                return "SSE4.1";
+            default:
+                return "SSE3";
+        }
+    }
+
+    isa best_isa() noexcept
+    {
+        static isa const best = detect();
+        return best;
+    }
+
+    isa active_isa() noexcept
+    {
+        return current_isa();
+    }
+
+    bool select_isa(isa tier) noexcept
+    {
+        if (static_cast<int>(tier) > static_cast<int>(best_isa()))
+        {
+            return false;
+        }
+        active_tier.store(static_cast<int>(tier), std::memory_order_relaxed);
+        return true;
+    }
+
+    void apply(motor const& m,
+               point const* in,
+               point* out,
+               size_t count) noexcept
+    {
+        active().sw312(&m.p1_, &in->p3_, &out->p3_, count);
+    }
+
+    void apply(motor const& m, point_soa const& in, point_soa& out)
+    {
+        out.resize(in.size());
+        active().sw312_soa(&m.p1_,
+                           in.data(),
+                           in.stride(),
+                           out.data(),
+                           out.stride(),
+                           in.size());
+    }
+
+    void apply(motor_soa const& m, point_soa const& in, point_soa& out)
+    {
+        out.resize(m.size());
+        active().sw312_soa_motors(m.data(),
+                                  m.stride(),
+                                  in.data(),
+                                  in.stride(),
+                                  out.data(),
+                                  out.stride(),
+                                  m.size());
+    }
+
+    void compose(motor const* a,
+                 motor const* b,
+                 motor* out,
+                 size_t count) noexcept
+    {
+        active().gpMM(&a->p1_, &b->p1_, &out->p1_, count);
+    }
+
+    void compose(motor_soa const& a, motor_soa const& b, motor_soa& out)
+    {
+        out.resize(a.size());
+        active().gpMM_soa(a.data(),
+                          a.stride(),
+                          b.data(),
+                          b.stride(),
+                          out.data(),
+                          out.stride(),
+                          a.size());
+    }
+
+    void exp(line const* in, motor* out, size_t count) noexcept
+    {
+        active().exp(&in->p1_, &out->p1_, count);
+    }
+
+    void log(motor const* in, line* out, size_t count) noexcept
+    {
+        active().log(&in->p1_, &out->p1_, count);
+    }
+} // namespace dispatch
+} // namespace kln
@@ -0,0 +1,106 @@
+// File: kernels.cpp
+// Purpose: Instantiate the batched kernels for a single instruction set tier.
+// This file is compiled once per tier with the matching architecture flags
+// and Klein defines (see CMakeLists.txt).
+//
+// Notes:
+// 1. Only the forced-inline kernels in klein/detail may be used here. Any
+//    other inline function would be emitted as a weak symbol in every tier,
+//    and the linker is free to keep, say, the AVX-512 copy and call it on a
+//    machine without AVX-512.
+// 2. Everything other than the table itself has internal linkage for the
+//    same reason.
+
+#include "kernels.hpp"
+
+#include <klein/detail/exp_log.hpp>
+#include <klein/detail/geometric_product.hpp>
+#include <klein/detail/sandwich.hpp>
+#include <klein/detail/soa.hpp>
+
+#ifndef KLN_DISPATCH_TIER
+#    error "KLN_DISPATCH_TIER must name the tier this file is compiled for"
+#endif
+
+namespace kln
+{
+namespace dispatch
+{
+namespace KLN_DISPATCH_TIER
+{
+    namespace
+    {
+        void sw312(__m128 const* m,
+                   __m128 const* in,
+                   __m128* out,
+                   size_t count) noexcept
+        {
+            kln::detail::sw312<true, true>(in, m[0], m + 1, out, count);
+        }
+
+        void sw312_soa(__m128 const* m,
+                       float const* in,
+                       size_t in_stride,
+                       float* out,
+                       size_t out_stride,
+                       size_t count) noexcept
+        {
+            kln::detail::sw312_soa<true>(
+                m[0], m + 1, in, in_stride, out, out_stride, count);
+        }
+
+        void sw312_soa_motors(float const* m,
+                              size_t m_stride,
+                              float const* in,
+                              size_t in_stride,
+                              float* out,
+                              size_t out_stride,
+                              size_t count) noexcept
+        {
+            kln::detail::sw312_soa_motors(
+                m, m_stride, in, in_stride, out, out_stride, count);
+        }
+
+        void gpMM(__m128 const* a,
+                  __m128 const* b,
+                  __m128* out,
+                  size_t count) noexcept
+        {
+            for (size_t i = 0; i != count; ++i)
+            {
+                // Compose into temporaries so that out may alias a or b
+                __m128 tmp[2];
+                kln::detail::gpMM(a[2 * i], b[2 * i], tmp);
+                out[2 * i]     = tmp[0];
+                out[2 * i + 1] = tmp[1];
+            }
+        }
+
+        void gpMM_soa(float const* a,
+                      size_t a_stride,
+                      float const* b,
+                      size_t b_stride,
+                      float* out,
+                      size_t out_stride,
+                      size_t count) noexcept
+        {
+            kln::detail::gpMM_soa(
+                a, a_stride, b, b_stride, out, out_stride, count);
+        }
+
+        void exp(__m128 const* in, __m128* out, size_t count) noexcept
+        {
+            kln::detail::exp_batch(in, out, count);
+        }
+
+        void log(__m128 const* in, __m128* out, size_t count) noexcept
+        {
+            kln::detail::log_batch(in, out, count);
+        }
+    } // namespace
+
+    kernel_table const table
+        = {sw312, sw312_soa, sw312_soa_motors, gpMM, gpMM_soa, exp, log};
+} // namespace KLN_DISPATCH_TIER
+} // namespace dispatch
+} // namespace kln
@@ -0,0 +1,86 @@
+// File: kernels.hpp
+// Purpose: Declare the table of batched kernels compiled once per instruction
+// set tier. kernels.cpp is compiled several times with different architecture
+// flags, each time with KLN_DISPATCH_TIER naming the namespace its table is
+// defined in.
+
+#pragma once
+
+#include <klein/detail/sse.hpp>
+
+#include <cstddef>
+
+namespace kln
+{
+namespace dispatch
+{
+    // All entities are passed as pointers to their partitions. Motors and
+    // lines are pairs of consecutive registers (p1, p2).
+    struct kernel_table
+    {
+        // Conjugate count points with the motor m
+        void (*sw312)(__m128 const* m,
+                      __m128 const* in,
+                      __m128* out,
+                      size_t count) noexcept;
+
+        // Conjugate SoA points with the motor m
+        void (*sw312_soa)(__m128 const* m,
+                          float const* in,
+                          size_t in_stride,
+                          float* out,
+                          size_t out_stride,
+                          size_t count) noexcept;
+
+        // Conjugate SoA points with SoA motors lane by lane
+        void (*sw312_soa_motors)(float const* m,
+                                 size_t m_stride,
+                                 float const* in,
+                                 size_t in_stride,
+                                 float* out,
+                                 size_t out_stride,
+                                 size_t count) noexcept;
+
+        // Compose count pairs of motors
+        void (*gpMM)(__m128 const* a,
+                     __m128 const* b,
+                     __m128* out,
+                     size_t count) noexcept;
+
+        // Compose SoA motors lane by lane
+        void (*gpMM_soa)(float const* a,
+                         size_t a_stride,
+                         float const* b,
+                         size_t b_stride,
+                         float* out,
+                         size_t out_stride,
+                         size_t count) noexcept;
+
+        // Exponentiate count lines into motors
+        void (*exp)(__m128 const* in, __m128* out, size_t count) noexcept;
+
+        // Take the logarithm of count motors
+        void (*log)(__m128 const* in, __m128* out, size_t count) noexcept;
+    };
+
+    namespace sse3
+    {
+        extern kernel_table const table;
+    }
+
+    namespace sse4_1
+    {
+        extern kernel_table const table;
+    }
+
+    namespace avx2
+    {
+        extern kernel_table const table;
+    }
+
+    namespace avx512
+    {
+        extern kernel_table const table;
+    }
+} // namespace dispatch
+} // namespace kln
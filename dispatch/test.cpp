@@ -0,0 +1,149 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <klein/dispatch.hpp>
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+namespace
+{
+// Invokes f once for every tier supported by the host
+template <typename F>
+void for_each_isa(F f)
+{
+    dispatch::isa tiers[] = {dispatch::isa::sse3,
+                             dispatch::isa::sse4_1,
+                             dispatch::isa::avx2,
+                             dispatch::isa::avx512};
+    for (dispatch::isa tier : tiers)
+    {
+        if (dispatch::select_isa(tier))
+        {
+            CHECK_EQ(dispatch::active_isa(), tier);
+            f();
+        }
+    }
+    dispatch::select_isa(dispatch::best_isa());
+}
+} // namespace
+
+TEST_CASE("dispatch-select")
+{
+    CHECK(dispatch::select_isa(dispatch::isa::sse3));
+    CHECK_EQ(dispatch::active_isa(), dispatch::isa::sse3);
+    CHECK(dispatch::select_isa(dispatch::best_isa()));
+    CHECK_EQ(dispatch::active_isa(), dispatch::best_isa());
+}
+
+TEST_CASE("dispatch-motor-point")
+{
+    for_each_isa([] {
+        motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+        point ps[3] = {point{-1.f, 1.f, 2.f},
+                       point{-1.f, 1.f, 2.f},
+                       point{-1.f, 1.f, 2.f}};
+        dispatch::apply(m, ps, ps, 3);
+        for (point const& p : ps)
+        {
+            CHECK_EQ(p.x(), -12.f);
+            CHECK_EQ(p.y(), -86.f);
+            CHECK_EQ(p.z(), -86.f);
+            CHECK_EQ(p.w(), 30.f);
+        }
+
+        point_soa batch{19};
+        for (size_t i = 0; i != 19; ++i)
+        {
+            batch.set(i, point{-1.f, 1.f, 2.f});
+        }
+        dispatch::apply(m, batch, batch);
+        point p = batch.get(18);
+        CHECK_EQ(p.x(), -12.f);
+        CHECK_EQ(p.y(), -86.f);
+        CHECK_EQ(p.z(), -86.f);
+        CHECK_EQ(p.w(), 30.f);
+
+        motor_soa ms{19};
+        for (size_t i = 0; i != 19; ++i)
+        {
+            batch.set(i, point{-1.f, 1.f, 2.f});
+            ms.set(i, m);
+        }
+        point_soa out;
+        dispatch::apply(ms, batch, out);
+        p = out.get(18);
+        CHECK_EQ(p.x(), -12.f);
+        CHECK_EQ(p.w(), 30.f);
+    });
+}
+
+TEST_CASE("dispatch-motor-compose")
+{
+    for_each_isa([] {
+        motor as[5];
+        motor bs[5];
+        for (size_t i = 0; i != 5; ++i)
+        {
+            float f = static_cast<float>(i);
+            as[i]   = motor{1.f, 4.f - f, 3.f, 2.f + f, 5.f, 6.f, 7.f - f, 8.f};
+            bs[i]   = motor{2.f, -1.f, 3.f + f, 1.f, 4.f, -2.f + f, 1.f, 3.f};
+        }
+
+        motor out[5];
+        dispatch::compose(as, bs, out, 5);
+
+        motor_soa a{as, 5};
+        motor_soa b{bs, 5};
+        dispatch::compose(a, b, a);
+
+        for (size_t i = 0; i != 5; ++i)
+        {
+            motor expected = as[i] * bs[i];
+            CHECK_EQ(out[i].scalar(), expected.scalar());
+            CHECK_EQ(out[i].e23(), expected.e23());
+            CHECK_EQ(out[i].e0123(), expected.e0123());
+            CHECK_EQ(out[i].e03(), expected.e03());
+
+            motor m = a.get(i);
+            CHECK_EQ(m.scalar(), expected.scalar());
+            CHECK_EQ(m.e23(), expected.e23());
+            CHECK_EQ(m.e0123(), expected.e0123());
+            CHECK_EQ(m.e03(), expected.e03());
+        }
+
+        // In place composition
+        dispatch::compose(as, bs, as, 5);
+        CHECK_EQ(as[4].e12(), out[4].e12());
+    });
+}
+
+TEST_CASE("dispatch-exp-log")
+{
+    for_each_isa([] {
+        rotor r{kln::pi * 0.5f, 0.3f, -3.f, 1.f};
+        translator t{12.f, -2.f, 0.4f, 1.f};
+        motor ms[2] = {r * t, t * r};
+
+        line logs[2];
+        dispatch::log(ms, logs, 2);
+        motor exps[2];
+        dispatch::exp(logs, exps, 2);
+
+        for (size_t i = 0; i != 2; ++i)
+        {
+            line expected = kln::log(ms[i]);
+            CHECK_EQ(logs[i].e12(), doctest::Approx(expected.e12()));
+            CHECK_EQ(logs[i].e01(), doctest::Approx(expected.e01()));
+
+            CHECK_EQ(exps[i].scalar(), doctest::Approx(ms[i].scalar()));
+            CHECK_EQ(exps[i].e23(), doctest::Approx(ms[i].e23()));
+            CHECK_EQ(exps[i].e31(), doctest::Approx(ms[i].e31()));
+            CHECK_EQ(exps[i].e12(), doctest::Approx(ms[i].e12()));
+            CHECK_EQ(exps[i].e01(), doctest::Approx(ms[i].e01()));
+            CHECK_EQ(exps[i].e02(), doctest::Approx(ms[i].e02()));
+            CHECK_EQ(exps[i].e03(), doctest::Approx(ms[i].e03()));
+            CHECK_EQ(exps[i].e0123(), doctest::Approx(ms[i].e0123()));
+        }
+    });
+}
@@ -0,0 +1,70 @@
+// Compares the throughput of the batched motor logarithm and line
+// exponential against the single-entity routines. Unlike the mc_ruler targets,
+// this is a wall clock measurement since the scalar path calls into libm.
+
+#include <klein/klein.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+constexpr size_t count      = 4096;
+constexpr size_t iterations = 2000;
+
+template <typename F>
+double measure(F&& f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i != iterations; ++i)
+    {
+        f();
+    }
+    std::chrono::duration<double, std::nano> elapsed
+        = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations * count);
+}
+} // namespace
+
+int main()
+{
+    std::vector<kln::motor> motors(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f = static_cast<float>(i % 97);
+        kln::rotor r{0.05f * f - 2.f, 1.f, 0.1f * f, -0.5f};
+        kln::translator t{0.5f * f, 0.f, 1.f, 0.2f * f};
+        motors[i] = r * t;
+    }
+    std::vector<kln::line> lines(count);
+    std::vector<kln::motor> out(count);
+
+    double log_scalar = measure([&] {
+        for (size_t i = 0; i != count; ++i)
+        {
+            lines[i] = kln::log(motors[i]);
+        }
+    });
+    double log_batch
+        = measure([&] { kln::log(motors.data(), lines.data(), count); });
+
+    double exp_scalar = measure([&] {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i] = kln::exp(lines[i]);
+        }
+    });
+    double exp_batch
+        = measure([&] { kln::exp(lines.data(), out.data(), count); });
+
+    std::printf("log: %6.2f ns scalar, %6.2f ns batched (%.2fx)\n",
+                log_scalar,
+                log_batch,
+                log_scalar / log_batch);
+    std::printf("exp: %6.2f ns scalar, %6.2f ns batched (%.2fx)\n",
+                exp_scalar,
+                exp_batch,
+                exp_scalar / exp_batch);
+    return out[count / 2].scalar() > 2.f;
+}
@@ -33,6 +33,14 @@ kln::point motor_application(kln::motor const& m, kln::point const& p)
     return out;
 }
 
+kln::line motor_line_application(kln::motor const& m, kln::line const& l)
+{
+    MC_MEASURE_BEGIN(motor_line_application);
+    auto out = m(l);
+    MC_MEASURE_END();
+    return out;
+}
+
 kln::mat3x4 motor_to_mat3x4(kln::motor const& m)
 {
     MC_MEASURE_BEGIN(motor_to_mat3x4);
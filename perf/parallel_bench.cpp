@@ -0,0 +1,80 @@
+// Measures how the batched motor application scales with the number of
+// threads when split into tiles by kln::parallel::transform. Both an
+// L2-resident batch and a batch that streams from memory are reported, since
+// the latter saturates memory bandwidth well before all cores are busy.
+
+#include <klein/klein.hpp>
+#include <klein/parallel.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+template <typename F>
+double measure(size_t iterations, F&& f)
+{
+    // Warm up the caches and the pool's threads
+    f();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i != iterations; ++i)
+    {
+        f();
+    }
+    std::chrono::duration<double, std::micro> elapsed
+        = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+template <typename T>
+void run(char const* name, size_t count, size_t iterations, size_t max_threads)
+{
+    kln::motor m{2.f, 4.f, 3.f, -1.f, -5.f, 6.f, 2.f, -3.f};
+    m.normalize();
+    std::vector<T> in(count);
+    std::vector<T> out(count);
+
+    std::printf("%s x %zu (%zu KiB)\n", name, count, count * sizeof(T) / 1024);
+    std::printf("%8s %12s %9s\n", "threads", "us", "speedup");
+
+    double serial = measure(
+        iterations, [&] { m(in.data(), out.data(), count); });
+    std::printf("%8s %12.1f %9.2f\n", "serial", serial, 1.0);
+
+    for (size_t threads = 1; threads <= max_threads;)
+    {
+        kln::parallel::thread_pool pool{threads};
+        double t = measure(iterations, [&] {
+            kln::parallel::transform(pool, m, in.data(), out.data(), count);
+        });
+        std::printf("%8zu %12.1f %9.2f\n", threads, t, serial / t);
+
+        if (threads == max_threads)
+        {
+            break;
+        }
+        threads = threads * 2 < max_threads ? threads * 2 : max_threads;
+    }
+    std::printf("\n");
+}
+} // namespace
+
+// Usage: klein_parallel_bench [max threads]
+int main(int argc, char** argv)
+{
+    size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency();
+    if (max_threads == 0)
+    {
+        max_threads = 1;
+    }
+
+    run<kln::point>("point", 1 << 14, 2000, max_threads);
+    run<kln::point>("point", 1 << 22, 20, max_threads);
+    run<kln::line>("line", 1 << 21, 20, max_threads);
+    return 0;
+}
@@ -0,0 +1,440 @@
+#pragma once
+
+#include "detail/cull.hpp"
+#include "motor_soa.hpp"
+#include "soa.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef KLEIN_VALIDATE
+#    include <cassert>
+#endif
+
+namespace kln
+{
+/// \defgroup culling Frustum Culling
+///
+/// A `frustum` is bounded by six planes oriented such that the interior of
+/// the frustum lies on their positive side. Bounding spheres and axis-aligned
+/// bounding boxes are stored as SoA batches (`sphere_soa` and `aabb_soa`)
+/// and tested against all six planes 4, 8, or 16 bounds at a time (with SSE,
+/// AVX2, and AVX-512 respectively). A sphere with center $c$ and radius $r$ is
+/// culled if $p \cdot c < -r$ for any normalized plane $p$ of the frustum, and
+/// a box is tested as a sphere with the radius $|n_x| h_x + |n_y| h_y + |n_z|
+/// h_z$ for each plane with normal $n$ (where $h$ holds the half extents).
+/// Bounds that intersect a corner region outside the frustum may be reported
+/// as visible, as is usual for plane-based culling.
+///
+/// The results are written as a bitmask with one bit per bound, packed into
+/// `(count + 31) / 32` words of 32 bits. Bound `i` is visible if bit `i % 32`
+/// of word `i / 32` is set.
+///
+/// The bounds of instanced objects are usually stored in model space along
+/// with one motor per instance. Passing a `motor_soa` moves each bound with
+/// the motor of the same index before testing it, in the same pass. A moved
+/// box is bounded by the axis-aligned box enclosing it.
+///
+/// !!! example
+///
+///     ```c++
+///         // Planes of the frustum with normals pointing inwards
+///         kln::frustum view{left, right, bottom, top, front, back};
+///
+///         kln::sphere_soa bounds{centers.data(), radii.data(), count};
+///         std::vector<uint32_t> visible((count + 31) / 32);
+///         kln::cull(view, bounds, visible.data());
+///
+///         // Or, with model space bounds and one motor per instance
+///         kln::cull(view, instances, bounds, visible.data());
+///     ```
+
+/// \addtogroup culling
+/// @{
+
+/// Six planes bounding a view volume.
+class frustum final
+{
+public:
+    frustum() noexcept = default;
+
+    /// Create a frustum from six planes whose positive sides contain the
+    /// interior. The planes are normalized on construction.
+    frustum(plane left,
+            plane right,
+            plane bottom,
+            plane top,
+            plane front,
+            plane back) noexcept
+    {
+        planes_[0] = unit(left);
+        planes_[1] = unit(right);
+        planes_[2] = unit(bottom);
+        planes_[3] = unit(top);
+        planes_[4] = unit(front);
+        planes_[5] = unit(back);
+    }
+
+    /// Create a frustum from an array of six planes (see above).
+    explicit frustum(plane const* planes) noexcept
+        : frustum{planes[0],
+                  planes[1],
+                  planes[2],
+                  planes[3],
+                  planes[4],
+                  planes[5]}
+    {}
+
+    /// The i-th plane in the order left, right, bottom, top, near (front), and
+    /// far (back).
+    [[nodiscard]] plane const& operator[](size_t i) const noexcept
+    {
+        return planes_[i];
+    }
+
+private:
+    // Scales the plane such that its normal has unit length. Unlike
+    // plane::normalize, the e0 component is scaled as well so that the
+    // plane evaluates to the signed distance.
+    static plane unit(plane p) noexcept
+    {
+        p /= p.norm();
+        return p;
+    }
+
+    plane planes_[6];
+};
+
+/// A batch of bounding spheres stored as separate `x`, `y`, and `z` streams
+/// for the centers and a `radius` stream.
+class sphere_soa final
+{
+public:
+    sphere_soa() noexcept = default;
+
+    /// Create a batch of `count` zero-initialized spheres.
+    explicit sphere_soa(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Create a batch from `count` normalized centers and their radii.
+    sphere_soa(point const* centers, float const* radii, size_t count)
+    {
+        load(centers, radii, count);
+    }
+
+    /// Resize the batch, preserving existing elements. Newly added elements
+    /// are zero-initialized.
+    void resize(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Replace the contents of this batch with `count` normalized centers and
+    /// their radii.
+    void load(point const* centers, float const* radii, size_t count)
+    {
+        buf_.resize(count);
+        if (count > 0)
+        {
+            // The weights of the centers land in the radius stream
+            buf_.load(&centers->p3_, count);
+            std::memcpy(radius(), radii, count * sizeof(float));
+        }
+    }
+
+    [[nodiscard]] point center(size_t i) const noexcept
+    {
+        return {x()[i], y()[i], z()[i]};
+    }
+
+    void set(size_t i, point const& center, float r) noexcept
+    {
+        buf_.set(i, center.p3_);
+        radius()[i] = r;
+    }
+
+    /// Number of spheres in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /// Distance in floats between consecutive streams. This is the size
+    /// rounded up to a multiple of 16.
+    [[nodiscard]] size_t stride() const noexcept
+    {
+        return buf_.stride();
+    }
+
+    /// Pointer to the start of the stream buffer. The `x`, `y`, `z`, and
+    /// `radius` streams follow one another, separated by `stride()` floats.
+    [[nodiscard]] float* data() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* data() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* x() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* x() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* y() noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float const* y() const noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float* z() noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float const* z() const noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float* radius() noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+    [[nodiscard]] float const* radius() const noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+private:
+    detail::soa_buffer<4> buf_;
+};
+
+/// A batch of axis-aligned bounding boxes stored as the `x`, `y`, and `z`
+/// streams of their centers followed by the `hx`, `hy`, and `hz` streams of
+/// their half extents. The streams are laid out as a pair of points, so the
+/// half extents start at an offset of `4 * stride()` floats.
+class aabb_soa final
+{
+public:
+    aabb_soa() noexcept = default;
+
+    /// Create a batch of `count` zero-initialized boxes.
+    explicit aabb_soa(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Create a batch from the normalized minimum and maximum corners of
+    /// `count` boxes.
+    aabb_soa(point const* min, point const* max, size_t count)
+    {
+        buf_.resize(count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            set(i, min[i], max[i]);
+        }
+    }
+
+    /// Resize the batch, preserving existing elements. Newly added elements
+    /// are zero-initialized.
+    void resize(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Set the i-th box from its normalized minimum and maximum corners.
+    void set(size_t i, point const& min, point const& max) noexcept
+    {
+        __m128 half = _mm_set1_ps(0.5f);
+        buf_.set(i, _mm_mul_ps(_mm_add_ps(min.p3_, max.p3_), half), 0);
+        buf_.set(i, _mm_mul_ps(_mm_sub_ps(max.p3_, min.p3_), half), 1);
+    }
+
+    [[nodiscard]] point center(size_t i) const noexcept
+    {
+        return {x()[i], y()[i], z()[i]};
+    }
+
+    /// Number of boxes in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /// Distance in floats between consecutive streams. This is the size
+    /// rounded up to a multiple of 16.
+    [[nodiscard]] size_t stride() const noexcept
+    {
+        return buf_.stride();
+    }
+
+    /// Pointer to the start of the stream buffer.
+    [[nodiscard]] float* data() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* data() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* x() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* x() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* y() noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float const* y() const noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float* z() noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float const* z() const noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float* hx() noexcept
+    {
+        return buf_.data() + 4 * stride();
+    }
+
+    [[nodiscard]] float const* hx() const noexcept
+    {
+        return buf_.data() + 4 * stride();
+    }
+
+    [[nodiscard]] float* hy() noexcept
+    {
+        return buf_.data() + 5 * stride();
+    }
+
+    [[nodiscard]] float const* hy() const noexcept
+    {
+        return buf_.data() + 5 * stride();
+    }
+
+    [[nodiscard]] float* hz() noexcept
+    {
+        return buf_.data() + 6 * stride();
+    }
+
+    [[nodiscard]] float const* hz() const noexcept
+    {
+        return buf_.data() + 6 * stride();
+    }
+
+private:
+    detail::soa_buffer<8> buf_;
+};
+
+namespace detail
+{
+    KLN_INLINE void KLN_VEC_CALL frustum_planes(frustum const& f,
+                                                __m128* out) noexcept
+    {
+        for (size_t i = 0; i != 6; ++i)
+        {
+            out[i] = f[i].p0_;
+        }
+    }
+} // namespace detail
+
+/// Write the visibility of each sphere of `in` to `visible`, which must hold
+/// at least `(in.size() + 31) / 32` words.
+inline void cull(frustum const& f, sphere_soa const& in, uint32_t* visible)
+{
+    __m128 planes[6];
+    detail::frustum_planes(f, planes);
+    detail::cull_spheres_soa<false>(
+        planes, nullptr, 0, in.data(), in.stride(), visible, in.size());
+}
+
+/// Write the visibility of each box of `in` to `visible`, which must hold at
+/// least `(in.size() + 31) / 32` words.
+inline void cull(frustum const& f, aabb_soa const& in, uint32_t* visible)
+{
+    __m128 planes[6];
+    detail::frustum_planes(f, planes);
+    detail::cull_boxes_soa<false>(
+        planes, nullptr, 0, in.data(), in.stride(), visible, in.size());
+}
+
+/// Move the i-th sphere of `in` with the i-th motor of `m`, then write its
+/// visibility to `visible`, which must hold at least `(in.size() + 31) / 32`
+/// words. The motors must be normalized and `m` must contain at least
+/// `in.size()` motors. The spheres are not modified.
+inline void cull(frustum const& f,
+                 motor_soa const& m,
+                 sphere_soa const& in,
+                 uint32_t* visible)
+{
+#ifdef KLEIN_VALIDATE
+    assert(m.size() >= in.size() && "Too few motors for the batch");
+#endif
+    __m128 planes[6];
+    detail::frustum_planes(f, planes);
+    detail::cull_spheres_soa<true>(planes,
+                                   m.data(),
+                                   m.stride(),
+                                   in.data(),
+                                   in.stride(),
+                                   visible,
+                                   in.size());
+}
+
+/// Move the i-th box of `in` with the i-th motor of `m`, then write the
+/// visibility of the axis-aligned box enclosing it to `visible`, which must
+/// hold at least `(in.size() + 31) / 32` words. The motors must be normalized
+/// and `m` must contain at least `in.size()` motors. The boxes are not
+/// modified.
+inline void cull(frustum const& f,
+                 motor_soa const& m,
+                 aabb_soa const& in,
+                 uint32_t* visible)
+{
+#ifdef KLEIN_VALIDATE
+    assert(m.size() >= in.size() && "Too few motors for the batch");
+#endif
+    __m128 planes[6];
+    detail::frustum_planes(f, planes);
+    detail::cull_boxes_soa<true>(planes,
+                                 m.data(),
+                                 m.stride(),
+                                 in.data(),
+                                 in.stride(),
+                                 visible,
+                                 in.size());
+}
+/// @}
+} // namespace kln
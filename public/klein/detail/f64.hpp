@@ -0,0 +1,4 @@
+#pragma once
+
+#include "x86/x86_f64_geometric_product.hpp"
+#include "x86/x86_f64_sandwich.hpp"
\ No newline at end of file
@@ -0,0 +1,157 @@
+// File: x86_compress.hpp
+// Purpose: Quantize and dequantize soa_width motors at a time for the
+// compressed_motor storage format (see compressed_motor.hpp).
+//
+// Notes:
+// 1. The kernels exchange the quantized fields as 7 integer streams of
+//    soa_width lanes each: the three retained rotor components (15-bit
+//    unsigned), the index of the dropped rotor component, and the three
+//    translation components (16-bit signed). Bit packing is left to the
+//    caller.
+// 2. The motor is presumed to be normalized and is decomposed as the
+//    product of a translator and a rotor: m = t r. With r = (a0, a1, a2, a3)
+//    and t = 1 + b1 e01 + b2 e02 + b3 e03, the second partition of m is
+//
+//    (a1 b1 + a2 b2 + a3 b3) e0123 +
+//    (a0 b1 + a2 b3 - a3 b2) e01 +
+//    (a0 b2 + a3 b1 - a1 b3) e02 +
+//    (a0 b3 + a1 b2 - a2 b1) e03
+//
+//    which is an orthogonal map of b (for a unit rotor), so b is recovered
+//    with its transpose.
+
+#pragma once
+
+#include "x86_soa_math.hpp"
+
+namespace kln
+{
+namespace detail
+{
+    // The retained rotor components lie in [-1/sqrt(2), 1/sqrt(2)]
+    constexpr float quat_range    = 0.707106781186548f;
+    constexpr float quat_quantize = 32767.f * 0.5f / quat_range;
+    constexpr float quat_restore  = quat_range * 2.f / 32767.f;
+
+    // in: soa_width motors as (p1, p2) pairs
+    // streams: 7 * soa_width integers
+    // translation_scale: quantized units per unit of translation
+    KLN_INLINE void KLN_VEC_CALL soa_encode_motors(__m128 const* in,
+                                                   float translation_scale,
+                                                   int32_t* streams) noexcept
+    {
+        soa_reg a[4];
+        soa_reg p[4];
+        soa_gather4(in, 2, a);
+        soa_gather4(in + 1, 2, p);
+
+        // Find the rotor component with the largest magnitude
+        soa_reg sign      = soa_set1(-0.f);
+        soa_reg largest   = a[0];
+        soa_reg magnitude = soa_xor(a[0], soa_and(a[0], sign));
+        soa_reg index     = soa_set1(0.f);
+        for (int i = 1; i != 4; ++i)
+        {
+            soa_reg abs_i = soa_xor(a[i], soa_and(a[i], sign));
+            soa_pred gt   = soa_lt(magnitude, abs_i);
+            magnitude     = soa_select(gt, abs_i, magnitude);
+            largest       = soa_select(gt, a[i], largest);
+            index = soa_select(gt, soa_set1(static_cast<float>(i)), index);
+        }
+
+        // The motor and its negation represent the same transform. Flip the
+        // rotor such that the dropped component is positive so it can be
+        // restored with a positive square root. The translator is unaffected.
+        soa_reg flip = soa_and(largest, sign);
+        soa_reg r[3];
+        r[0] = soa_select(soa_lt(index, soa_set1(0.5f)), a[1], a[0]);
+        r[1] = soa_select(soa_lt(index, soa_set1(1.5f)), a[2], a[1]);
+        r[2] = soa_select(soa_lt(index, soa_set1(2.5f)), a[3], a[2]);
+
+        soa_reg zero  = soa_set1(0.f);
+        soa_reg limit = soa_set1(32767.f);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            soa_reg q = soa_xor(r[i], flip);
+            q = soa_mul(soa_add(q, soa_set1(quat_range)),
+                        soa_set1(quat_quantize));
+            q = soa_min(soa_max(q, zero), limit);
+            soa_istore(streams + i * soa_width, soa_cvt_int(q));
+        }
+        soa_istore(streams + 3 * soa_width, soa_cvt_int(index));
+
+        // b = -translation / 2 (see the translator constructor)
+        soa_reg b[3];
+        b[0] = soa_add(soa_add(soa_mul(a[1], p[0]), soa_mul(a[0], p[1])),
+                       soa_sub(soa_mul(a[3], p[2]), soa_mul(a[2], p[3])));
+        b[1] = soa_add(soa_sub(soa_mul(a[2], p[0]), soa_mul(a[3], p[1])),
+                       soa_add(soa_mul(a[0], p[2]), soa_mul(a[1], p[3])));
+        b[2] = soa_add(soa_add(soa_mul(a[3], p[0]), soa_mul(a[2], p[1])),
+                       soa_sub(soa_mul(a[0], p[3]), soa_mul(a[1], p[2])));
+
+        soa_reg scale = soa_set1(-2.f * translation_scale);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            soa_reg q = soa_mul(b[i], scale);
+            q         = soa_min(soa_max(q, soa_sub(zero, limit)), limit);
+            soa_istore(streams + (4 + i) * soa_width, soa_cvt_int(q));
+        }
+    }
+
+    // streams: 7 * soa_width integers as produced by soa_encode_motors
+    // out: soa_width motors as (p1, p2) pairs
+    // translation_scale: units of translation per quantized unit
+    KLN_INLINE void KLN_VEC_CALL soa_decode_motors(int32_t const* streams,
+                                                   float translation_scale,
+                                                   __m128* out) noexcept
+    {
+        soa_reg r[3];
+        soa_reg restore = soa_set1(quat_restore);
+        soa_reg offset  = soa_set1(quat_range);
+        soa_reg norm    = soa_set1(1.f);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            r[i] = soa_sub(
+                soa_mul(soa_cvt_float(soa_iload(streams + i * soa_width)),
+                        restore),
+                offset);
+            norm = soa_sub(norm, soa_mul(r[i], r[i]));
+        }
+        // Quantization error may push the sum of squares slightly past 1
+        soa_reg d = soa_sqrt(soa_max(norm, soa_set1(0.f)));
+
+        soa_ireg index = soa_iload(streams + 3 * soa_width);
+        soa_pred is0   = soa_ieq(index, 0);
+        soa_pred is1   = soa_ieq(index, 1);
+        soa_pred is2   = soa_ieq(index, 2);
+        soa_pred is3   = soa_ieq(index, 3);
+
+        soa_reg a[4];
+        a[0] = soa_select(is0, d, r[0]);
+        a[1] = soa_select(is0, r[0], soa_select(is1, d, r[1]));
+        a[2] = soa_select(is3, r[2], soa_select(is2, d, r[1]));
+        a[3] = soa_select(is3, d, r[2]);
+
+        soa_reg scale = soa_set1(-0.5f * translation_scale);
+        soa_reg b[3];
+        for (size_t i = 0; i != 3; ++i)
+        {
+            b[i] = soa_mul(
+                soa_cvt_float(soa_iload(streams + (4 + i) * soa_width)), scale);
+        }
+
+        soa_reg p[4];
+        p[0] = soa_add(soa_mul(a[1], b[0]),
+                       soa_add(soa_mul(a[2], b[1]), soa_mul(a[3], b[2])));
+        p[1] = soa_add(soa_mul(a[0], b[0]),
+                       soa_sub(soa_mul(a[2], b[2]), soa_mul(a[3], b[1])));
+        p[2] = soa_add(soa_mul(a[0], b[1]),
+                       soa_sub(soa_mul(a[3], b[0]), soa_mul(a[1], b[2])));
+        p[3] = soa_add(soa_mul(a[0], b[2]),
+                       soa_sub(soa_mul(a[1], b[1]), soa_mul(a[2], b[0])));
+
+        soa_scatter4(a, out, 2);
+        soa_scatter4(p, out + 1, 2);
+    }
+} // namespace detail
+} // namespace kln
@@ -0,0 +1,221 @@
+// File: x86_cull.hpp
+// Purpose: Test batches of SoA bounding spheres and boxes against the six
+// planes of a view frustum, optionally after moving each bound with its own
+// motor.
+//
+// Notes:
+// 1. The frustum planes are normalized and oriented such that the interior
+//    of the frustum lies on their positive side. A bound is culled if it lies
+//    entirely on the negative side of any plane.
+// 2. Spheres are stored as streams (x, y, z, r) and are visible if
+//    n.c + d >= -r for every plane (n, d). Boxes are stored as the streams
+//    (x, y, z, w) of the center followed by the streams (hx, hy, hz, 0) of
+//    the half extents, and are visible if n.c + d >= -|n|.h, where |n| is
+//    taken component-wise.
+// 3. A normalized motor moves a sphere by moving its center. A box moved by
+//    the rotation R is bounded by the box with the moved center and half
+//    extents |R|h. Motors are streamed as in motor_soa.
+// 4. Visibility is reported as one bit per bound in 32-bit words (see
+//    soa_store_bits). Bits past count in the final word are cleared.
+
+#pragma once
+
+#include "x86_soa_math.hpp"
+
+namespace kln
+{
+namespace detail
+{
+    // Broadcasts the six frustum planes f (p0) as (x, y, z, d) and, if abs
+    // is non-null, the component-wise absolute values of their normals
+    KLN_INLINE void KLN_VEC_CALL soa_frustum(__m128 const* f,
+                                             soa_reg* p,
+                                             soa_reg* abs) noexcept
+    {
+        for (size_t j = 0; j != 6; ++j)
+        {
+            float pf[4];
+            _mm_storeu_ps(pf, f[j]);
+            p[4 * j]     = soa_set1(pf[1]);
+            p[4 * j + 1] = soa_set1(pf[2]);
+            p[4 * j + 2] = soa_set1(pf[3]);
+            p[4 * j + 3] = soa_set1(pf[0]);
+            if (abs != nullptr)
+            {
+                abs[3 * j]     = soa_abs(p[4 * j]);
+                abs[3 * j + 1] = soa_abs(p[4 * j + 1]);
+                abs[3 * j + 2] = soa_abs(p[4 * j + 2]);
+            }
+        }
+    }
+
+    // Moves the centers c and, if Box is true, the half extents h of the
+    // bounds at offset i with the motors m
+    template <bool Box>
+    KLN_INLINE void KLN_VEC_CALL soa_move_bounds(float const* m,
+                                                 size_t m_stride,
+                                                 size_t i,
+                                                 soa_mask k,
+                                                 soa_reg* c,
+                                                 soa_reg* h) noexcept
+    {
+        soa_reg b1 = soa_load(m + i, k);
+        soa_reg b2 = soa_load(m + m_stride + i, k);
+        soa_reg b3 = soa_load(m + 2 * m_stride + i, k);
+        soa_reg b0 = soa_load(m + 3 * m_stride + i, k);
+        soa_reg c1 = soa_load(m + 4 * m_stride + i, k);
+        soa_reg c2 = soa_load(m + 5 * m_stride + i, k);
+        soa_reg c3 = soa_load(m + 6 * m_stride + i, k);
+        soa_reg c0 = soa_load(m + 7 * m_stride + i, k);
+
+        soa_reg r[9];
+        soa_reg s;
+        soa_rotation(b0, b1, b2, b3, r, s);
+
+        soa_reg t[3];
+        soa_translation(b0, b1, b2, b3, c0, c1, c2, c3, t);
+
+        soa_reg moved[3];
+        for (size_t j = 0; j != 3; ++j)
+        {
+            moved[j] = soa_mul(r[3 * j], c[0]);
+            moved[j] = soa_add(moved[j], soa_mul(r[3 * j + 1], c[1]));
+            moved[j] = soa_add(moved[j], soa_mul(r[3 * j + 2], c[2]));
+            moved[j] = soa_add(moved[j], t[j]);
+        }
+
+        if (Box)
+        {
+            soa_reg extents[3];
+            for (size_t j = 0; j != 3; ++j)
+            {
+                extents[j] = soa_mul(soa_abs(r[3 * j]), h[0]);
+                extents[j]
+                    = soa_add(extents[j], soa_mul(soa_abs(r[3 * j + 1]), h[1]));
+                extents[j]
+                    = soa_add(extents[j], soa_mul(soa_abs(r[3 * j + 2]), h[2]));
+            }
+            for (size_t j = 0; j != 3; ++j)
+            {
+                h[j] = extents[j];
+            }
+        }
+
+        for (size_t j = 0; j != 3; ++j)
+        {
+            c[j] = moved[j];
+        }
+    }
+
+    // Clears the bits past count in the final word of the mask
+    KLN_INLINE void KLN_VEC_CALL soa_clear_tail(uint32_t* mask,
+                                                size_t count) noexcept
+    {
+        if (count % 32 != 0)
+        {
+            mask[count / 32] &= (1u << (count % 32)) - 1;
+        }
+    }
+
+    // f: the six frustum planes (p0)
+    // m: SoA motors applied to the spheres if Transform is true
+    // in: SoA spheres with streams (x, y, z, r)
+    template <bool Transform>
+    KLN_INLINE void KLN_VEC_CALL cull_spheres_soa(__m128 const* f,
+                                                  float const* m,
+                                                  size_t m_stride,
+                                                  float const* in,
+                                                  size_t in_stride,
+                                                  uint32_t* out,
+                                                  size_t count) noexcept
+    {
+        soa_reg p[24];
+        soa_frustum(f, p, nullptr);
+        soa_reg zero = soa_set1(0.f);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg c[3];
+            c[0]      = soa_load(in + i, k);
+            c[1]      = soa_load(in + in_stride + i, k);
+            c[2]      = soa_load(in + 2 * in_stride + i, k);
+            soa_reg r = soa_load(in + 3 * in_stride + i, k);
+
+            if (Transform)
+            {
+                soa_move_bounds<false>(m, m_stride, i, k, c, nullptr);
+            }
+
+            soa_reg neg_r    = soa_sub(zero, r);
+            soa_pred visible = soa_eq(zero, zero);
+            for (size_t j = 0; j != 6; ++j)
+            {
+                soa_reg e = soa_mul(p[4 * j], c[0]);
+                e         = soa_add(e, soa_mul(p[4 * j + 1], c[1]));
+                e         = soa_add(e, soa_mul(p[4 * j + 2], c[2]));
+                e         = soa_add(e, p[4 * j + 3]);
+                visible   = soa_pred_and(visible, soa_le(neg_r, e));
+            }
+
+            soa_store_bits(visible, i, out);
+        }
+        soa_clear_tail(out, count);
+    }
+
+    // f: the six frustum planes (p0)
+    // m: SoA motors applied to the boxes if Transform is true
+    // in: SoA boxes with streams (x, y, z, w, hx, hy, hz, 0)
+    template <bool Transform>
+    KLN_INLINE void KLN_VEC_CALL cull_boxes_soa(__m128 const* f,
+                                                float const* m,
+                                                size_t m_stride,
+                                                float const* in,
+                                                size_t in_stride,
+                                                uint32_t* out,
+                                                size_t count) noexcept
+    {
+        soa_reg p[24];
+        soa_reg a[18];
+        soa_frustum(f, p, a);
+        soa_reg zero = soa_set1(0.f);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg c[3];
+            c[0] = soa_load(in + i, k);
+            c[1] = soa_load(in + in_stride + i, k);
+            c[2] = soa_load(in + 2 * in_stride + i, k);
+            soa_reg h[3];
+            h[0] = soa_load(in + 4 * in_stride + i, k);
+            h[1] = soa_load(in + 5 * in_stride + i, k);
+            h[2] = soa_load(in + 6 * in_stride + i, k);
+
+            if (Transform)
+            {
+                soa_move_bounds<true>(m, m_stride, i, k, c, h);
+            }
+
+            soa_pred visible = soa_eq(zero, zero);
+            for (size_t j = 0; j != 6; ++j)
+            {
+                soa_reg e = soa_mul(p[4 * j], c[0]);
+                e         = soa_add(e, soa_mul(p[4 * j + 1], c[1]));
+                e         = soa_add(e, soa_mul(p[4 * j + 2], c[2]));
+                e         = soa_add(e, p[4 * j + 3]);
+
+                soa_reg radius = soa_mul(a[3 * j], h[0]);
+                radius = soa_add(radius, soa_mul(a[3 * j + 1], h[1]));
+                radius = soa_add(radius, soa_mul(a[3 * j + 2], h[2]));
+
+                visible
+                    = soa_pred_and(visible, soa_le(zero, soa_add(e, radius)));
+            }
+
+            soa_store_bits(visible, i, out);
+        }
+        soa_clear_tail(out, count);
+    }
+} // namespace detail
+} // namespace kln
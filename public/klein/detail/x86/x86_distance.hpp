@@ -0,0 +1,246 @@
+// File: x86_distance.hpp
+// Purpose: Compute the distances from batches of points to planes and lines.
+// Points are read either tightly packed (AoS, one p3 partition per point) or
+// as SoA streams (x, y, z, w), and one distance is written per point.
+//
+// Notes:
+// 1. Points are normalized (w = 1). The signed distance from the point x to
+//    the plane (d, n) is (n.x + d) / |n|, which is the dot product of the
+//    point with the plane scaled by the inverse norm of the plane. When the
+//    plane is shared by all points, it is scaled once up front.
+// 2. The distance from x to the line with partitions m = (b1, b2, b3) and
+//    l = (c1, c2, c3) is |x x m - l| / |m|. The vector x x m - l is the
+//    moment of the line about x and vanishes if x lies on the line. This
+//    distance has no sign.
+// 3. SoA outputs are written a full register at a time (see x86_soa.hpp), so
+//    the output stream must be padded like the input streams.
+
+#pragma once
+
+#include "x86_soa_math.hpp"
+
+namespace kln
+{
+namespace detail
+{
+    // Partition memory layouts
+    //     LSB --> MSB
+    // p0: (e0, e1, e2, e3)
+    // p1: (1, e23, e31, e12)
+    // p2: (e0123, e01, e02, e03)
+    // p3: (e123, e032, e013, e021)
+
+    // The sums of the components of a, b, c, and d respectively
+    KLN_INLINE __m128 KLN_VEC_CALL hadd4(__m128 a,
+                                         __m128 b,
+                                         __m128 c,
+                                         __m128 d) noexcept
+    {
+        return _mm_hadd_ps(_mm_hadd_ps(a, b), _mm_hadd_ps(c, d));
+    }
+
+    // Signed distances from count points (p3) to a single plane b (p0)
+    KLN_INLINE void KLN_VEC_CALL dist30(__m128 const* in,
+                                        __m128 b,
+                                        float* out,
+                                        size_t count) noexcept
+    {
+        b = _mm_mul_ps(b, rsqrt_nr1(hi_dp_bc(b, b)));
+
+        // Four dot products are reduced at once, which avoids a shuffle
+        // sequence (or dpps) and a scalar store per point
+        size_t i    = 0;
+        size_t body = count & ~size_t{3};
+        for (; i != body; i += 4)
+        {
+            _mm_storeu_ps(out + i,
+                          hadd4(_mm_mul_ps(in[i], b),
+                                _mm_mul_ps(in[i + 1], b),
+                                _mm_mul_ps(in[i + 2], b),
+                                _mm_mul_ps(in[i + 3], b)));
+        }
+
+        for (; i < count; ++i)
+        {
+            _mm_store_ss(out + i, dp(in[i], b));
+        }
+    }
+
+    // Signed distance from point i (p3) to plane i (p0) for count pairs
+    KLN_INLINE void KLN_VEC_CALL dist30(__m128 const* in,
+                                        __m128 const* b,
+                                        float* out,
+                                        size_t count) noexcept
+    {
+        __m128 mask = _mm_castsi128_ps(_mm_set_epi32(-1, -1, -1, 0));
+
+        size_t i    = 0;
+        size_t body = count & ~size_t{3};
+        for (; i != body; i += 4)
+        {
+            __m128 n0 = _mm_and_ps(b[i], mask);
+            __m128 n1 = _mm_and_ps(b[i + 1], mask);
+            __m128 n2 = _mm_and_ps(b[i + 2], mask);
+            __m128 n3 = _mm_and_ps(b[i + 3], mask);
+            __m128 nn = hadd4(_mm_mul_ps(n0, n0),
+                              _mm_mul_ps(n1, n1),
+                              _mm_mul_ps(n2, n2),
+                              _mm_mul_ps(n3, n3));
+            __m128 d  = hadd4(_mm_mul_ps(in[i], b[i]),
+                              _mm_mul_ps(in[i + 1], b[i + 1]),
+                              _mm_mul_ps(in[i + 2], b[i + 2]),
+                              _mm_mul_ps(in[i + 3], b[i + 3]));
+            _mm_storeu_ps(out + i, _mm_mul_ps(d, rsqrt_nr1(nn)));
+        }
+
+        for (; i < count; ++i)
+        {
+            __m128 inv_norm = rsqrt_nr1(hi_dp(b[i], b[i]));
+            _mm_store_ss(out + i, _mm_mul_ss(dp(in[i], b[i]), inv_norm));
+        }
+    }
+
+    // x x m - l for the point a (p3) in the three high components, where
+    // b1 and b2 are the swizzled direction m and the low components of b1,
+    // b2, and c are zero
+    KLN_INLINE __m128 KLN_VEC_CALL moment312(__m128 a,
+                                             __m128 b1,
+                                             __m128 b2,
+                                             __m128 c) noexcept
+    {
+        __m128 v = _mm_mul_ps(KLN_SWIZZLE(a, 1, 3, 2, 0), b1);
+        v        = fnmadd(KLN_SWIZZLE(a, 2, 1, 3, 0), b2, v);
+        return _mm_sub_ps(v, c);
+    }
+
+    // Distances from count points (p3) to the line with partitions b (p1) and
+    // c (p2)
+    KLN_INLINE void KLN_VEC_CALL dist312(__m128 const* in,
+                                         __m128 b,
+                                         __m128 c,
+                                         float* out,
+                                         size_t count) noexcept
+    {
+        __m128 inv_norm = rsqrt_nr1(hi_dp_bc(b, b));
+
+        // Clearing the scalar and e0123 components leaves the low component
+        // of each moment at zero so whole registers can be reduced
+        __m128 mask = _mm_castsi128_ps(_mm_set_epi32(-1, -1, -1, 0));
+        b           = _mm_and_ps(b, mask);
+        c           = _mm_and_ps(c, mask);
+        __m128 b1   = KLN_SWIZZLE(b, 2, 1, 3, 0);
+        __m128 b2   = KLN_SWIZZLE(b, 1, 3, 2, 0);
+
+        size_t i    = 0;
+        size_t body = count & ~size_t{3};
+        for (; i != body; i += 4)
+        {
+            __m128 v0 = moment312(in[i], b1, b2, c);
+            __m128 v1 = moment312(in[i + 1], b1, b2, c);
+            __m128 v2 = moment312(in[i + 2], b1, b2, c);
+            __m128 v3 = moment312(in[i + 3], b1, b2, c);
+            __m128 vv = hadd4(_mm_mul_ps(v0, v0),
+                              _mm_mul_ps(v1, v1),
+                              _mm_mul_ps(v2, v2),
+                              _mm_mul_ps(v3, v3));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sqrt_ps(vv), inv_norm));
+        }
+
+        for (; i < count; ++i)
+        {
+            __m128 v = moment312(in[i], b1, b2, c);
+            _mm_store_ss(out + i,
+                         _mm_mul_ss(_mm_sqrt_ss(hi_dp(v, v)), inv_norm));
+        }
+    }
+
+    // Signed distances from count SoA points with streams (x, y, z, w) to a
+    // single plane a (p0) if PerPoint is false, or from point i to plane i of
+    // the SoA planes (streams x, y, z, d) otherwise.
+    template <bool PerPoint>
+    KLN_INLINE void KLN_VEC_CALL dist30_soa(float const* in,
+                                            size_t in_stride,
+                                            __m128 a,
+                                            float const* planes,
+                                            size_t plane_stride,
+                                            float* out,
+                                            size_t count) noexcept
+    {
+        float af[4];
+        _mm_storeu_ps(af, _mm_mul_ps(a, rsqrt_nr1(hi_dp_bc(a, a))));
+        soa_reg p[4] = {
+            soa_set1(af[1]), soa_set1(af[2]), soa_set1(af[3]), soa_set1(af[0])};
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg x  = soa_load(in + i, k);
+            soa_reg y  = soa_load(in + in_stride + i, k);
+            soa_reg z  = soa_load(in + 2 * in_stride + i, k);
+
+            if (PerPoint)
+            {
+                p[0] = soa_load(planes + i, k);
+                p[1] = soa_load(planes + plane_stride + i, k);
+                p[2] = soa_load(planes + 2 * plane_stride + i, k);
+                p[3] = soa_load(planes + 3 * plane_stride + i, k);
+            }
+
+            soa_reg d = soa_mul(p[0], x);
+            d         = soa_add(d, soa_mul(p[1], y));
+            d         = soa_add(d, soa_mul(p[2], z));
+            d         = soa_add(d, p[3]);
+
+            if (PerPoint)
+            {
+                soa_reg nn = soa_mul(p[0], p[0]);
+                nn         = soa_add(nn, soa_mul(p[1], p[1]));
+                nn         = soa_add(nn, soa_mul(p[2], p[2]));
+                d          = soa_div(d, soa_sqrt(nn));
+            }
+
+            soa_store(out + i, d, k);
+        }
+    }
+
+    // Distances from count SoA points with streams (x, y, z, w) to the line
+    // with partitions b (p1) and c (p2)
+    KLN_INLINE void KLN_VEC_CALL dist312_soa(float const* in,
+                                             size_t in_stride,
+                                             __m128 b,
+                                             __m128 c,
+                                             float* out,
+                                             size_t count) noexcept
+    {
+        float bf[4];
+        float cf[4];
+        float inv;
+        _mm_storeu_ps(bf, b);
+        _mm_storeu_ps(cf, c);
+        _mm_store_ss(&inv, rsqrt_nr1(hi_dp(b, b)));
+        soa_reg m[3]     = {soa_set1(bf[1]), soa_set1(bf[2]), soa_set1(bf[3])};
+        soa_reg l[3]     = {soa_set1(cf[1]), soa_set1(cf[2]), soa_set1(cf[3])};
+        soa_reg inv_norm = soa_set1(inv);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg x  = soa_load(in + i, k);
+            soa_reg y  = soa_load(in + in_stride + i, k);
+            soa_reg z  = soa_load(in + 2 * in_stride + i, k);
+
+            soa_reg vx = soa_sub(soa_mul(y, m[2]), soa_mul(z, m[1]));
+            soa_reg vy = soa_sub(soa_mul(z, m[0]), soa_mul(x, m[2]));
+            soa_reg vz = soa_sub(soa_mul(x, m[1]), soa_mul(y, m[0]));
+            vx         = soa_sub(vx, l[0]);
+            vy         = soa_sub(vy, l[1]);
+            vz         = soa_sub(vz, l[2]);
+
+            soa_reg vv = soa_mul(vx, vx);
+            vv         = soa_add(vv, soa_mul(vy, vy));
+            vv         = soa_add(vv, soa_mul(vz, vz));
+            soa_store(out + i, soa_mul(soa_sqrt(vv), inv_norm), k);
+        }
+    }
+} // namespace detail
+} // namespace kln
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "x86_soa_math.hpp"
 #include "x86_sse.hpp"
 #include <cmath>
 
@@ -213,5 +214,196 @@ namespace detail
         p2_out      = _mm_mul_ps(uvec, norm_ideal);
         p2_out      = _mm_sub_ps(p2_out, _mm_mul_ps(_mm_set1_ps(v), norm_real));
     }
+
+    // The batched kernels below evaluate exp and log lane by lane on
+    // soa_width motors (or lines) at once, mirroring the scalar routines
+    // above. The sine, cosine, and arctangent are computed with the
+    // polynomials in x86_soa_math.hpp, and the norms are computed with a full
+    // precision square root and division instead of the refined reciprocal
+    // estimates.
+
+    // a, b: the soa_width bivectors to exponentiate, one register per
+    // component of partitions 1 and 2 respectively
+    KLN_INLINE void KLN_VEC_CALL exp_soa(soa_reg const* KLN_RESTRICT a,
+                                         soa_reg const* KLN_RESTRICT b,
+                                         soa_reg* KLN_RESTRICT p1_out,
+                                         soa_reg* KLN_RESTRICT p2_out) noexcept
+    {
+        soa_reg zero   = soa_set1(0.f);
+        soa_pred ideal = soa_pred_and(
+            soa_pred_and(soa_eq(a[0], zero), soa_eq(a[1], zero)),
+            soa_pred_and(soa_eq(a[2], zero), soa_eq(a[3], zero)));
+
+        soa_reg a2 = soa_add(
+            soa_mul(a[1], a[1]),
+            soa_add(soa_mul(a[2], a[2]), soa_mul(a[3], a[3])));
+        soa_reg ab = soa_add(
+            soa_mul(a[1], b[1]),
+            soa_add(soa_mul(a[2], b[2]), soa_mul(a[3], b[3])));
+
+        // u + vI is the norm of the bivector (see exp above)
+        soa_reg u           = soa_sqrt(a2);
+        soa_reg a2_sqrt_rcp = soa_div(soa_set1(1.f), u);
+        soa_reg minus_v     = soa_mul(ab, a2_sqrt_rcp);
+        soa_reg ideal_scale = soa_div(minus_v, a2);
+
+        soa_reg sinu;
+        soa_reg cosu;
+        soa_sincos(u, sinu, cosu);
+        soa_reg minus_vcosu = soa_mul(minus_v, cosu);
+
+        for (size_t i = 0; i != 4; ++i)
+        {
+            soa_reg norm_real  = soa_mul(a[i], a2_sqrt_rcp);
+            soa_reg norm_ideal = soa_sub(soa_mul(b[i], a2_sqrt_rcp),
+                                         soa_mul(a[i], ideal_scale));
+            p1_out[i]          = soa_mul(sinu, norm_real);
+            p2_out[i]          = soa_mul(sinu, norm_ideal);
+            if (i == 0)
+            {
+                p1_out[0] = soa_add(p1_out[0], cosu);
+                p2_out[0] = soa_add(p2_out[0], soa_mul(minus_v, sinu));
+            }
+            else
+            {
+                p2_out[i] = soa_add(p2_out[i], soa_mul(minus_vcosu, norm_real));
+            }
+
+            // Ideal lines exponentiate to 1 + b
+            soa_reg ideal_p1 = i == 0 ? soa_set1(1.f) : zero;
+            p1_out[i]        = soa_select(ideal, ideal_p1, p1_out[i]);
+            p2_out[i]        = soa_select(ideal, b[i], p2_out[i]);
+        }
+    }
+
+    // p1, p2: the soa_width motors to take the logarithm of, one register
+    // per component of partitions 1 and 2 respectively
+    KLN_INLINE void KLN_VEC_CALL log_soa(soa_reg const* KLN_RESTRICT p1,
+                                         soa_reg const* KLN_RESTRICT p2,
+                                         soa_reg* KLN_RESTRICT p1_out,
+                                         soa_reg* KLN_RESTRICT p2_out) noexcept
+    {
+        soa_reg zero         = soa_set1(0.f);
+        soa_pred no_rotation = soa_pred_and(
+            soa_eq(p1[1], zero),
+            soa_pred_and(soa_eq(p1[2], zero), soa_eq(p1[3], zero)));
+
+        soa_reg a2 = soa_add(
+            soa_mul(p1[1], p1[1]),
+            soa_add(soa_mul(p1[2], p1[2]), soa_mul(p1[3], p1[3])));
+        soa_reg ab = soa_add(
+            soa_mul(p1[1], p2[1]),
+            soa_add(soa_mul(p1[2], p2[2]), soa_mul(p1[3], p2[3])));
+
+        // s + t e0123 is the norm of the bivector (see log above)
+        soa_reg s           = soa_sqrt(a2);
+        soa_reg a2_sqrt_rcp = soa_div(soa_set1(1.f), s);
+        soa_reg minus_t     = soa_mul(ab, a2_sqrt_rcp);
+        soa_reg t           = soa_sub(zero, minus_t);
+        soa_reg ideal_scale = soa_div(minus_t, a2);
+
+        // p = cosu, q = -v sinu, s = sinu, t = v cosu
+        soa_reg p       = p1[0];
+        soa_reg q       = p2[0];
+        soa_reg minus_q = soa_sub(zero, q);
+        soa_reg abs_p   = soa_xor(p, soa_and(p, soa_set1(-0.f)));
+        soa_pred p_zero = soa_lt(abs_p, soa_set1(1e-6f));
+
+        soa_reg u = soa_atan2(
+            soa_select(p_zero, minus_q, s), soa_select(p_zero, t, p));
+        soa_reg v = soa_select(
+            p_zero, soa_mul(minus_q, a2_sqrt_rcp), soa_div(t, p));
+
+        p1_out[0] = zero;
+        p2_out[0] = soa_select(no_rotation, q, zero);
+        for (size_t i = 1; i != 4; ++i)
+        {
+            soa_reg norm_real  = soa_mul(p1[i], a2_sqrt_rcp);
+            soa_reg norm_ideal = soa_sub(soa_mul(p2[i], a2_sqrt_rcp),
+                                         soa_mul(p1[i], ideal_scale));
+            p1_out[i]
+                = soa_select(no_rotation, zero, soa_mul(u, norm_real));
+            p2_out[i] = soa_select(
+                no_rotation,
+                p2[i],
+                soa_sub(soa_mul(u, norm_ideal), soa_mul(v, norm_real)));
+        }
+    }
+
+    // Applies log_soa (Log = true) or exp_soa to count (p1, p2) pairs stored
+    // contiguously. The input and output may alias.
+    template <bool Log>
+    KLN_INLINE void KLN_VEC_CALL exp_log_pairs(__m128 const* in,
+                                               __m128* out,
+                                               size_t count) noexcept
+    {
+        soa_reg a[4];
+        soa_reg b[4];
+        soa_reg p1[4];
+        soa_reg p2[4];
+
+        size_t i = 0;
+        for (; i + soa_width <= count; i += soa_width)
+        {
+            soa_gather4(in + 2 * i, 2, a);
+            soa_gather4(in + 2 * i + 1, 2, b);
+            if (Log)
+            {
+                log_soa(a, b, p1, p2);
+            }
+            else
+            {
+                exp_soa(a, b, p1, p2);
+            }
+            soa_scatter4(p1, out + 2 * i, 2);
+            soa_scatter4(p2, out + 2 * i + 1, 2);
+        }
+
+        if (i != count)
+        {
+            // Zero padding exponentiates to the identity and vice versa, so
+            // the unused lanes take the early out paths above
+            __m128 tmp[2 * soa_width];
+            size_t tail = count - i;
+            for (size_t j = 0; j != 2 * soa_width; ++j)
+            {
+                tmp[j] = j < 2 * tail ? in[2 * i + j] : _mm_setzero_ps();
+            }
+            soa_gather4(tmp, 2, a);
+            soa_gather4(tmp + 1, 2, b);
+            if (Log)
+            {
+                log_soa(a, b, p1, p2);
+            }
+            else
+            {
+                exp_soa(a, b, p1, p2);
+            }
+            soa_scatter4(p1, tmp, 2);
+            soa_scatter4(p2, tmp + 1, 2);
+            for (size_t j = 0; j != 2 * tail; ++j)
+            {
+                out[2 * i + j] = tmp[j];
+            }
+        }
+    }
+
+    // in: count lines as (p1, p2) pairs
+    // out: count motors as (p1, p2) pairs
+    KLN_INLINE void KLN_VEC_CALL exp_batch(__m128 const* in,
+                                           __m128* out,
+                                           size_t count) noexcept
+    {
+        exp_log_pairs<false>(in, out, count);
+    }
+
+    // in: count motors as (p1, p2) pairs
+    // out: count lines as (p1, p2) pairs
+    KLN_INLINE void KLN_VEC_CALL log_batch(__m128 const* in,
+                                           __m128* out,
+                                           size_t count) noexcept
+    {
+        exp_log_pairs<true>(in, out, count);
+    }
 } // namespace detail
 } // namespace kln
@@ -2,6 +2,9 @@
 
 #include "x86_sse.hpp"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace kln
 {
 namespace detail
@@ -85,5 +88,91 @@ namespace detail
         p2 = _mm_xor_ps(p2, _mm_set_ss(-0.f));
     }
     // The exterior products p2 ^ p2, p2 ^ p3, p3 ^ p2, and p3 ^ p3 all vanish
+
+    // Batched exterior products with operands gathered by index. Since the
+    // join is the exterior product of the duals, the same kernels evaluate
+    // joins of points (whose p3 partition is the p0 partition of the dual
+    // plane) with the output partitions swapped where necessary.
+
+    // out[i] = in[pairs[2i]] ^ in[pairs[2i + 1]] for p0 inputs, where each
+    // output line occupies two registers (p1, p2). If Dual is true, the
+    // partitions are stored as (p2, p1), which is the join of p3 inputs.
+    template <bool Dual>
+    KLN_INLINE void KLN_VEC_CALL ext00(__m128 const* in,
+                                       uint32_t const* pairs,
+                                       __m128* out,
+                                       size_t count) noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 p1;
+            __m128 p2;
+            ext00(in[pairs[2 * i]], in[pairs[2 * i + 1]], p1, p2);
+            out[2 * i + (Dual ? 1 : 0)] = p1;
+            out[2 * i + (Dual ? 0 : 1)] = p2;
+        }
+    }
+
+    // The plane a (p0) met with the line (b1, b2), where b1 is the p1
+    // partition and b2 is the p2 partition
+    KLN_INLINE __m128 KLN_VEC_CALL ext012(__m128 a, __m128 b1, __m128 b2) noexcept
+    {
+        __m128 p3;
+        __m128 tmp;
+        extPB(a, b1, p3);
+        ext02(a, b2, tmp);
+        return _mm_add_ps(p3, tmp);
+    }
+
+    // out[i] = a[pairs[2i]] ^ b[pairs[2i + 1]] for planes a (p0) and lines b
+    // (p1, p2). If Dual is true, a holds points (p3) and b holds lines, and
+    // out[i] is the plane a[pairs[2i]] & b[pairs[2i + 1]].
+    template <bool Dual>
+    KLN_INLINE void KLN_VEC_CALL ext012(__m128 const* a,
+                                        __m128 const* b,
+                                        uint32_t const* pairs,
+                                        __m128* out,
+                                        size_t count) noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 const* l = b + 2 * pairs[2 * i + 1];
+            out[i]          = Dual ? ext012(a[pairs[2 * i]], l[1], l[0])
+                                   : ext012(a[pairs[2 * i]], l[0], l[1]);
+        }
+    }
+
+    // out[i] = in[t0] ^ in[t1] ^ in[t2] for p0 inputs and the index triple
+    // (t0, t1, t2) = (triples[3i], triples[3i + 1], triples[3i + 2]). The
+    // same kernel evaluates the join of three points (p3 inputs).
+    KLN_INLINE void KLN_VEC_CALL ext000(__m128 const* in,
+                                        uint32_t const* triples,
+                                        __m128* out,
+                                        size_t count) noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 p1;
+            __m128 p2;
+            ext00(in[triples[3 * i]], in[triples[3 * i + 1]], p1, p2);
+            out[i] = ext012(in[triples[3 * i + 2]], p1, p2);
+        }
+    }
+
+    // out[i] is the e0123 coefficient of a[pairs[2i]] ^ b[pairs[2i + 1]] for
+    // planes a (p0) and points b (p3)
+    KLN_INLINE void KLN_VEC_CALL ext03(__m128 const* a,
+                                       __m128 const* b,
+                                       uint32_t const* pairs,
+                                       float* out,
+                                       size_t count) noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 p2;
+            ext03<false>(a[pairs[2 * i]], b[pairs[2 * i + 1]], p2);
+            _mm_store_ss(out + i, p2);
+        }
+    }
 } // namespace detail
 } // namespace kln
\ No newline at end of file
@@ -0,0 +1,224 @@
+// File: x86_f64.hpp
+// Purpose: Provide a 4-wide double precision register, f64x4, along with the
+// handful of operations needed to port the single precision kernels to double
+// precision. With AVX2, an f64x4 is a single __m256d. Otherwise, it is a pair
+// of SSE2 __m128d registers holding lanes (0, 1) and (2, 3) respectively.
+//
+// Notes:
+// 1. Lane i of an f64x4 holds the same basis element as lane i of the
+//    corresponding __m128 partition (see x86_sandwich.hpp for the layouts).
+// 2. f64_swizzle<x, y, z, w> takes its arguments in the same order as
+//    KLN_SWIZZLE so that kernels can be ported verbatim.
+
+#pragma once
+
+#include "x86_sse.hpp"
+
+#ifndef KLEIN_AVX2
+#    ifdef KLEIN_USE_SIMDE
+#        include <x86/sse2.h>
+#    else
+#        include <emmintrin.h>
+#    endif
+#endif
+
+namespace kln
+{
+namespace detail
+{
+#ifdef KLEIN_AVX2
+    using f64x4 = __m256d;
+
+    // Equivalent to _mm_set_ps(e3, e2, e1, e0)
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_set(double e3,
+                                          double e2,
+                                          double e1,
+                                          double e0) noexcept
+    {
+        return _mm256_set_pd(e3, e2, e1, e0);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_set1(double s) noexcept
+    {
+        return _mm256_set1_pd(s);
+    }
+
+    // Equivalent to _mm_set_ss(s)
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_set_ss(double s) noexcept
+    {
+        return _mm256_set_pd(0.0, 0.0, 0.0, s);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_setzero() noexcept
+    {
+        return _mm256_setzero_pd();
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_loadu(double const* in) noexcept
+    {
+        return _mm256_loadu_pd(in);
+    }
+
+    KLN_INLINE void KLN_VEC_CALL f64_storeu(double* out, f64x4 a) noexcept
+    {
+        _mm256_storeu_pd(out, a);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_add(f64x4 a, f64x4 b) noexcept
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_sub(f64x4 a, f64x4 b) noexcept
+    {
+        return _mm256_sub_pd(a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_mul(f64x4 a, f64x4 b) noexcept
+    {
+        return _mm256_mul_pd(a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_xor(f64x4 a, f64x4 b) noexcept
+    {
+        return _mm256_xor_pd(a, b);
+    }
+
+    template <int X, int Y, int Z, int W>
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_swizzle(f64x4 a) noexcept
+    {
+        return _mm256_permute4x64_pd(a, _MM_SHUFFLE(X, Y, Z, W));
+    }
+
+    // Equivalent to hi_dp: (a1 b1 + a2 b2 + a3 b3, 0, 0, 0)
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_hi_dp(f64x4 a, f64x4 b) noexcept
+    {
+        __m256d p  = _mm256_mul_pd(a, b);
+        __m128d lo = _mm256_castpd256_pd128(p);
+        __m128d hi = _mm256_extractf128_pd(p, 1);
+        hi         = _mm_add_sd(hi, _mm_unpackhi_pd(hi, hi));
+        hi         = _mm_add_sd(hi, _mm_unpackhi_pd(lo, lo));
+        return _mm256_set_m128d(_mm_setzero_pd(),
+                                _mm_move_sd(_mm_setzero_pd(), hi));
+    }
+
+    // Equivalent to dp_bc: the full dot product broadcast to all lanes
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_dp_bc(f64x4 a, f64x4 b) noexcept
+    {
+        __m256d p = _mm256_mul_pd(a, b);
+        p         = _mm256_add_pd(p, _mm256_permute2f128_pd(p, p, 1));
+        return _mm256_add_pd(p, _mm256_permute_pd(p, 0b0101));
+    }
+
+    KLN_INLINE double KLN_VEC_CALL f64_lane0(f64x4 a) noexcept
+    {
+        return _mm256_cvtsd_f64(a);
+    }
+#else
+    struct f64x4
+    {
+        // Lanes 0 and 1
+        __m128d lo;
+        // Lanes 2 and 3
+        __m128d hi;
+    };
+
+    // Equivalent to _mm_set_ps(e3, e2, e1, e0)
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_set(double e3,
+                                          double e2,
+                                          double e1,
+                                          double e0) noexcept
+    {
+        return {_mm_set_pd(e1, e0), _mm_set_pd(e3, e2)};
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_set1(double s) noexcept
+    {
+        return {_mm_set1_pd(s), _mm_set1_pd(s)};
+    }
+
+    // Equivalent to _mm_set_ss(s)
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_set_ss(double s) noexcept
+    {
+        return {_mm_set_sd(s), _mm_setzero_pd()};
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_setzero() noexcept
+    {
+        return {_mm_setzero_pd(), _mm_setzero_pd()};
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_loadu(double const* in) noexcept
+    {
+        return {_mm_loadu_pd(in), _mm_loadu_pd(in + 2)};
+    }
+
+    KLN_INLINE void KLN_VEC_CALL f64_storeu(double* out, f64x4 a) noexcept
+    {
+        _mm_storeu_pd(out, a.lo);
+        _mm_storeu_pd(out + 2, a.hi);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_add(f64x4 a, f64x4 b) noexcept
+    {
+        return {_mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi)};
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_sub(f64x4 a, f64x4 b) noexcept
+    {
+        return {_mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi)};
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_mul(f64x4 a, f64x4 b) noexcept
+    {
+        return {_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi)};
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_xor(f64x4 a, f64x4 b) noexcept
+    {
+        return {_mm_xor_pd(a.lo, b.lo), _mm_xor_pd(a.hi, b.hi)};
+    }
+
+    // The register holding lane I (the branch folds away after inlining)
+    template <int I>
+    KLN_INLINE __m128d KLN_VEC_CALL f64_half(f64x4 const& a) noexcept
+    {
+        return I < 2 ? a.lo : a.hi;
+    }
+
+    template <int X, int Y, int Z, int W>
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_swizzle(f64x4 a) noexcept
+    {
+        // Output lane 0 takes input lane W, lane 1 takes Z, lane 2 takes Y,
+        // and lane 3 takes X, mirroring _MM_SHUFFLE
+        return {_mm_shuffle_pd(
+                    f64_half<W>(a), f64_half<Z>(a), (W & 1) | ((Z & 1) << 1)),
+                _mm_shuffle_pd(
+                    f64_half<Y>(a), f64_half<X>(a), (Y & 1) | ((X & 1) << 1))};
+    }
+
+    // Equivalent to hi_dp: (a1 b1 + a2 b2 + a3 b3, 0, 0, 0)
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_hi_dp(f64x4 a, f64x4 b) noexcept
+    {
+        __m128d lo = _mm_mul_pd(a.lo, b.lo);
+        __m128d hi = _mm_mul_pd(a.hi, b.hi);
+        hi         = _mm_add_sd(hi, _mm_unpackhi_pd(hi, hi));
+        hi         = _mm_add_sd(hi, _mm_unpackhi_pd(lo, lo));
+        return {_mm_move_sd(_mm_setzero_pd(), hi), _mm_setzero_pd()};
+    }
+
+    // Equivalent to dp_bc: the full dot product broadcast to all lanes
+    KLN_INLINE f64x4 KLN_VEC_CALL f64_dp_bc(f64x4 a, f64x4 b) noexcept
+    {
+        __m128d p = _mm_add_pd(_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi));
+        p         = _mm_add_pd(p, _mm_shuffle_pd(p, p, 1));
+        return {p, p};
+    }
+
+    KLN_INLINE double KLN_VEC_CALL f64_lane0(f64x4 a) noexcept
+    {
+        return _mm_cvtsd_f64(a.lo);
+    }
+#endif
+} // namespace detail
+} // namespace kln
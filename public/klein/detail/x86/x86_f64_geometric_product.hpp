@@ -0,0 +1,146 @@
+// File: x86_f64_geometric_product.hpp
+// Purpose: Double precision ports of the geometric product kernels in
+// x86_geometric_product.hpp needed by the kln::d entities. Each kernel keeps
+// the name, partition layout, and operation order of its single precision
+// counterpart. Refer to x86_geometric_product.hpp for the derivations.
+
+#pragma once
+
+#include "x86_f64.hpp"
+
+namespace kln
+{
+namespace detail
+{
+namespace d
+{
+    // p1: (1, e23, e31, e12)
+    KLN_INLINE void KLN_VEC_CALL gp11(f64x4 a, f64x4 b, f64x4& p1_out) noexcept
+    {
+        // (a0 b0 - a1 b1 - a2 b2 - a3 b3) +
+        // (a0 b1 - a2 b3 + a1 b0 + a3 b2)*e23
+        // (a0 b2 - a3 b1 + a2 b0 + a1 b3)*e31
+        // (a0 b3 - a1 b2 + a3 b0 + a2 b1)*e12
+
+        p1_out = f64_mul(f64_swizzle<0, 0, 0, 0>(a), b);
+
+        p1_out = f64_sub(p1_out,
+                         f64_mul(f64_swizzle<1, 3, 2, 1>(a),
+                                 f64_swizzle<2, 1, 3, 1>(b)));
+
+        f64x4 tmp1
+            = f64_mul(f64_swizzle<3, 2, 1, 2>(a), f64_swizzle<0, 0, 0, 2>(b));
+
+        f64x4 tmp2
+            = f64_mul(f64_swizzle<2, 1, 3, 3>(a), f64_swizzle<1, 3, 2, 3>(b));
+
+        f64x4 tmp = f64_xor(f64_add(tmp1, tmp2), f64_set_ss(-0.0));
+
+        p1_out = f64_add(p1_out, tmp);
+    }
+
+    // a := p1 (rotor), b := p2 (translator) for Flip = false and the reverse
+    // product for Flip = true
+    template <bool Flip>
+    KLN_INLINE void KLN_VEC_CALL gpRT(f64x4 a, f64x4 b, f64x4& p2) noexcept
+    {
+        // Flip:
+        // (a1 b1 + a2 b2 + a3 b3) e0123 +
+        // (a0 b1 + a2 b3 - a3 b2) e01 +
+        // (a0 b2 + a3 b1 - a1 b3) e02 +
+        // (a0 b3 + a1 b2 - a2 b1) e03
+        //
+        // No flip:
+        // (a1 b1 + a2 b2 + a3 b3) e0123 +
+        // (a0 b1 + a3 b2 - a2 b3) e01 +
+        // (a0 b2 + a1 b3 - a3 b1) e02 +
+        // (a0 b3 + a2 b1 - a1 b2) e03
+
+        p2 = f64_mul(f64_swizzle<0, 0, 0, 1>(a), f64_swizzle<3, 2, 1, 1>(b));
+        if (Flip)
+        {
+            p2 = f64_add(p2,
+                         f64_mul(f64_swizzle<1, 3, 2, 2>(a),
+                                 f64_swizzle<2, 1, 3, 2>(b)));
+            p2 = f64_sub(p2,
+                         f64_xor(f64_set_ss(-0.0),
+                                 f64_mul(f64_swizzle<2, 1, 3, 3>(a),
+                                         f64_swizzle<1, 3, 2, 3>(b))));
+        }
+        else
+        {
+            p2 = f64_add(p2,
+                         f64_mul(f64_swizzle<2, 1, 3, 2>(a),
+                                 f64_swizzle<1, 3, 2, 2>(b)));
+            p2 = f64_sub(p2,
+                         f64_xor(f64_set_ss(-0.0),
+                                 f64_mul(f64_swizzle<1, 3, 2, 3>(a),
+                                         f64_swizzle<2, 1, 3, 3>(b))));
+        }
+    }
+
+    template <bool Flip>
+    KLN_INLINE void KLN_VEC_CALL gp12(f64x4 a, f64x4 b, f64x4& p2) noexcept
+    {
+        gpRT<Flip>(a, b, p2);
+        p2 = f64_sub(
+            p2,
+            f64_xor(f64_set_ss(-0.0), f64_mul(a, f64_swizzle<0, 0, 0, 0>(b))));
+    }
+
+    // Optimized motor * motor operation
+    KLN_INLINE void KLN_VEC_CALL gpMM(f64x4 const& KLN_RESTRICT m1,
+                                      f64x4 const& KLN_RESTRICT m2,
+                                      f64x4* KLN_RESTRICT out) noexcept
+    {
+        // (a0 c0 - a1 c1 - a2 c2 - a3 c3) +
+        // (a0 c1 + a3 c2 + a1 c0 - a2 c3) e23 +
+        // (a0 c2 + a1 c3 + a2 c0 - a3 c1) e31 +
+        // (a0 c3 + a2 c1 + a3 c0 - a1 c2) e12 +
+        //
+        // (a0 d0 + b0 c0 + a1 d1 + b1 c1 + a2 d2 + a3 d3 + b2 c2 + b3 c3)
+        //  e0123 +
+        // (a0 d1 + b1 c0 + a3 d2 + b3 c2 - a1 d0 - a2 d3 - b0 c1 - b2 c3)
+        //  e01 +
+        // (a0 d2 + b2 c0 + a1 d3 + b1 c3 - a2 d0 - a3 d1 - b0 c2 - b3 c1)
+        //  e02 +
+        // (a0 d3 + b3 c0 + a2 d1 + b2 c1 - a3 d0 - a1 d2 - b0 c3 - b1 c2)
+        //  e03
+        f64x4 const& a = m1;
+        f64x4 const& b = *(&m1 + 1);
+        f64x4 const& c = m2;
+        f64x4 const& d = *(&m2 + 1);
+
+        f64x4& e = *out;
+        f64x4& f = *(out + 1);
+
+        f64x4 a_xxxx = f64_swizzle<0, 0, 0, 0>(a);
+        f64x4 a_zyzw = f64_swizzle<3, 2, 1, 2>(a);
+        f64x4 a_ywyz = f64_swizzle<2, 1, 3, 1>(a);
+        f64x4 a_wzwy = f64_swizzle<1, 3, 2, 3>(a);
+        f64x4 c_wwyz = f64_swizzle<2, 1, 3, 3>(c);
+        f64x4 c_yzwy = f64_swizzle<1, 3, 2, 1>(c);
+        f64x4 s_flip = f64_set_ss(-0.0);
+
+        e       = f64_mul(a_xxxx, c);
+        f64x4 t = f64_mul(a_ywyz, c_yzwy);
+        t = f64_add(t, f64_mul(a_zyzw, f64_swizzle<0, 0, 0, 2>(c)));
+        t = f64_xor(t, s_flip);
+        e = f64_add(e, t);
+        e = f64_sub(e, f64_mul(a_wzwy, c_wwyz));
+
+        f = f64_mul(a_xxxx, d);
+        f = f64_add(f, f64_mul(b, f64_swizzle<0, 0, 0, 0>(c)));
+        f = f64_add(f, f64_mul(a_ywyz, f64_swizzle<1, 3, 2, 1>(d)));
+        f = f64_add(f, f64_mul(f64_swizzle<2, 1, 3, 1>(b), c_yzwy));
+        t = f64_mul(a_zyzw, f64_swizzle<0, 0, 0, 2>(d));
+        t = f64_add(t, f64_mul(a_wzwy, f64_swizzle<2, 1, 3, 3>(d)));
+        t = f64_add(
+            t, f64_mul(f64_swizzle<0, 0, 0, 2>(b), f64_swizzle<3, 2, 1, 2>(c)));
+        t = f64_add(t, f64_mul(f64_swizzle<1, 3, 2, 3>(b), c_wwyz));
+        t = f64_xor(t, s_flip);
+        f = f64_sub(f, t);
+    }
+} // namespace d
+} // namespace detail
+} // namespace kln
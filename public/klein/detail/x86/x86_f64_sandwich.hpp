@@ -0,0 +1,328 @@
+// File: x86_f64_sandwich.hpp
+// Purpose: Double precision ports of the sandwich kernels in x86_sandwich.hpp
+// needed by the kln::d entities. Each kernel keeps the name, partition layout,
+// and argument conventions of its single precision counterpart. Refer to
+// x86_sandwich.hpp for the derivations.
+
+#pragma once
+
+#include "x86_f64.hpp"
+
+#include <cstddef>
+
+namespace kln
+{
+namespace detail
+{
+namespace d
+{
+    // Apply a translator to a plane.
+    // The low component of b is expected to be the scalar component (unity
+    // for a translator) instead of e0123.
+    KLN_INLINE f64x4 KLN_VEC_CALL sw02(f64x4 a, f64x4 b) noexcept
+    {
+        // (a0 + 2a1 b1 / b0 + 2a2 b2 / b0 + 2a3 b3 / b0) e0 +
+        // a1 e1 +
+        // a2 e2 +
+        // a3 e3
+
+        f64x4 tmp = f64_hi_dp(a, b);
+        // Unlike the single precision kernel, divide exactly
+        tmp = f64_mul(tmp, f64_set_ss(2.0 / f64_lane0(b)));
+        return f64_add(a, tmp);
+    }
+
+    // Apply a translator to a line
+    // a := p1 input
+    // d := p2 input
+    // c := p2 translator
+    // out points to the start address of a line (p1, p2)
+    KLN_INLINE void KLN_VEC_CALL swL2(f64x4 a, f64x4 d, f64x4 c, f64x4* out)
+    {
+        // a0 +
+        // a1 e23 +
+        // a2 e31 +
+        // a3 e12 +
+        //
+        // (2a0 c0 + d0) e0123 +
+        // (2(a2 c3 - a3 c2 - a1 c0) + d1) e01 +
+        // (2(a3 c1 - a1 c3 - a2 c0) + d2) e02 +
+        // (2(a1 c2 - a2 c1 - a3 c0) + d3) e03
+
+        f64x4& p1_out = *out;
+        f64x4& p2_out = *(out + 1);
+
+        p1_out = a;
+
+        p2_out
+            = f64_mul(f64_swizzle<1, 3, 2, 0>(a), f64_swizzle<2, 1, 3, 0>(c));
+        p2_out = f64_sub(
+            p2_out,
+            f64_mul(f64_swizzle<2, 1, 3, 0>(a), f64_swizzle<1, 3, 2, 0>(c)));
+        p2_out = f64_sub(p2_out,
+                         f64_xor(f64_mul(a, f64_swizzle<0, 0, 0, 0>(c)),
+                                 f64_set_ss(-0.0)));
+        p2_out = f64_add(p2_out, p2_out);
+        p2_out = f64_add(p2_out, d);
+    }
+
+    // Apply a translator to a point.
+    // Assumes e0123 component of p2 is exactly 0
+    KLN_INLINE f64x4 KLN_VEC_CALL sw32(f64x4 a, f64x4 b) noexcept
+    {
+        // a0 e123 +
+        // (a1 - 2 a0 b1) e032 +
+        // (a2 - 2 a0 b2) e013 +
+        // (a3 - 2 a0 b3) e021
+
+        f64x4 tmp = f64_mul(f64_swizzle<0, 0, 0, 0>(a), b);
+        tmp       = f64_mul(f64_set(-2.0, -2.0, -2.0, 0.0), tmp);
+        return f64_add(a, tmp);
+    }
+
+    // Apply a motor to a motor (works on lines as well)
+    // in points to the start of an array of motor inputs (alternating p1 and
+    // p2) out points to the start of an array of motor outputs (alternating p1
+    // and p2)
+    //
+    // Note: in and out are permitted to alias iff in == out.
+    template <bool Variadic, bool Translate, bool InputP2>
+    KLN_INLINE void KLN_VEC_CALL swMM(f64x4 const* in,
+                                      f64x4 const& KLN_RESTRICT b,
+                                      f64x4 const* KLN_RESTRICT c,
+                                      f64x4* out,
+                                      size_t count = 0) noexcept
+    {
+        f64x4 b_xwyz   = f64_swizzle<2, 1, 3, 0>(b);
+        f64x4 b_xzwy   = f64_swizzle<1, 3, 2, 0>(b);
+        f64x4 b_yxxx   = f64_swizzle<0, 0, 0, 1>(b);
+        f64x4 b_yxxx_2 = f64_mul(b_yxxx, b_yxxx);
+
+        f64x4 tmp   = f64_mul(b, b);
+        tmp         = f64_add(tmp, b_yxxx_2);
+        f64x4 b_tmp = f64_swizzle<2, 1, 3, 2>(b);
+        f64x4 tmp2  = f64_mul(b_tmp, b_tmp);
+        b_tmp       = f64_swizzle<1, 3, 2, 3>(b);
+        tmp2        = f64_add(tmp2, f64_mul(b_tmp, b_tmp));
+        tmp         = f64_sub(tmp, f64_xor(tmp2, f64_set_ss(-0.0)));
+        // tmp needs to be scaled by a and set to p1_out
+
+        f64x4 b_xxxx = f64_swizzle<0, 0, 0, 0>(b);
+        f64x4 scale  = f64_set(2.0, 2.0, 2.0, 0.0);
+        tmp2         = f64_mul(b_xxxx, b_xwyz);
+        tmp2         = f64_add(tmp2, f64_mul(b, b_xzwy));
+        tmp2         = f64_mul(tmp2, scale);
+        // tmp2 needs to be scaled by (a0, a2, a3, a1) and added to p1_out
+
+        f64x4 tmp3 = f64_mul(b, b_xwyz);
+        tmp3       = f64_sub(tmp3, f64_mul(b_xxxx, b_xzwy));
+        tmp3       = f64_mul(tmp3, scale);
+        // tmp3 needs to be scaled by (a0, a3, a1, a2) and added to p1_out
+
+        // Translation
+        f64x4 tmp4 = f64_setzero(); // scaled by a and added to p2
+        f64x4 tmp5 = f64_setzero(); // scaled by (a0, a3, a1, a2), added to p2
+        f64x4 tmp6 = f64_setzero(); // scaled by (a0, a2, a3, a1), added to p2
+
+        if (Translate)
+        {
+            f64x4 czero  = f64_swizzle<0, 0, 0, 0>(*c);
+            f64x4 c_xzwy = f64_swizzle<1, 3, 2, 0>(*c);
+            f64x4 c_xwyz = f64_swizzle<2, 1, 3, 0>(*c);
+
+            tmp4 = f64_mul(b, *c);
+            tmp4 = f64_sub(tmp4, f64_mul(b_yxxx, f64_swizzle<0, 0, 0, 1>(*c)));
+            tmp4 = f64_sub(tmp4,
+                           f64_mul(f64_swizzle<1, 3, 3, 2>(b),
+                                   f64_swizzle<1, 3, 3, 2>(*c)));
+            tmp4 = f64_sub(tmp4,
+                           f64_mul(f64_swizzle<2, 1, 2, 3>(b),
+                                   f64_swizzle<2, 1, 2, 3>(*c)));
+            tmp4 = f64_add(tmp4, tmp4);
+
+            tmp5 = f64_mul(b, c_xwyz);
+            tmp5 = f64_add(tmp5, f64_mul(b_xzwy, czero));
+            tmp5 = f64_add(tmp5, f64_mul(b_xwyz, *c));
+            tmp5 = f64_sub(tmp5, f64_mul(b_xxxx, c_xzwy));
+            tmp5 = f64_mul(tmp5, scale);
+
+            tmp6 = f64_mul(b, c_xzwy);
+            tmp6 = f64_add(tmp6, f64_mul(b_xxxx, c_xwyz));
+            tmp6 = f64_add(tmp6, f64_mul(b_xzwy, *c));
+            tmp6 = f64_sub(tmp6, f64_mul(b_xwyz, czero));
+            tmp6 = f64_mul(tmp6, scale);
+        }
+
+        size_t limit  = Variadic ? count : 1;
+        size_t stride = InputP2 ? 2 : 1;
+        for (size_t i = 0; i != limit; ++i)
+        {
+            f64x4 p1_in      = in[stride * i]; // a
+            f64x4 p1_in_xzwy = f64_swizzle<1, 3, 2, 0>(p1_in);
+            f64x4 p1_in_xwyz = f64_swizzle<2, 1, 3, 0>(p1_in);
+
+            f64x4& p1_out = out[stride * i];
+
+            p1_out = f64_mul(tmp, p1_in);
+            p1_out = f64_add(p1_out, f64_mul(tmp2, p1_in_xzwy));
+            p1_out = f64_add(p1_out, f64_mul(tmp3, p1_in_xwyz));
+
+            if (InputP2)
+            {
+                f64x4 p2_in   = in[2 * i + 1]; // d
+                f64x4& p2_out = out[2 * i + 1];
+                p2_out        = f64_mul(tmp, p2_in);
+                p2_out        = f64_add(
+                    p2_out, f64_mul(tmp2, f64_swizzle<1, 3, 2, 0>(p2_in)));
+                p2_out = f64_add(
+                    p2_out, f64_mul(tmp3, f64_swizzle<2, 1, 3, 0>(p2_in)));
+            }
+
+            // If what is being applied is a rotor, the non-directional
+            // components of the line are left untouched
+            if (Translate)
+            {
+                f64x4& p2_out = out[2 * i + 1];
+                p2_out        = f64_add(p2_out, f64_mul(tmp4, p1_in));
+                p2_out        = f64_add(p2_out, f64_mul(tmp5, p1_in_xwyz));
+                p2_out        = f64_add(p2_out, f64_mul(tmp6, p1_in_xzwy));
+            }
+        }
+    }
+
+    // Apply a motor to a plane
+    // a := p0
+    // b := p1
+    // c := p2
+    // If Translate is false, c is ignored (rotor application).
+    // If Variadic is true, a and out must point to a contiguous block of memory
+    // equivalent to f64x4[count]. Unlike the single precision kernel, a and out
+    // are permitted to alias iff a == out.
+    template <bool Variadic = false, bool Translate = true>
+    KLN_INLINE void KLN_VEC_CALL sw012(f64x4 const* a,
+                                       f64x4 b,
+                                       f64x4 const* KLN_RESTRICT c,
+                                       f64x4* out,
+                                       size_t count = 0) noexcept
+    {
+        // Double-cover scale
+        f64x4 dc_scale = f64_set(2.0, 2.0, 2.0, 1.0);
+        f64x4 b_xwyz   = f64_swizzle<2, 1, 3, 0>(b);
+        f64x4 b_xzwy   = f64_swizzle<1, 3, 2, 0>(b);
+        f64x4 b_xxxx   = f64_swizzle<0, 0, 0, 0>(b);
+
+        f64x4 tmp1
+            = f64_mul(f64_swizzle<0, 0, 0, 2>(b), f64_swizzle<2, 1, 3, 2>(b));
+        tmp1 = f64_add(
+            tmp1,
+            f64_mul(f64_swizzle<1, 3, 2, 1>(b), f64_swizzle<3, 2, 1, 1>(b)));
+        // Scale later with (a0, a2, a3, a1)
+        tmp1 = f64_mul(tmp1, dc_scale);
+
+        f64x4 tmp2 = f64_mul(b, b_xwyz);
+        tmp2       = f64_sub(tmp2,
+                       f64_xor(f64_set_ss(-0.0),
+                               f64_mul(f64_swizzle<0, 0, 0, 3>(b),
+                                       f64_swizzle<1, 3, 2, 3>(b))));
+        // Scale later with (a0, a3, a1, a2)
+        tmp2 = f64_mul(tmp2, dc_scale);
+
+        // Alternately add and subtract to improve low component stability
+        f64x4 tmp3 = f64_mul(b, b);
+        tmp3       = f64_sub(tmp3, f64_mul(b_xwyz, b_xwyz));
+        tmp3       = f64_add(tmp3, f64_mul(b_xxxx, b_xxxx));
+        tmp3       = f64_sub(tmp3, f64_mul(b_xzwy, b_xzwy));
+        // Scale later with a
+
+        f64x4 tmp4 = f64_setzero();
+        if (Translate)
+        {
+            tmp4 = f64_mul(b_xxxx, *c);
+            tmp4 = f64_add(tmp4, f64_mul(b_xzwy, f64_swizzle<2, 1, 3, 0>(*c)));
+            tmp4 = f64_add(tmp4, f64_mul(b, f64_swizzle<0, 0, 0, 0>(*c)));
+
+            // NOTE: The high component of tmp4 is meaningless here
+            tmp4 = f64_sub(tmp4, f64_mul(b_xwyz, f64_swizzle<1, 3, 2, 0>(*c)));
+            tmp4 = f64_mul(tmp4, dc_scale);
+        }
+
+        size_t limit = Variadic ? count : 1;
+        for (size_t i = 0; i != limit; ++i)
+        {
+            f64x4 a_i = a[i];
+            f64x4 p   = f64_mul(tmp1, f64_swizzle<1, 3, 2, 0>(a_i));
+            p = f64_add(p, f64_mul(tmp2, f64_swizzle<2, 1, 3, 0>(a_i)));
+            p = f64_add(p, f64_mul(tmp3, a_i));
+
+            if (Translate)
+            {
+                p = f64_add(p, f64_hi_dp(tmp4, a_i));
+            }
+            out[i] = p;
+        }
+    }
+
+    // Apply a motor to a point. a and out are permitted to alias iff a == out.
+    template <bool Variadic, bool Translate>
+    KLN_INLINE void KLN_VEC_CALL sw312(f64x4 const* a,
+                                       f64x4 b,
+                                       f64x4 const* KLN_RESTRICT c,
+                                       f64x4* out,
+                                       size_t count = 0) noexcept
+    {
+        f64x4 two    = f64_set(2.0, 2.0, 2.0, 0.0);
+        f64x4 b_xxxx = f64_swizzle<0, 0, 0, 0>(b);
+        f64x4 b_xwyz = f64_swizzle<2, 1, 3, 0>(b);
+        f64x4 b_xzwy = f64_swizzle<1, 3, 2, 0>(b);
+
+        f64x4 tmp1 = f64_mul(b, b_xwyz);
+        tmp1       = f64_sub(tmp1, f64_mul(b_xxxx, b_xzwy));
+        tmp1       = f64_mul(tmp1, two);
+        // tmp1 needs to be scaled by (_, a3, a1, a2)
+
+        f64x4 tmp2 = f64_mul(b_xxxx, b_xwyz);
+        tmp2       = f64_add(tmp2, f64_mul(b_xzwy, b));
+        tmp2       = f64_mul(tmp2, two);
+        // tmp2 needs to be scaled by (_, a2, a3, a1)
+
+        f64x4 tmp3  = f64_mul(b, b);
+        f64x4 b_tmp = f64_swizzle<0, 0, 0, 1>(b);
+        tmp3        = f64_add(tmp3, f64_mul(b_tmp, b_tmp));
+        b_tmp       = f64_swizzle<2, 1, 3, 2>(b);
+        f64x4 tmp4  = f64_mul(b_tmp, b_tmp);
+        b_tmp       = f64_swizzle<1, 3, 2, 3>(b);
+        tmp4        = f64_add(tmp4, f64_mul(b_tmp, b_tmp));
+        tmp3        = f64_sub(tmp3, f64_xor(tmp4, f64_set_ss(-0.0)));
+        // tmp3 needs to be scaled by (a0, a1, a2, a3)
+
+        if (Translate)
+        {
+            tmp4 = f64_mul(b_xzwy, f64_swizzle<2, 1, 3, 0>(*c));
+            tmp4 = f64_sub(tmp4, f64_mul(b_xxxx, *c));
+            tmp4 = f64_sub(tmp4, f64_mul(b_xwyz, f64_swizzle<1, 3, 2, 0>(*c)));
+            tmp4 = f64_sub(tmp4, f64_mul(b, f64_swizzle<0, 0, 0, 0>(*c)));
+
+            // Mask low component and scale other components by 2
+            tmp4 = f64_mul(tmp4, two);
+            // tmp4 needs to be scaled by (_, a0, a0, a0)
+        }
+
+        size_t limit = Variadic ? count : 1;
+        for (size_t i = 0; i != limit; ++i)
+        {
+            f64x4 a_i = a[i];
+            f64x4 p   = f64_mul(tmp1, f64_swizzle<2, 1, 3, 0>(a_i));
+            p = f64_add(p, f64_mul(tmp2, f64_swizzle<1, 3, 2, 0>(a_i)));
+            p = f64_add(p, f64_mul(tmp3, a_i));
+
+            if (Translate)
+            {
+                p = f64_add(
+                    p, f64_mul(tmp4, f64_swizzle<0, 0, 0, 0>(a_i)));
+            }
+            out[i] = p;
+        }
+    }
+} // namespace d
+} // namespace detail
+} // namespace kln
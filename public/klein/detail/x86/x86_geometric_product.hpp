@@ -148,19 +148,18 @@ namespace detail
         // In general, we can get rid of at most one swizzle
         p1_out = _mm_mul_ps(KLN_SWIZZLE(a, 0, 0, 0, 0), b);
 
-        p1_out = _mm_sub_ps(
-            p1_out,
-            _mm_mul_ps(KLN_SWIZZLE(a, 1, 3, 2, 1), KLN_SWIZZLE(b, 2, 1, 3, 1)));
+        p1_out = fnmadd(
+            KLN_SWIZZLE(a, 1, 3, 2, 1), KLN_SWIZZLE(b, 2, 1, 3, 1), p1_out);
 
         // In a separate register, accumulate the later components so we can
         // negate the lower single-precision element with a single instruction
-        __m128 tmp1
+        __m128 tmp
             = _mm_mul_ps(KLN_SWIZZLE(a, 3, 2, 1, 2), KLN_SWIZZLE(b, 0, 0, 0, 2));
 
-        __m128 tmp2
-            = _mm_mul_ps(KLN_SWIZZLE(a, 2, 1, 3, 3), KLN_SWIZZLE(b, 1, 3, 2, 3));
+        tmp = fmadd(
+            KLN_SWIZZLE(a, 2, 1, 3, 3), KLN_SWIZZLE(b, 1, 3, 2, 3), tmp);
 
-        __m128 tmp = _mm_xor_ps(_mm_add_ps(tmp1, tmp2), _mm_set_ss(-0.f));
+        tmp = _mm_xor_ps(tmp, _mm_set_ss(-0.f));
 
         p1_out = _mm_add_ps(p1_out, tmp);
     }
@@ -343,21 +342,19 @@ namespace detail
 
         e        = _mm_mul_ps(a_xxxx, c);
         __m128 t = _mm_mul_ps(a_ywyz, c_yzwy);
-        t = _mm_add_ps(t, _mm_mul_ps(a_zyzw, KLN_SWIZZLE(c, 0, 0, 0, 2)));
+        t = fmadd(a_zyzw, KLN_SWIZZLE(c, 0, 0, 0, 2), t);
         t = _mm_xor_ps(t, s_flip);
         e = _mm_add_ps(e, t);
-        e = _mm_sub_ps(e, _mm_mul_ps(a_wzwy, c_wwyz));
+        e = fnmadd(a_wzwy, c_wwyz, e);
 
         f = _mm_mul_ps(a_xxxx, d);
-        f = _mm_add_ps(f, _mm_mul_ps(b, KLN_SWIZZLE(c, 0, 0, 0, 0)));
-        f = _mm_add_ps(f, _mm_mul_ps(a_ywyz, KLN_SWIZZLE(d, 1, 3, 2, 1)));
-        f = _mm_add_ps(f, _mm_mul_ps(KLN_SWIZZLE(b, 2, 1, 3, 1), c_yzwy));
+        f = fmadd(b, KLN_SWIZZLE(c, 0, 0, 0, 0), f);
+        f = fmadd(a_ywyz, KLN_SWIZZLE(d, 1, 3, 2, 1), f);
+        f = fmadd(KLN_SWIZZLE(b, 2, 1, 3, 1), c_yzwy, f);
         t = _mm_mul_ps(a_zyzw, KLN_SWIZZLE(d, 0, 0, 0, 2));
-        t = _mm_add_ps(t, _mm_mul_ps(a_wzwy, KLN_SWIZZLE(d, 2, 1, 3, 3)));
-        t = _mm_add_ps(
-            t,
-            _mm_mul_ps(KLN_SWIZZLE(b, 0, 0, 0, 2), KLN_SWIZZLE(c, 3, 2, 1, 2)));
-        t = _mm_add_ps(t, _mm_mul_ps(KLN_SWIZZLE(b, 1, 3, 2, 3), c_wwyz));
+        t = fmadd(a_wzwy, KLN_SWIZZLE(d, 2, 1, 3, 3), t);
+        t = fmadd(KLN_SWIZZLE(b, 0, 0, 0, 2), KLN_SWIZZLE(c, 3, 2, 1, 2), t);
+        t = fmadd(KLN_SWIZZLE(b, 1, 3, 2, 3), c_wwyz, t);
         t = _mm_xor_ps(t, s_flip);
         f = _mm_sub_ps(f, t);
     }
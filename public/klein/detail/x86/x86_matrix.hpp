@@ -10,6 +10,9 @@
 
 #include "x86_sse.hpp"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace kln
 {
 // Partition memory layouts
@@ -139,4 +142,48 @@ KLN_INLINE void KLN_VEC_CALL mat4x4_12(__m128 b,
 #else
 #    include "x86_matrix_cxx11.inl"
 #endif
+
+// Convert count normalized motors, stored as consecutive (p1, p2) pairs, to
+// tightly packed row-major 3x4 matrices (12 floats each). When out is 16-byte
+// aligned, the rows are written with non-temporal stores which bypass the
+// cache. This is preferable when the destination will not be read again by
+// the CPU (e.g. a mapped GPU upload buffer).
+KLN_INLINE void KLN_VEC_CALL mat3x4_12_rows(__m128 const* in,
+                                            float* out,
+                                            size_t count) noexcept
+{
+    // Every matrix occupies 48 bytes, so the alignment of the first row
+    // determines the alignment of all rows.
+    bool aligned = (reinterpret_cast<uintptr_t>(out) & 15) == 0;
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        __m128 cols[4];
+        mat4x4_12<true, true>(in[2 * i], in + 2 * i + 1, cols);
+
+        // The fourth row, (0, 0, 0, 1), is discarded
+        _MM_TRANSPOSE4_PS(cols[0], cols[1], cols[2], cols[3]);
+
+        float* row = out + 12 * i;
+        if (aligned)
+        {
+            _mm_stream_ps(row, cols[0]);
+            _mm_stream_ps(row + 4, cols[1]);
+            _mm_stream_ps(row + 8, cols[2]);
+        }
+        else
+        {
+            _mm_storeu_ps(row, cols[0]);
+            _mm_storeu_ps(row + 4, cols[1]);
+            _mm_storeu_ps(row + 8, cols[2]);
+        }
+    }
+
+    if (aligned)
+    {
+        // Order the non-temporal stores before any subsequent stores (e.g. a
+        // flag signaling that the upload buffer is ready)
+        _mm_sfence();
+    }
+}
 } // namespace kln
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "x86_sse.hpp"
+
+namespace kln
+{
+namespace detail
+{
+    // Partition memory layouts
+    //     LSB --> MSB
+    // p0: (e0, e1, e2, e3)
+    // p1: (1, e23, e31, e12)
+    // p2: (e0123, e01, e02, e03)
+    // p3: (e123, e032, e013, e021)
+
+    // Projection of the point a (p3) onto the plane b (p0), equivalent to
+    // (a | b) ^ b without forming the intermediate line.
+    //
+    // With n = (b1, b2, b3) and s = a0 b0 + a1 b1 + a2 b2 + a3 b3:
+    //
+    // (n.n) a0 e123 +
+    // ((n.n) a1 - s b1) e032 +
+    // ((n.n) a2 - s b2) e013 +
+    // ((n.n) a3 - s b3) e021
+    KLN_INLINE __m128 KLN_VEC_CALL proj30(__m128 a, __m128 b) noexcept
+    {
+        __m128 nn = hi_dp_bc(b, b);
+        __m128 s  = dp_bc(a, b);
+#ifdef KLEIN_SSE_4_1
+        __m128 n = _mm_blend_ps(b, _mm_setzero_ps(), 1);
+#else
+        __m128 n
+            = _mm_and_ps(b, _mm_castsi128_ps(_mm_set_epi32(-1, -1, -1, 0)));
+#endif
+        return fnmadd(s, n, _mm_mul_ps(nn, a));
+    }
+
+    // Projects count points onto a single plane. The norm and the masked
+    // normal of the plane are computed once.
+    KLN_INLINE void KLN_VEC_CALL proj30(__m128 const* in,
+                                        __m128 b,
+                                        __m128* out,
+                                        size_t count) noexcept
+    {
+        __m128 nn = hi_dp_bc(b, b);
+#ifdef KLEIN_SSE_4_1
+        __m128 n = _mm_blend_ps(b, _mm_setzero_ps(), 1);
+#else
+        __m128 n
+            = _mm_and_ps(b, _mm_castsi128_ps(_mm_set_epi32(-1, -1, -1, 0)));
+#endif
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 s = dp_bc(in[i], b);
+            out[i]   = fnmadd(s, n, _mm_mul_ps(nn, in[i]));
+        }
+    }
+
+    // Projection of the point a (p3) onto the line with partitions b (p1) and
+    // c (p2), equivalent to (a | b) ^ b without forming the intermediate
+    // plane.
+    //
+    // With m = (b1, b2, b3), l = (c1, c2, c3), x = (a1, a2, a3):
+    //
+    // -(m.m) a0 e123 - [(m.x) m + a0 (m x l)] (e032, e013, e021)
+    //
+    // The cross product is evaluated as l x m to absorb the negation.
+    KLN_INLINE __m128 KLN_VEC_CALL proj312(__m128 a,
+                                           __m128 b,
+                                           __m128 c) noexcept
+    {
+        __m128 mm = hi_dp_bc(b, b);
+        __m128 mx = hi_dp_bc(a, b);
+
+        __m128 lm = _mm_mul_ps(KLN_SWIZZLE(c, 1, 3, 2, 0),
+                               KLN_SWIZZLE(b, 2, 1, 3, 0));
+        lm        = fnmadd(
+            KLN_SWIZZLE(c, 2, 1, 3, 0), KLN_SWIZZLE(b, 1, 3, 2, 0), lm);
+
+        __m128 out = fnmadd(b, mx, _mm_mul_ps(KLN_SWIZZLE(a, 0, 0, 0, 0), lm));
+        return _mm_sub_ss(out, _mm_mul_ss(mm, a));
+    }
+
+    // Projects count points onto a single line. The norm and the swizzled
+    // components of the line are computed once.
+    KLN_INLINE void KLN_VEC_CALL proj312(__m128 const* in,
+                                         __m128 b,
+                                         __m128 c,
+                                         __m128* out,
+                                         size_t count) noexcept
+    {
+        __m128 mm = hi_dp_bc(b, b);
+
+        __m128 lm = _mm_mul_ps(KLN_SWIZZLE(c, 1, 3, 2, 0),
+                               KLN_SWIZZLE(b, 2, 1, 3, 0));
+        lm        = fnmadd(
+            KLN_SWIZZLE(c, 2, 1, 3, 0), KLN_SWIZZLE(b, 1, 3, 2, 0), lm);
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 a  = in[i];
+            __m128 mx = hi_dp_bc(a, b);
+            __m128 p
+                = fnmadd(b, mx, _mm_mul_ps(KLN_SWIZZLE(a, 0, 0, 0, 0), lm));
+            out[i] = _mm_sub_ss(p, _mm_mul_ss(mm, a));
+        }
+    }
+} // namespace detail
+} // namespace kln
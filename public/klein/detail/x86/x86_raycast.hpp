@@ -0,0 +1,212 @@
+// File: x86_raycast.hpp
+// Purpose: Intersect batches of SoA rays with planes and triangles. A ray is
+// a line (streams laid out as in line_soa) along with its origin (streams
+// laid out as in point_soa).
+//
+// Notes:
+// 1. The ray's line is met with the plane as in operator^(plane, line). With
+//    the plane (d, n) = (a0, a1, a2, a3) and the line partitions m = (b1, b2,
+//    b3) and l = (c1, c2, c3), this is
+//
+//    (n.m) e123 + (n x l - d m) (e032, e013, e021)
+//
+//    The weight n.m is inverted once per lane to normalize the hit point and
+//    to compute the ray parameter t = -(n.o + d) / (n.m), where o is the
+//    (normalized) origin. For a line constructed as o & p, the hit point is
+//    then o + t (p - o).
+// 2. A lane hits when 0 <= t < t_max. Rays parallel to the plane produce an
+//    infinite or NaN parameter and never hit. The outputs of lanes that miss
+//    are zeroed so the padding lanes of the output streams remain zeroed.
+// 3. Hits are reported as one bit per ray in 32-bit words, with ray i in bit
+//    i % 32 of word i / 32.
+
+#pragma once
+
+#include "x86_soa_math.hpp"
+
+namespace kln
+{
+namespace detail
+{
+    // Loads the m and l partitions of the lines at offset i. The scalar and
+    // e0123 streams are skipped.
+    KLN_INLINE void KLN_VEC_CALL soa_load_line(float const* in,
+                                               size_t stride,
+                                               size_t i,
+                                               soa_mask k,
+                                               soa_reg* out) noexcept
+    {
+        out[0] = soa_load(in + i, k);
+        out[1] = soa_load(in + stride + i, k);
+        out[2] = soa_load(in + 2 * stride + i, k);
+        out[3] = soa_load(in + 4 * stride + i, k);
+        out[4] = soa_load(in + 5 * stride + i, k);
+        out[5] = soa_load(in + 6 * stride + i, k);
+    }
+
+    // r: (m1, m2, m3, l1, l2, l3)
+    // o: (x, y, z)
+    // p: (x, y, z, d)
+    // out: (x, y, z, t) of the hit point
+    // Returns the lanes for which 0 <= t < t_max
+    KLN_INLINE soa_pred KLN_VEC_CALL soa_meet_ray(soa_reg const* r,
+                                                  soa_reg const* o,
+                                                  soa_reg const* p,
+                                                  soa_reg t_max,
+                                                  soa_reg* out) noexcept
+    {
+        soa_reg w = soa_mul(p[0], r[0]);
+        w         = soa_add(w, soa_mul(p[1], r[1]));
+        w         = soa_add(w, soa_mul(p[2], r[2]));
+
+        soa_reg x = soa_sub(soa_mul(p[1], r[5]), soa_mul(p[2], r[4]));
+        x         = soa_sub(x, soa_mul(p[3], r[0]));
+        soa_reg y = soa_sub(soa_mul(p[2], r[3]), soa_mul(p[0], r[5]));
+        y         = soa_sub(y, soa_mul(p[3], r[1]));
+        soa_reg z = soa_sub(soa_mul(p[0], r[4]), soa_mul(p[1], r[3]));
+        z         = soa_sub(z, soa_mul(p[3], r[2]));
+
+        soa_reg s = soa_mul(p[0], o[0]);
+        s         = soa_add(s, soa_mul(p[1], o[1]));
+        s         = soa_add(s, soa_mul(p[2], o[2]));
+        s         = soa_add(s, p[3]);
+
+        soa_reg inv = soa_div(soa_set1(1.f), w);
+        out[0]      = soa_mul(x, inv);
+        out[1]      = soa_mul(y, inv);
+        out[2]      = soa_mul(z, inv);
+        out[3]      = soa_mul(soa_sub(soa_set1(0.f), s), inv);
+
+        return soa_pred_and(soa_le(soa_set1(0.f), out[3]),
+                            soa_lt(out[3], t_max));
+    }
+
+    // Writes the hit points, parameters, and hit bits of the rays at offset i
+    KLN_INLINE void KLN_VEC_CALL soa_store_hits(soa_reg const* h,
+                                                soa_pred hit,
+                                                size_t i,
+                                                soa_mask k,
+                                                float* points,
+                                                size_t point_stride,
+                                                float* t,
+                                                uint32_t* mask) noexcept
+    {
+        soa_reg zero = soa_set1(0.f);
+        soa_store(points + i, soa_select(hit, h[0], zero), k);
+        soa_store(points + point_stride + i, soa_select(hit, h[1], zero), k);
+        soa_store(
+            points + 2 * point_stride + i, soa_select(hit, h[2], zero), k);
+        soa_store(points + 3 * point_stride + i,
+                  soa_select(hit, soa_set1(1.f), zero),
+                  k);
+        soa_store(t + i, soa_select(hit, h[3], zero), k);
+        soa_store_bits(hit, i, mask);
+    }
+
+    // Intersects count rays with a single plane a (p0) if PerRay is false, or
+    // ray i with plane i of the SoA planes (streams x, y, z, d) otherwise.
+    template <bool PerRay>
+    KLN_INLINE void KLN_VEC_CALL soa_raycast_planes(float const* rays,
+                                                    size_t ray_stride,
+                                                    float const* origins,
+                                                    size_t origin_stride,
+                                                    __m128 a,
+                                                    float const* planes,
+                                                    size_t plane_stride,
+                                                    float t_max,
+                                                    float* points,
+                                                    size_t point_stride,
+                                                    float* t,
+                                                    uint32_t* mask,
+                                                    size_t count) noexcept
+    {
+        float af[4];
+        _mm_storeu_ps(af, a);
+        soa_reg p[4] = {
+            soa_set1(af[1]), soa_set1(af[2]), soa_set1(af[3]), soa_set1(af[0])};
+        soa_reg limit = soa_set1(t_max);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg r[6];
+            soa_load_line(rays, ray_stride, i, k, r);
+
+            soa_reg o[3];
+            o[0] = soa_load(origins + i, k);
+            o[1] = soa_load(origins + origin_stride + i, k);
+            o[2] = soa_load(origins + 2 * origin_stride + i, k);
+
+            if (PerRay)
+            {
+                p[0] = soa_load(planes + i, k);
+                p[1] = soa_load(planes + plane_stride + i, k);
+                p[2] = soa_load(planes + 2 * plane_stride + i, k);
+                p[3] = soa_load(planes + 3 * plane_stride + i, k);
+            }
+
+            soa_reg h[4];
+            soa_pred hit = soa_meet_ray(r, o, p, limit, h);
+            soa_store_hits(h, hit, i, k, points, point_stride, t, mask);
+        }
+    }
+
+    // Intersects count rays with a single triangle given as its supporting
+    // plane tri[0] followed by the three edge planes tri[1..3] (all p0). The
+    // edge planes are orthogonal to the supporting plane and scaled such that
+    // they evaluate to 1 at the opposite vertex, so a point of the supporting
+    // plane lies within the triangle if all three evaluate as nonnegative.
+    KLN_INLINE void KLN_VEC_CALL soa_raycast_triangle(float const* rays,
+                                                      size_t ray_stride,
+                                                      float const* origins,
+                                                      size_t origin_stride,
+                                                      __m128 const* tri,
+                                                      float t_max,
+                                                      float* points,
+                                                      size_t point_stride,
+                                                      float* t,
+                                                      uint32_t* mask,
+                                                      size_t count) noexcept
+    {
+        // Support plane followed by the edge planes, each as (x, y, z, d)
+        soa_reg p[16];
+        for (size_t j = 0; j != 4; ++j)
+        {
+            float f[4];
+            _mm_storeu_ps(f, tri[j]);
+            p[4 * j]     = soa_set1(f[1]);
+            p[4 * j + 1] = soa_set1(f[2]);
+            p[4 * j + 2] = soa_set1(f[3]);
+            p[4 * j + 3] = soa_set1(f[0]);
+        }
+        soa_reg limit = soa_set1(t_max);
+        soa_reg zero  = soa_set1(0.f);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg r[6];
+            soa_load_line(rays, ray_stride, i, k, r);
+
+            soa_reg o[3];
+            o[0] = soa_load(origins + i, k);
+            o[1] = soa_load(origins + origin_stride + i, k);
+            o[2] = soa_load(origins + 2 * origin_stride + i, k);
+
+            soa_reg h[4];
+            soa_pred hit = soa_meet_ray(r, o, p, limit, h);
+
+            for (size_t j = 1; j != 4; ++j)
+            {
+                soa_reg e = soa_mul(p[4 * j], h[0]);
+                e         = soa_add(e, soa_mul(p[4 * j + 1], h[1]));
+                e         = soa_add(e, soa_mul(p[4 * j + 2], h[2]));
+                e         = soa_add(e, p[4 * j + 3]);
+                hit       = soa_pred_and(hit, soa_le(zero, e));
+            }
+
+            soa_store_hits(h, hit, i, k, points, point_stride, t, mask);
+        }
+    }
+} // namespace detail
+} // namespace kln
@@ -58,6 +58,36 @@ namespace detail
         p0_out = _mm_add_ps(tmp, tmp2);
     }
 
+    // Reflect count planes through the plane a. The terms that depend only on
+    // a are computed once. in and out are permitted to alias iff in == out.
+    KLN_INLINE void KLN_VEC_CALL sw00(__m128 a,
+                                      __m128 const* in,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        __m128 a_zzwy = KLN_SWIZZLE(a, 1, 3, 2, 2);
+        __m128 a_wwyz = KLN_SWIZZLE(a, 2, 1, 3, 3);
+        __m128 a1     = _mm_movehdup_ps(a);
+        __m128 two_a  = _mm_add_ps(a, a);
+
+        __m128 a_yyzw = KLN_SWIZZLE(a, 3, 2, 1, 1);
+        __m128 tmp2 = _mm_xor_ps(_mm_mul_ps(a_yyzw, a_yyzw), _mm_set_ss(-0.f));
+        tmp2        = _mm_sub_ps(tmp2, _mm_mul_ps(a_zzwy, a_zzwy));
+        tmp2        = _mm_sub_ps(tmp2, _mm_mul_ps(a_wwyz, a_wwyz));
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 b   = in[i];
+            __m128 tmp = _mm_mul_ps(a_zzwy, KLN_SWIZZLE(b, 1, 3, 2, 2));
+            tmp        = _mm_add_ps(
+                tmp, _mm_mul_ps(a_wwyz, KLN_SWIZZLE(b, 2, 1, 3, 3)));
+            tmp        = _mm_add_ss(tmp, _mm_mul_ss(a1, _mm_movehdup_ps(b)));
+            tmp        = _mm_mul_ps(tmp, two_a);
+
+            out[i] = _mm_add_ps(tmp, _mm_mul_ps(tmp2, b));
+        }
+    }
+
     KLN_INLINE void KLN_VEC_CALL sw10(__m128 a,
                                       __m128 b,
                                       __m128& KLN_RESTRICT p1,
@@ -97,6 +127,67 @@ namespace detail
         p2 = KLN_SWIZZLE(p2, 1, 3, 2, 0);
     }
 
+    // Reflect count lines through the plane a. in and out point to (p1, p2)
+    // pairs. The ideal part of each output accumulates both the sw10 term of
+    // the input's p1 and the sw20 term of the input's p2 (see
+    // plane::operator()(line const&)). in and out are permitted to alias iff
+    // in == out.
+    KLN_INLINE void KLN_VEC_CALL sw10(__m128 a,
+                                      __m128 const* in,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        __m128 a_zyzw = KLN_SWIZZLE(a, 3, 2, 1, 2);
+        __m128 a_ywyz = KLN_SWIZZLE(a, 2, 1, 3, 1);
+        __m128 a_wzwy = KLN_SWIZZLE(a, 1, 3, 2, 3);
+        __m128 a_zzwy = KLN_SWIZZLE(a, 1, 3, 2, 2);
+        __m128 a_wwyz = KLN_SWIZZLE(a, 2, 1, 3, 3);
+        __m128 a_yyzw = KLN_SWIZZLE(a, 3, 2, 1, 1);
+
+        __m128 two_zero = _mm_set_ps(2.f, 2.f, 2.f, 0.f);
+        __m128 scale1   = _mm_mul_ps(a_ywyz, two_zero);
+        __m128 scale2 = _mm_mul_ps(KLN_SWIZZLE(a, 0, 0, 0, 0), two_zero);
+        __m128 scale3 = _mm_mul_ps(a_wwyz, _mm_set_ps(-2.f, -2.f, -2.f, 0.f));
+
+        // Squared terms of sw10
+        __m128 sq1 = _mm_mul_ps(a_zyzw, a_zyzw);
+        sq1        = _mm_add_ps(sq1, _mm_mul_ps(a_wzwy, a_wzwy));
+        sq1        = _mm_xor_ps(sq1, _mm_set_ss(-0.f));
+        sq1        = _mm_sub_ps(_mm_mul_ps(a_ywyz, a_ywyz), sq1);
+
+        // Squared terms of sw20
+        __m128 sq2 = _mm_mul_ps(a_yyzw, a_yyzw);
+        sq2        = _mm_xor_ps(
+            _mm_set_ss(-0.f), _mm_add_ps(sq2, _mm_mul_ps(a_zzwy, a_zzwy)));
+        sq2 = _mm_sub_ps(sq2, _mm_mul_ps(a_wwyz, a_wwyz));
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 b = in[2 * i];
+            __m128 d = in[2 * i + 1];
+
+            __m128 b_xzwy = KLN_SWIZZLE(b, 1, 3, 2, 0);
+
+            __m128 p1 = _mm_mul_ps(a, b);
+            p1        = _mm_add_ps(p1, _mm_mul_ps(a_wzwy, b_xzwy));
+            p1        = _mm_mul_ps(p1, scale1);
+            p1        = _mm_add_ps(
+                p1, _mm_mul_ps(KLN_SWIZZLE(b, 2, 1, 3, 0), sq1));
+
+            __m128 p2 = _mm_mul_ps(a_zyzw, b_xzwy);
+            p2        = _mm_sub_ps(p2, _mm_mul_ps(a_wzwy, b));
+            p2        = KLN_SWIZZLE(_mm_mul_ps(p2, scale2), 1, 3, 2, 0);
+
+            __m128 q = _mm_mul_ps(a, d);
+            q = _mm_add_ps(q, _mm_mul_ps(a_zzwy, KLN_SWIZZLE(d, 1, 3, 2, 0)));
+            q = _mm_mul_ps(q, scale3);
+            q = _mm_add_ps(q, _mm_mul_ps(sq2, KLN_SWIZZLE(d, 2, 1, 3, 0)));
+
+            out[2 * i]     = KLN_SWIZZLE(p1, 1, 3, 2, 0);
+            out[2 * i + 1] = _mm_add_ps(p2, KLN_SWIZZLE(q, 1, 3, 2, 0));
+        }
+    }
+
     KLN_INLINE void KLN_VEC_CALL sw20(__m128 a, __m128 b, __m128& p2)
     {
         //                       -b0(a1^2 + a2^2 + a3^2) e0123 +
@@ -149,6 +240,36 @@ namespace detail
         p3_out = _mm_add_ps(p3_out, _mm_mul_ps(b, tmp));
     }
 
+    // Reflect count points through the plane a. in and out are permitted to
+    // alias iff in == out.
+    KLN_INLINE void KLN_VEC_CALL sw30(__m128 a,
+                                      __m128 const* in,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        __m128 a_xxxx = KLN_SWIZZLE(a, 0, 0, 0, 0);
+        __m128 a_zwyz = KLN_SWIZZLE(a, 2, 1, 3, 2);
+        __m128 a_yzwy = KLN_SWIZZLE(a, 1, 3, 2, 1);
+        __m128 scale  = _mm_mul_ps(a, _mm_set_ps(-2.f, -2.f, -2.f, 0.f));
+
+        __m128 tmp    = _mm_mul_ps(a_yzwy, a_yzwy);
+        tmp           = _mm_add_ps(tmp, _mm_mul_ps(a_zwyz, a_zwyz));
+        __m128 a_wyzw = KLN_SWIZZLE(a, 3, 2, 1, 3);
+        tmp           = _mm_sub_ps(
+            tmp, _mm_xor_ps(_mm_mul_ps(a_wyzw, a_wyzw), _mm_set_ss(-0.f)));
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 b = in[i];
+            __m128 p = _mm_mul_ps(a_xxxx, KLN_SWIZZLE(b, 0, 0, 0, 0));
+            p = _mm_add_ps(p, _mm_mul_ps(a_zwyz, KLN_SWIZZLE(b, 2, 1, 3, 0)));
+            p = _mm_add_ps(p, _mm_mul_ps(a_yzwy, KLN_SWIZZLE(b, 1, 3, 2, 0)));
+            p = _mm_mul_ps(p, scale);
+
+            out[i] = _mm_add_ps(p, _mm_mul_ps(b, tmp));
+        }
+    }
+
     // Apply a translator to a plane.
     // Assumes e0123 component of p2 is exactly 0
     // p0: (e0, e1, e2, e3)
@@ -189,6 +310,25 @@ namespace detail
         return _mm_add_ps(a, tmp);
     }
 
+    // Apply the translator b to count planes (see sw02 above). The reciprocal
+    // of the scalar component is computed once. in and out are permitted to
+    // alias iff in == out.
+    KLN_INLINE void KLN_VEC_CALL sw02(__m128 const* in,
+                                      __m128 b,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        __m128 inv_b = rcp_nr1(b);
+        inv_b        = _mm_add_ss(inv_b, inv_b);
+        inv_b = _mm_and_ps(inv_b, _mm_castsi128_ps(_mm_set_epi32(0, 0, 0, -1)));
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 a = in[i];
+            out[i]   = _mm_add_ps(a, _mm_mul_ss(hi_dp(a, b), inv_b));
+        }
+    }
+
     // Apply a translator to a line
     // a := p1 input
     // d := p2 input
@@ -226,6 +366,19 @@ namespace detail
         p2_out = _mm_add_ps(p2_out, d);
     }
 
+    // Apply the translator c to count lines stored as (p1, p2) pairs. in and
+    // out are permitted to alias iff in == out.
+    KLN_INLINE void KLN_VEC_CALL swL2(__m128 const* in,
+                                      __m128 c,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            swL2(in[2 * i], in[2 * i + 1], c, out + 2 * i);
+        }
+    }
+
     // Apply a translator to a point.
     // Assumes e0123 component of p2 is exactly 0
     // p2: (e0123, e01, e02, e03)
@@ -244,6 +397,23 @@ namespace detail
         return tmp;
     }
 
+    // Apply the translator b to count points. in and out are permitted to
+    // alias iff in == out.
+    KLN_INLINE void KLN_VEC_CALL sw32(__m128 const* in,
+                                      __m128 b,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        // Scaling by -2 is exact, so hoisting it matches sw32 above
+        __m128 scale = _mm_mul_ps(_mm_set_ps(-2.f, -2.f, -2.f, 0.f), b);
+        for (size_t i = 0; i != count; ++i)
+        {
+            __m128 a = in[i];
+            out[i]
+                = _mm_add_ps(a, _mm_mul_ps(KLN_SWIZZLE(a, 0, 0, 0, 0), scale));
+        }
+    }
+
 #if __cplusplus >= 201703L
     // Apply a motor to a motor (works on lines as well)
     // in points to the start of an array of motor inputs (alternating p1 and
@@ -277,19 +447,19 @@ namespace detail
         __m128 b_tmp = KLN_SWIZZLE(b, 2, 1, 3, 2);
         __m128 tmp2  = _mm_mul_ps(b_tmp, b_tmp);
         b_tmp        = KLN_SWIZZLE(b, 1, 3, 2, 3);
-        tmp2         = _mm_add_ps(tmp2, _mm_mul_ps(b_tmp, b_tmp));
+        tmp2         = fmadd(b_tmp, b_tmp, tmp2);
         tmp          = _mm_sub_ps(tmp, _mm_xor_ps(tmp2, _mm_set_ss(-0.f)));
         // tmp needs to be scaled by a and set to p1_out
 
         __m128 b_xxxx = KLN_SWIZZLE(b, 0, 0, 0, 0);
         __m128 scale  = _mm_set_ps(2.f, 2.f, 2.f, 0.f);
         tmp2          = _mm_mul_ps(b_xxxx, b_xwyz);
-        tmp2          = _mm_add_ps(tmp2, _mm_mul_ps(b, b_xzwy));
+        tmp2          = fmadd(b, b_xzwy, tmp2);
         tmp2          = _mm_mul_ps(tmp2, scale);
         // tmp2 needs to be scaled by (a0, a2, a3, a1) and added to p1_out
 
         __m128 tmp3 = _mm_mul_ps(b, b_xwyz);
-        tmp3        = _mm_sub_ps(tmp3, _mm_mul_ps(b_xxxx, b_xzwy));
+        tmp3        = fnmadd(b_xxxx, b_xzwy, tmp3);
         tmp3        = _mm_mul_ps(tmp3, scale);
         // tmp3 needs to be scaled by (a0, a3, a1, a2) and added to p1_out
 
@@ -337,26 +507,23 @@ namespace detail
             __m128 c_xwyz = KLN_SWIZZLE(*c, 2, 1, 3, 0);
 
             tmp4 = _mm_mul_ps(b, *c);
-            tmp4 = _mm_sub_ps(
-                tmp4, _mm_mul_ps(b_yxxx, KLN_SWIZZLE(*c, 0, 0, 0, 1)));
-            tmp4 = _mm_sub_ps(tmp4,
-                              _mm_mul_ps(KLN_SWIZZLE(b, 1, 3, 3, 2),
-                                         KLN_SWIZZLE(*c, 1, 3, 3, 2)));
-            tmp4 = _mm_sub_ps(tmp4,
-                              _mm_mul_ps(KLN_SWIZZLE(b, 2, 1, 2, 3),
-                                         KLN_SWIZZLE(*c, 2, 1, 2, 3)));
+            tmp4 = fnmadd(b_yxxx, KLN_SWIZZLE(*c, 0, 0, 0, 1), tmp4);
+            tmp4 = fnmadd(
+                KLN_SWIZZLE(b, 1, 3, 3, 2), KLN_SWIZZLE(*c, 1, 3, 3, 2), tmp4);
+            tmp4 = fnmadd(
+                KLN_SWIZZLE(b, 2, 1, 2, 3), KLN_SWIZZLE(*c, 2, 1, 2, 3), tmp4);
             tmp4 = _mm_add_ps(tmp4, tmp4);
 
             tmp5 = _mm_mul_ps(b, c_xwyz);
-            tmp5 = _mm_add_ps(tmp5, _mm_mul_ps(b_xzwy, czero));
-            tmp5 = _mm_add_ps(tmp5, _mm_mul_ps(b_xwyz, *c));
-            tmp5 = _mm_sub_ps(tmp5, _mm_mul_ps(b_xxxx, c_xzwy));
+            tmp5 = fmadd(b_xzwy, czero, tmp5);
+            tmp5 = fmadd(b_xwyz, *c, tmp5);
+            tmp5 = fnmadd(b_xxxx, c_xzwy, tmp5);
             tmp5 = _mm_mul_ps(tmp5, scale);
 
             tmp6 = _mm_mul_ps(b, c_xzwy);
-            tmp6 = _mm_add_ps(tmp6, _mm_mul_ps(b_xxxx, c_xwyz));
-            tmp6 = _mm_add_ps(tmp6, _mm_mul_ps(b_xzwy, *c));
-            tmp6 = _mm_sub_ps(tmp6, _mm_mul_ps(b_xwyz, czero));
+            tmp6 = fmadd(b_xxxx, c_xwyz, tmp6);
+            tmp6 = fmadd(b_xzwy, *c, tmp6);
+            tmp6 = fnmadd(b_xwyz, czero, tmp6);
             tmp6 = _mm_mul_ps(tmp6, scale);
         }
 
@@ -364,25 +531,23 @@ namespace detail
         constexpr size_t stride = InputP2 ? 2 : 1;
         for (size_t i = 0; i != limit; ++i)
         {
-            __m128 const& p1_in = in[stride * i]; // a
+            __m128 p1_in        = in[stride * i]; // a
             __m128 p1_in_xzwy   = KLN_SWIZZLE(p1_in, 1, 3, 2, 0);
             __m128 p1_in_xwyz   = KLN_SWIZZLE(p1_in, 2, 1, 3, 0);
 
             __m128& p1_out = out[stride * i];
 
             p1_out = _mm_mul_ps(tmp, p1_in);
-            p1_out = _mm_add_ps(p1_out, _mm_mul_ps(tmp2, p1_in_xzwy));
-            p1_out = _mm_add_ps(p1_out, _mm_mul_ps(tmp3, p1_in_xwyz));
+            p1_out = fmadd(tmp2, p1_in_xzwy, p1_out);
+            p1_out = fmadd(tmp3, p1_in_xwyz, p1_out);
 
             if constexpr (InputP2)
             {
-                __m128 const& p2_in = in[2 * i + 1]; // d
+                __m128 p2_in        = in[2 * i + 1]; // d
                 __m128& p2_out      = out[2 * i + 1];
                 p2_out              = _mm_mul_ps(tmp, p2_in);
-                p2_out              = _mm_add_ps(
-                    p2_out, _mm_mul_ps(tmp2, KLN_SWIZZLE(p2_in, 1, 3, 2, 0)));
-                p2_out = _mm_add_ps(
-                    p2_out, _mm_mul_ps(tmp3, KLN_SWIZZLE(p2_in, 2, 1, 3, 0)));
+                p2_out = fmadd(tmp2, KLN_SWIZZLE(p2_in, 1, 3, 2, 0), p2_out);
+                p2_out = fmadd(tmp3, KLN_SWIZZLE(p2_in, 2, 1, 3, 0), p2_out);
             }
 
             // If what is being applied is a rotor, the non-directional
@@ -390,9 +555,9 @@ namespace detail
             if constexpr (Translate)
             {
                 __m128& p2_out = out[2 * i + 1];
-                p2_out         = _mm_add_ps(p2_out, _mm_mul_ps(tmp4, p1_in));
-                p2_out = _mm_add_ps(p2_out, _mm_mul_ps(tmp5, p1_in_xwyz));
-                p2_out = _mm_add_ps(p2_out, _mm_mul_ps(tmp6, p1_in_xzwy));
+                p2_out         = fmadd(tmp4, p1_in, p2_out);
+                p2_out         = fmadd(tmp5, p1_in_xwyz, p2_out);
+                p2_out         = fmadd(tmp6, p1_in_xzwy, p2_out);
             }
         }
     }
@@ -497,8 +662,7 @@ namespace detail
         for (size_t i = 0; i != limit; ++i)
         {
             // Compute the lower block for components e1, e2, and e3
-            __m128& p = out[i];
-            p         = _mm_mul_ps(tmp1, KLN_SWIZZLE(a[i], 1, 3, 2, 0));
+            __m128 p  = _mm_mul_ps(tmp1, KLN_SWIZZLE(a[i], 1, 3, 2, 0));
             p = _mm_add_ps(p, _mm_mul_ps(tmp2, KLN_SWIZZLE(a[i], 2, 1, 3, 0)));
             p = _mm_add_ps(p, _mm_mul_ps(tmp3, a[i]));
 
@@ -507,6 +671,8 @@ namespace detail
                 __m128 tmp5 = hi_dp(tmp4, a[i]);
                 p           = _mm_add_ps(p, tmp5);
             }
+
+            out[i] = p;
         }
     }
 
@@ -549,32 +715,31 @@ namespace detail
         __m128 b_xzwy = KLN_SWIZZLE(b, 1, 3, 2, 0);
 
         __m128 tmp1 = _mm_mul_ps(b, b_xwyz);
-        tmp1        = _mm_sub_ps(tmp1, _mm_mul_ps(b_xxxx, b_xzwy));
+        tmp1        = fnmadd(b_xxxx, b_xzwy, tmp1);
         tmp1        = _mm_mul_ps(tmp1, two);
         // tmp1 needs to be scaled by (_, a3, a1, a2)
 
         __m128 tmp2 = _mm_mul_ps(b_xxxx, b_xwyz);
-        tmp2        = _mm_add_ps(tmp2, _mm_mul_ps(b_xzwy, b));
+        tmp2        = fmadd(b_xzwy, b, tmp2);
         tmp2        = _mm_mul_ps(tmp2, two);
         // tmp2 needs to be scaled by (_, a2, a3, a1)
 
         __m128 tmp3  = _mm_mul_ps(b, b);
         __m128 b_tmp = KLN_SWIZZLE(b, 0, 0, 0, 1);
-        tmp3         = _mm_add_ps(tmp3, _mm_mul_ps(b_tmp, b_tmp));
+        tmp3         = fmadd(b_tmp, b_tmp, tmp3);
         b_tmp        = KLN_SWIZZLE(b, 2, 1, 3, 2);
         __m128 tmp4  = _mm_mul_ps(b_tmp, b_tmp);
         b_tmp        = KLN_SWIZZLE(b, 1, 3, 2, 3);
-        tmp4         = _mm_add_ps(tmp4, _mm_mul_ps(b_tmp, b_tmp));
+        tmp4         = fmadd(b_tmp, b_tmp, tmp4);
         tmp3         = _mm_sub_ps(tmp3, _mm_xor_ps(tmp4, _mm_set_ss(-0.f)));
         // tmp3 needs to be scaled by (a0, a1, a2, a3)
 
         if constexpr (Translate)
         {
             tmp4 = _mm_mul_ps(b_xzwy, KLN_SWIZZLE(*c, 2, 1, 3, 0));
-            tmp4 = _mm_sub_ps(tmp4, _mm_mul_ps(b_xxxx, *c));
-            tmp4 = _mm_sub_ps(
-                tmp4, _mm_mul_ps(b_xwyz, KLN_SWIZZLE(*c, 1, 3, 2, 0)));
-            tmp4 = _mm_sub_ps(tmp4, _mm_mul_ps(b, KLN_SWIZZLE(*c, 0, 0, 0, 0)));
+            tmp4 = fnmadd(b_xxxx, *c, tmp4);
+            tmp4 = fnmadd(b_xwyz, KLN_SWIZZLE(*c, 1, 3, 2, 0), tmp4);
+            tmp4 = fnmadd(b, KLN_SWIZZLE(*c, 0, 0, 0, 0), tmp4);
 
             // Mask low component and scale other components by 2
             tmp4 = _mm_mul_ps(tmp4, two);
@@ -584,16 +749,16 @@ namespace detail
         size_t limit = Variadic ? count : 1;
         for (size_t i = 0; i != limit; ++i)
         {
-            __m128& p = out[i];
-            p         = _mm_mul_ps(tmp1, KLN_SWIZZLE(a[i], 2, 1, 3, 0));
-            p = _mm_add_ps(p, _mm_mul_ps(tmp2, KLN_SWIZZLE(a[i], 1, 3, 2, 0)));
-            p = _mm_add_ps(p, _mm_mul_ps(tmp3, a[i]));
+            __m128 p  = _mm_mul_ps(tmp1, KLN_SWIZZLE(a[i], 2, 1, 3, 0));
+            p         = fmadd(tmp2, KLN_SWIZZLE(a[i], 1, 3, 2, 0), p);
+            p         = fmadd(tmp3, a[i], p);
 
             if constexpr (Translate)
             {
-                p = _mm_add_ps(
-                    p, _mm_mul_ps(tmp4, KLN_SWIZZLE(a[i], 0, 0, 0, 0)));
+                p = fmadd(tmp4, KLN_SWIZZLE(a[i], 0, 0, 0, 0), p);
             }
+
+            out[i] = p;
         }
     }
 #else
@@ -625,5 +790,284 @@ namespace detail
         // Set the low component to unity
         return _mm_add_ps(tmp, _mm_set_ss(1.f));
     }
+
+    // Motor-dependent temporaries of sw312 (see the expansion there). When
+    // many points are conjugated by motors fetched indirectly (e.g. skinning
+    // via bone indices), preparing these once per distinct motor and reusing
+    // them for consecutive points sharing that motor avoids roughly half of
+    // the work in sw312.
+    struct sw312_state
+    {
+        // Scaled by (_, a3, a1, a2)
+        __m128 tmp1;
+        // Scaled by (_, a2, a3, a1)
+        __m128 tmp2;
+        // Scaled by (a0, a1, a2, a3)
+        __m128 tmp3;
+        // Scaled by (_, a0, a0, a0)
+        __m128 tmp4;
+    };
+
+    // b := p1 (rotor part)
+    // c := p2 (translator part)
+    KLN_INLINE void KLN_VEC_CALL sw312_prepare(__m128 b,
+                                               __m128 c,
+                                               sw312_state& out) noexcept
+    {
+        __m128 two    = _mm_set_ps(2.f, 2.f, 2.f, 0.f);
+        __m128 b_xxxx = KLN_SWIZZLE(b, 0, 0, 0, 0);
+        __m128 b_xwyz = KLN_SWIZZLE(b, 2, 1, 3, 0);
+        __m128 b_xzwy = KLN_SWIZZLE(b, 1, 3, 2, 0);
+
+        out.tmp1 = _mm_mul_ps(b, b_xwyz);
+        out.tmp1 = fnmadd(b_xxxx, b_xzwy, out.tmp1);
+        out.tmp1 = _mm_mul_ps(out.tmp1, two);
+
+        out.tmp2 = _mm_mul_ps(b_xxxx, b_xwyz);
+        out.tmp2 = fmadd(b_xzwy, b, out.tmp2);
+        out.tmp2 = _mm_mul_ps(out.tmp2, two);
+
+        __m128 b_tmp = KLN_SWIZZLE(b, 0, 0, 0, 1);
+        out.tmp3     = fmadd(b_tmp, b_tmp, _mm_mul_ps(b, b));
+        b_tmp        = KLN_SWIZZLE(b, 2, 1, 3, 2);
+        __m128 tmp   = _mm_mul_ps(b_tmp, b_tmp);
+        b_tmp        = KLN_SWIZZLE(b, 1, 3, 2, 3);
+        tmp          = fmadd(b_tmp, b_tmp, tmp);
+        out.tmp3     = _mm_sub_ps(out.tmp3, _mm_xor_ps(tmp, _mm_set_ss(-0.f)));
+
+        out.tmp4 = _mm_mul_ps(b_xzwy, KLN_SWIZZLE(c, 2, 1, 3, 0));
+        out.tmp4 = fnmadd(b_xxxx, c, out.tmp4);
+        out.tmp4 = fnmadd(b_xwyz, KLN_SWIZZLE(c, 1, 3, 2, 0), out.tmp4);
+        out.tmp4 = fnmadd(b, KLN_SWIZZLE(c, 0, 0, 0, 0), out.tmp4);
+        out.tmp4 = _mm_mul_ps(out.tmp4, two);
+    }
+
+    // Conjugate the point a with the motor whose temporaries were prepared in
+    // state. Equivalent to sw312<false, Translate>.
+    template <bool Translate = true>
+    KLN_INLINE __m128 KLN_VEC_CALL sw312_apply(sw312_state const& state,
+                                               __m128 a) noexcept
+    {
+        __m128 p = _mm_mul_ps(state.tmp1, KLN_SWIZZLE(a, 2, 1, 3, 0));
+        p = fmadd(state.tmp2, KLN_SWIZZLE(a, 1, 3, 2, 0), p);
+        p = fmadd(state.tmp3, a, p);
+        if (Translate)
+        {
+            p = fmadd(state.tmp4, KLN_SWIZZLE(a, 0, 0, 0, 0), p);
+        }
+        return p;
+    }
+
+    // Motor-dependent temporaries of sw012 (see the expansion there)
+    struct sw012_state
+    {
+        // Scaled by (a0, a2, a3, a1)
+        __m128 tmp1;
+        // Scaled by (a0, a3, a1, a2)
+        __m128 tmp2;
+        // Scaled by a
+        __m128 tmp3;
+        // Dotted with the high components of a
+        __m128 tmp4;
+    };
+
+    // b := p1 (rotor part)
+    // c := p2 (translator part)
+    KLN_INLINE void KLN_VEC_CALL sw012_prepare(__m128 b,
+                                               __m128 c,
+                                               sw012_state& out) noexcept
+    {
+        __m128 dc_scale = _mm_set_ps(2.f, 2.f, 2.f, 1.f);
+        __m128 b_xwyz   = KLN_SWIZZLE(b, 2, 1, 3, 0);
+        __m128 b_xzwy   = KLN_SWIZZLE(b, 1, 3, 2, 0);
+        __m128 b_xxxx   = KLN_SWIZZLE(b, 0, 0, 0, 0);
+
+        __m128 b_zxxx = KLN_SWIZZLE(b, 0, 0, 0, 2);
+        out.tmp1      = _mm_mul_ps(b_zxxx, KLN_SWIZZLE(b, 2, 1, 3, 2));
+        out.tmp1      = _mm_add_ps(
+            out.tmp1,
+            _mm_mul_ps(KLN_SWIZZLE(b, 1, 3, 2, 1), KLN_SWIZZLE(b, 3, 2, 1, 1)));
+        out.tmp1 = _mm_mul_ps(out.tmp1, dc_scale);
+
+        out.tmp2 = _mm_mul_ps(b, b_xwyz);
+        __m128 b_wxxx = KLN_SWIZZLE(b, 0, 0, 0, 3);
+        out.tmp2      = _mm_sub_ps(
+            out.tmp2,
+            _mm_xor_ps(_mm_set_ss(-0.f),
+                       _mm_mul_ps(b_wxxx, KLN_SWIZZLE(b, 1, 3, 2, 3))));
+        out.tmp2 = _mm_mul_ps(out.tmp2, dc_scale);
+
+        out.tmp3 = _mm_mul_ps(b, b);
+        out.tmp3 = _mm_sub_ps(out.tmp3, _mm_mul_ps(b_xwyz, b_xwyz));
+        out.tmp3 = _mm_add_ps(out.tmp3, _mm_mul_ps(b_xxxx, b_xxxx));
+        out.tmp3 = _mm_sub_ps(out.tmp3, _mm_mul_ps(b_xzwy, b_xzwy));
+
+        out.tmp4 = _mm_mul_ps(b_xxxx, c);
+        out.tmp4 = _mm_add_ps(
+            out.tmp4, _mm_mul_ps(b_xzwy, KLN_SWIZZLE(c, 2, 1, 3, 0)));
+        out.tmp4
+            = _mm_add_ps(out.tmp4, _mm_mul_ps(b, KLN_SWIZZLE(c, 0, 0, 0, 0)));
+        out.tmp4 = _mm_sub_ps(
+            out.tmp4, _mm_mul_ps(b_xwyz, KLN_SWIZZLE(c, 1, 3, 2, 0)));
+        out.tmp4 = _mm_mul_ps(out.tmp4, dc_scale);
+    }
+
+    // Conjugate the plane a with the motor whose temporaries were prepared in
+    // state. Equivalent to sw012<false, true>.
+    KLN_INLINE __m128 KLN_VEC_CALL sw012_apply(sw012_state const& state,
+                                               __m128 a) noexcept
+    {
+        __m128 p = _mm_mul_ps(state.tmp1, KLN_SWIZZLE(a, 1, 3, 2, 0));
+        p = _mm_add_ps(p, _mm_mul_ps(state.tmp2, KLN_SWIZZLE(a, 2, 1, 3, 0)));
+        p = _mm_add_ps(p, _mm_mul_ps(state.tmp3, a));
+        return _mm_add_ps(p, hi_dp(state.tmp4, a));
+    }
+
+    // Motor-dependent temporaries of swMM (see the expansion there)
+    struct swMM_state
+    {
+        // Scaled by a and d
+        __m128 tmp;
+        // Scaled by (a0, a2, a3, a1) and (d0, d2, d3, d1)
+        __m128 tmp2;
+        // Scaled by (a0, a3, a1, a2) and (d0, d3, d1, d2)
+        __m128 tmp3;
+        // Scaled by a, added to p2
+        __m128 tmp4;
+        // Scaled by (a0, a3, a1, a2), added to p2
+        __m128 tmp5;
+        // Scaled by (a0, a2, a3, a1), added to p2
+        __m128 tmp6;
+    };
+
+    // b := p1 (rotor part)
+    // c := p2 (translator part)
+    KLN_INLINE void KLN_VEC_CALL swMM_prepare(__m128 b,
+                                              __m128 c,
+                                              swMM_state& out) noexcept
+    {
+        __m128 b_xwyz   = KLN_SWIZZLE(b, 2, 1, 3, 0);
+        __m128 b_xzwy   = KLN_SWIZZLE(b, 1, 3, 2, 0);
+        __m128 b_yxxx   = KLN_SWIZZLE(b, 0, 0, 0, 1);
+        __m128 b_yxxx_2 = _mm_mul_ps(b_yxxx, b_yxxx);
+
+        out.tmp      = _mm_mul_ps(b, b);
+        out.tmp      = _mm_add_ps(out.tmp, b_yxxx_2);
+        __m128 b_tmp = KLN_SWIZZLE(b, 2, 1, 3, 2);
+        __m128 tmp2  = _mm_mul_ps(b_tmp, b_tmp);
+        b_tmp        = KLN_SWIZZLE(b, 1, 3, 2, 3);
+        tmp2         = fmadd(b_tmp, b_tmp, tmp2);
+        out.tmp = _mm_sub_ps(out.tmp, _mm_xor_ps(tmp2, _mm_set_ss(-0.f)));
+
+        __m128 b_xxxx = KLN_SWIZZLE(b, 0, 0, 0, 0);
+        __m128 scale  = _mm_set_ps(2.f, 2.f, 2.f, 0.f);
+        out.tmp2      = _mm_mul_ps(b_xxxx, b_xwyz);
+        out.tmp2      = fmadd(b, b_xzwy, out.tmp2);
+        out.tmp2      = _mm_mul_ps(out.tmp2, scale);
+
+        out.tmp3 = _mm_mul_ps(b, b_xwyz);
+        out.tmp3 = fnmadd(b_xxxx, b_xzwy, out.tmp3);
+        out.tmp3 = _mm_mul_ps(out.tmp3, scale);
+
+        __m128 czero  = KLN_SWIZZLE(c, 0, 0, 0, 0);
+        __m128 c_xzwy = KLN_SWIZZLE(c, 1, 3, 2, 0);
+        __m128 c_xwyz = KLN_SWIZZLE(c, 2, 1, 3, 0);
+
+        out.tmp4 = _mm_mul_ps(b, c);
+        out.tmp4 = fnmadd(b_yxxx, KLN_SWIZZLE(c, 0, 0, 0, 1), out.tmp4);
+        out.tmp4 = fnmadd(
+            KLN_SWIZZLE(b, 1, 3, 3, 2), KLN_SWIZZLE(c, 1, 3, 3, 2), out.tmp4);
+        out.tmp4 = fnmadd(
+            KLN_SWIZZLE(b, 2, 1, 2, 3), KLN_SWIZZLE(c, 2, 1, 2, 3), out.tmp4);
+        out.tmp4 = _mm_add_ps(out.tmp4, out.tmp4);
+
+        out.tmp5 = _mm_mul_ps(b, c_xwyz);
+        out.tmp5 = fmadd(b_xzwy, czero, out.tmp5);
+        out.tmp5 = fmadd(b_xwyz, c, out.tmp5);
+        out.tmp5 = fnmadd(b_xxxx, c_xzwy, out.tmp5);
+        out.tmp5 = _mm_mul_ps(out.tmp5, scale);
+
+        out.tmp6 = _mm_mul_ps(b, c_xzwy);
+        out.tmp6 = fmadd(b_xxxx, c_xwyz, out.tmp6);
+        out.tmp6 = fmadd(b_xzwy, c, out.tmp6);
+        out.tmp6 = fnmadd(b_xwyz, czero, out.tmp6);
+        out.tmp6 = _mm_mul_ps(out.tmp6, scale);
+    }
+
+    // Conjugate the line (p1, p2) at in with the motor whose temporaries were
+    // prepared in state and write the result to out. Equivalent to
+    // swMM<false, true, true>. in and out are permitted to alias.
+    KLN_INLINE void KLN_VEC_CALL swMM_apply(swMM_state const& state,
+                                            __m128 const* in,
+                                            __m128* out) noexcept
+    {
+        __m128 p1_in      = in[0]; // a
+        __m128 p2_in      = in[1]; // d
+        __m128 p1_in_xzwy = KLN_SWIZZLE(p1_in, 1, 3, 2, 0);
+        __m128 p1_in_xwyz = KLN_SWIZZLE(p1_in, 2, 1, 3, 0);
+
+        __m128 p1 = _mm_mul_ps(state.tmp, p1_in);
+        p1        = fmadd(state.tmp2, p1_in_xzwy, p1);
+        p1        = fmadd(state.tmp3, p1_in_xwyz, p1);
+
+        __m128 p2 = _mm_mul_ps(state.tmp, p2_in);
+        p2        = fmadd(state.tmp2, KLN_SWIZZLE(p2_in, 1, 3, 2, 0), p2);
+        p2        = fmadd(state.tmp3, KLN_SWIZZLE(p2_in, 2, 1, 3, 0), p2);
+        p2        = fmadd(state.tmp4, p1_in, p2);
+        p2        = fmadd(state.tmp5, p1_in_xwyz, p2);
+        p2        = fmadd(state.tmp6, p1_in_xzwy, p2);
+
+        out[0] = p1;
+        out[1] = p2;
+    }
+
+    // Load three packed floats (x, y, z) as (w, x, y, z) without reading past
+    // the end of the triple
+    KLN_INLINE __m128 KLN_VEC_CALL load_xyz(float const* xyz, __m128 w) noexcept
+    {
+        __m128 xy = _mm_castsi128_ps(
+            _mm_loadl_epi64(reinterpret_cast<__m128i const*>(xyz)));
+        __m128 v = _mm_movelh_ps(xy, _mm_load_ss(xyz + 2));
+        return _mm_move_ss(KLN_SWIZZLE(v, 2, 1, 0, 3), w);
+    }
+
+    // Store the (x, y, z) components of (w, x, y, z) as three packed floats
+    KLN_INLINE void KLN_VEC_CALL store_xyz(float* xyz, __m128 v) noexcept
+    {
+        __m128 t = KLN_SWIZZLE(v, 3, 3, 2, 1);
+        _mm_storel_pi(reinterpret_cast<__m64*>(xyz), t);
+        _mm_store_ss(xyz + 2, _mm_movehl_ps(t, t));
+    }
+
+    // Conjugate the float triples of count interleaved vertices in place. The
+    // vertex i starts at base + i * stride. The triple at position_offset (if
+    // not ~0) is treated as a point and each triple at direction_offsets[k] is
+    // treated as a direction. All attributes of a vertex are transformed
+    // before moving on to the next, so memory is traversed once.
+    KLN_INLINE void KLN_VEC_CALL sw312_vertices(sw312_state const& state,
+                                                unsigned char* base,
+                                                size_t count,
+                                                size_t stride,
+                                                size_t position_offset,
+                                                size_t const* direction_offsets,
+                                                size_t direction_count) noexcept
+    {
+        __m128 one  = _mm_set_ss(1.f);
+        __m128 zero = _mm_setzero_ps();
+        for (size_t i = 0; i != count; ++i, base += stride)
+        {
+            if (position_offset != ~size_t{0})
+            {
+                float* p = reinterpret_cast<float*>(base + position_offset);
+                store_xyz(p, sw312_apply(state, load_xyz(p, one)));
+            }
+            for (size_t k = 0; k != direction_count; ++k)
+            {
+                float* d
+                    = reinterpret_cast<float*>(base + direction_offsets[k]);
+                store_xyz(d, sw312_apply(state, load_xyz(d, zero)));
+            }
+        }
+    }
 } // namespace detail
 } // namespace kln
\ No newline at end of file
@@ -0,0 +1,686 @@
+// File: x86_soa.hpp
+// Purpose: Define kernels that operate on structure-of-arrays (SoA) data.
+// Unlike the kernels in x86_sandwich.hpp, each register lane here holds the
+// same component of a *different* entity, so no swizzles are needed and the
+// kernel width is simply the widest register available (16 lanes with
+// AVX-512, 8 lanes with AVX2, 4 lanes otherwise).
+//
+// Notes:
+// 1. SoA data is laid out as a single buffer of consecutive streams separated
+//    by a fixed stride (in floats). For points, the streams are (x, y, z, w)
+//    and for planes, the streams are (x, y, z, d). For motors, the streams
+//    are (e23, e31, e12, scalar, e01, e02, e03, e0123) such that the low
+//    component of each register partition is stored last, as with points and
+//    planes.
+// 2. The stride and all streams must be padded to a multiple of `soa_pad`
+//    floats. With AVX-512, the final partial register of a stream is
+//    processed with masked loads and stores so padding lanes are never
+//    touched. Narrower kernels process whole registers, so the padding lanes
+//    are read and written.
+
+#pragma once
+
+#include "x86_sse.hpp"
+
+#include <cstddef>
+
+namespace kln
+{
+namespace detail
+{
+    // Streams are padded to a multiple of 16 floats (one cache line) so that
+    // every kernel width divides the stream length evenly.
+    constexpr size_t soa_pad = 16;
+
+#if defined(KLEIN_AVX512)
+    using soa_reg              = __m512;
+    using soa_mask             = __mmask16;
+    constexpr size_t soa_width = 16;
+
+    // Mask selecting the first min(n, 16) lanes
+    KLN_INLINE soa_mask KLN_VEC_CALL soa_tail(size_t n) noexcept
+    {
+        return n >= soa_width ? static_cast<soa_mask>(0xffff)
+                              : static_cast<soa_mask>((1u << n) - 1);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_set1(float f) noexcept
+    {
+        return _mm512_set1_ps(f);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_load(float const* in,
+                                             soa_mask mask) noexcept
+    {
+        return _mm512_maskz_loadu_ps(mask, in);
+    }
+
+    KLN_INLINE void KLN_VEC_CALL soa_store(float* out,
+                                           soa_reg a,
+                                           soa_mask mask) noexcept
+    {
+        _mm512_mask_storeu_ps(out, mask, a);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_add(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm512_add_ps(a, b);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_sub(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm512_sub_ps(a, b);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_mul(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm512_mul_ps(a, b);
+    }
+#else
+    // Without mask registers, partial registers are processed in full and
+    // rely on the stream padding.
+    struct soa_mask
+    {
+    };
+
+    KLN_INLINE soa_mask KLN_VEC_CALL soa_tail(size_t) noexcept
+    {
+        return {};
+    }
+
+#    if defined(KLEIN_AVX2)
+    using soa_reg              = __m256;
+    constexpr size_t soa_width = 8;
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_set1(float f) noexcept
+    {
+        return _mm256_set1_ps(f);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_load(float const* in, soa_mask) noexcept
+    {
+        return _mm256_loadu_ps(in);
+    }
+
+    KLN_INLINE void KLN_VEC_CALL soa_store(float* out,
+                                           soa_reg a,
+                                           soa_mask) noexcept
+    {
+        _mm256_storeu_ps(out, a);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_add(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_sub(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_mul(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm256_mul_ps(a, b);
+    }
+#    else
+    using soa_reg              = __m128;
+    constexpr size_t soa_width = 4;
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_set1(float f) noexcept
+    {
+        return _mm_set1_ps(f);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_load(float const* in, soa_mask) noexcept
+    {
+        return _mm_loadu_ps(in);
+    }
+
+    KLN_INLINE void KLN_VEC_CALL soa_store(float* out,
+                                           soa_reg a,
+                                           soa_mask) noexcept
+    {
+        _mm_storeu_ps(out, a);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_add(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_sub(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm_sub_ps(a, b);
+    }
+
+    KLN_INLINE soa_reg KLN_VEC_CALL soa_mul(soa_reg a, soa_reg b) noexcept
+    {
+        return _mm_mul_ps(a, b);
+    }
+#    endif
+#endif
+
+    // Scalar coefficients of a motor's action on points and planes. Because
+    // every lane of an SoA register belongs to a different entity, the
+    // motor-dependent terms of sw312 and sw012 are computed once here and
+    // broadcast, leaving only multiply-adds in the inner loop.
+    struct soa_motor
+    {
+        // Rotational block shared by points and planes (row-major)
+        float r[9];
+        // Point translation (x, y, z rows scaled by w)
+        float t[3];
+        // Plane translation (d row scaled by x, y, z)
+        float q[3];
+        // Squared norm of the rotor part (scales w and d)
+        float s;
+    };
+
+    // b := p1 (rotor part)
+    // c := p2 (translator part), ignored if nullptr
+    KLN_INLINE void KLN_VEC_CALL soa_coeffs(__m128 b,
+                                            __m128 const* c,
+                                            soa_motor& out) noexcept
+    {
+        // See the expansions in sw312 and sw012 for derivations. The
+        // rotational block is common to both:
+        //
+        // x' = x(b0^2 + b1^2 - b3^2 - b2^2) +
+        //      2y(b0 b3 + b2 b1) +
+        //      2z(b1 b3 - b0 b2)
+        //
+        // y' = y(b0^2 + b2^2 - b1^2 - b3^2) +
+        //      2z(b0 b1 + b3 b2) +
+        //      2x(b2 b1 - b0 b3)
+        //
+        // z' = z(b0^2 + b3^2 - b2^2 - b1^2) +
+        //      2x(b0 b2 + b1 b3) +
+        //      2y(b3 b2 - b0 b1)
+        float bf[4];
+        _mm_storeu_ps(bf, b);
+        float b0 = bf[0];
+        float b1 = bf[1];
+        float b2 = bf[2];
+        float b3 = bf[3];
+
+        float b0_2 = b0 * b0;
+        float b1_2 = b1 * b1;
+        float b2_2 = b2 * b2;
+        float b3_2 = b3 * b3;
+
+        out.r[0] = b0_2 + b1_2 - b3_2 - b2_2;
+        out.r[1] = 2.f * (b0 * b3 + b2 * b1);
+        out.r[2] = 2.f * (b1 * b3 - b0 * b2);
+        out.r[3] = 2.f * (b2 * b1 - b0 * b3);
+        out.r[4] = b0_2 + b2_2 - b1_2 - b3_2;
+        out.r[5] = 2.f * (b0 * b1 + b3 * b2);
+        out.r[6] = 2.f * (b0 * b2 + b1 * b3);
+        out.r[7] = 2.f * (b3 * b2 - b0 * b1);
+        out.r[8] = b0_2 + b3_2 - b2_2 - b1_2;
+        out.s    = b0_2 + b1_2 + b2_2 + b3_2;
+
+        if (c == nullptr)
+        {
+            for (size_t i = 0; i != 3; ++i)
+            {
+                out.t[i] = 0.f;
+                out.q[i] = 0.f;
+            }
+            return;
+        }
+
+        float cf[4];
+        _mm_storeu_ps(cf, *c);
+        float c0 = cf[0];
+        float c1 = cf[1];
+        float c2 = cf[2];
+        float c3 = cf[3];
+
+        // Points (scaled by w)
+        // 2(b2 c3 - b0 c1 - b3 c2 - b1 c0) e032 +
+        // 2(b3 c1 - b0 c2 - b1 c3 - b2 c0) e013 +
+        // 2(b1 c2 - b0 c3 - b2 c1 - b3 c0) e021
+        out.t[0] = 2.f * (b2 * c3 - b0 * c1 - b3 * c2 - b1 * c0);
+        out.t[1] = 2.f * (b3 * c1 - b0 * c2 - b1 * c3 - b2 * c0);
+        out.t[2] = 2.f * (b1 * c2 - b0 * c3 - b2 * c1 - b3 * c0);
+
+        // Planes (contributions to e0 scaled by e1, e2, and e3)
+        // 2(b0 c1 + b2 c3 + b1 c0 - b3 c2) e1 +
+        // 2(b0 c2 + b3 c1 + b2 c0 - b1 c3) e2 +
+        // 2(b0 c3 + b1 c2 + b3 c0 - b2 c1) e3
+        out.q[0] = 2.f * (b0 * c1 + b2 * c3 + b1 * c0 - b3 * c2);
+        out.q[1] = 2.f * (b0 * c2 + b3 * c1 + b2 * c0 - b1 * c3);
+        out.q[2] = 2.f * (b0 * c3 + b1 * c2 + b3 * c0 - b2 * c1);
+    }
+
+    // Apply a motor to SoA points with streams (x, y, z, w). If Translate is
+    // false, c is ignored (rotor application). `in` and `out` may alias only
+    // if they are equal.
+    template <bool Translate>
+    KLN_INLINE void KLN_VEC_CALL sw312_soa(__m128 b,
+                                           __m128 const* c,
+                                           float const* in,
+                                           size_t in_stride,
+                                           float* out,
+                                           size_t out_stride,
+                                           size_t count) noexcept
+    {
+        soa_motor m;
+        soa_coeffs(b, Translate ? c : nullptr, m);
+
+        soa_reg r0 = soa_set1(m.r[0]);
+        soa_reg r1 = soa_set1(m.r[1]);
+        soa_reg r2 = soa_set1(m.r[2]);
+        soa_reg r3 = soa_set1(m.r[3]);
+        soa_reg r4 = soa_set1(m.r[4]);
+        soa_reg r5 = soa_set1(m.r[5]);
+        soa_reg r6 = soa_set1(m.r[6]);
+        soa_reg r7 = soa_set1(m.r[7]);
+        soa_reg r8 = soa_set1(m.r[8]);
+        soa_reg s  = soa_set1(m.s);
+        soa_reg t0 = soa_set1(m.t[0]);
+        soa_reg t1 = soa_set1(m.t[1]);
+        soa_reg t2 = soa_set1(m.t[2]);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg x  = soa_load(in + i, k);
+            soa_reg y  = soa_load(in + in_stride + i, k);
+            soa_reg z  = soa_load(in + 2 * in_stride + i, k);
+            soa_reg w  = soa_load(in + 3 * in_stride + i, k);
+
+            soa_reg xo = soa_mul(r0, x);
+            xo         = soa_add(xo, soa_mul(r1, y));
+            xo         = soa_add(xo, soa_mul(r2, z));
+
+            soa_reg yo = soa_mul(r3, x);
+            yo         = soa_add(yo, soa_mul(r4, y));
+            yo         = soa_add(yo, soa_mul(r5, z));
+
+            soa_reg zo = soa_mul(r6, x);
+            zo         = soa_add(zo, soa_mul(r7, y));
+            zo         = soa_add(zo, soa_mul(r8, z));
+
+            if (Translate)
+            {
+                xo = soa_add(xo, soa_mul(t0, w));
+                yo = soa_add(yo, soa_mul(t1, w));
+                zo = soa_add(zo, soa_mul(t2, w));
+            }
+
+            soa_store(out + i, xo, k);
+            soa_store(out + out_stride + i, yo, k);
+            soa_store(out + 2 * out_stride + i, zo, k);
+            soa_store(out + 3 * out_stride + i, soa_mul(s, w), k);
+        }
+    }
+
+    // Apply a motor to SoA planes with streams (x, y, z, d). If Translate is
+    // false, c is ignored (rotor application). `in` and `out` may alias only
+    // if they are equal.
+    template <bool Translate>
+    KLN_INLINE void KLN_VEC_CALL sw012_soa(__m128 b,
+                                           __m128 const* c,
+                                           float const* in,
+                                           size_t in_stride,
+                                           float* out,
+                                           size_t out_stride,
+                                           size_t count) noexcept
+    {
+        soa_motor m;
+        soa_coeffs(b, Translate ? c : nullptr, m);
+
+        soa_reg r0 = soa_set1(m.r[0]);
+        soa_reg r1 = soa_set1(m.r[1]);
+        soa_reg r2 = soa_set1(m.r[2]);
+        soa_reg r3 = soa_set1(m.r[3]);
+        soa_reg r4 = soa_set1(m.r[4]);
+        soa_reg r5 = soa_set1(m.r[5]);
+        soa_reg r6 = soa_set1(m.r[6]);
+        soa_reg r7 = soa_set1(m.r[7]);
+        soa_reg r8 = soa_set1(m.r[8]);
+        soa_reg s  = soa_set1(m.s);
+        soa_reg q0 = soa_set1(m.q[0]);
+        soa_reg q1 = soa_set1(m.q[1]);
+        soa_reg q2 = soa_set1(m.q[2]);
+
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg x  = soa_load(in + i, k);
+            soa_reg y  = soa_load(in + in_stride + i, k);
+            soa_reg z  = soa_load(in + 2 * in_stride + i, k);
+            soa_reg d  = soa_load(in + 3 * in_stride + i, k);
+
+            soa_reg xo = soa_mul(r0, x);
+            xo         = soa_add(xo, soa_mul(r1, y));
+            xo         = soa_add(xo, soa_mul(r2, z));
+
+            soa_reg yo = soa_mul(r3, x);
+            yo         = soa_add(yo, soa_mul(r4, y));
+            yo         = soa_add(yo, soa_mul(r5, z));
+
+            soa_reg zo = soa_mul(r6, x);
+            zo         = soa_add(zo, soa_mul(r7, y));
+            zo         = soa_add(zo, soa_mul(r8, z));
+
+            soa_reg d_out = soa_mul(s, d);
+            if (Translate)
+            {
+                d_out = soa_add(d_out, soa_mul(q0, x));
+                d_out = soa_add(d_out, soa_mul(q1, y));
+                d_out = soa_add(d_out, soa_mul(q2, z));
+            }
+
+            soa_store(out + i, xo, k);
+            soa_store(out + out_stride + i, yo, k);
+            soa_store(out + 2 * out_stride + i, zo, k);
+            soa_store(out + 3 * out_stride + i, d_out, k);
+        }
+    }
+
+    // Lane-wise analogue of soa_coeffs for the rotational block. Each lane
+    // holds the rotor part (b0, b1, b2, b3) of a different motor.
+    KLN_INLINE void KLN_VEC_CALL soa_rotation(soa_reg b0,
+                                              soa_reg b1,
+                                              soa_reg b2,
+                                              soa_reg b3,
+                                              soa_reg* r,
+                                              soa_reg& s) noexcept
+    {
+        soa_reg two  = soa_set1(2.f);
+        soa_reg b0_2 = soa_mul(b0, b0);
+        soa_reg b1_2 = soa_mul(b1, b1);
+        soa_reg b2_2 = soa_mul(b2, b2);
+        soa_reg b3_2 = soa_mul(b3, b3);
+
+        r[0] = soa_sub(soa_add(b0_2, b1_2), soa_add(b3_2, b2_2));
+        r[1] = soa_mul(two, soa_add(soa_mul(b0, b3), soa_mul(b2, b1)));
+        r[2] = soa_mul(two, soa_sub(soa_mul(b1, b3), soa_mul(b0, b2)));
+        r[3] = soa_mul(two, soa_sub(soa_mul(b2, b1), soa_mul(b0, b3)));
+        r[4] = soa_sub(soa_add(b0_2, b2_2), soa_add(b1_2, b3_2));
+        r[5] = soa_mul(two, soa_add(soa_mul(b0, b1), soa_mul(b3, b2)));
+        r[6] = soa_mul(two, soa_add(soa_mul(b0, b2), soa_mul(b1, b3)));
+        r[7] = soa_mul(two, soa_sub(soa_mul(b3, b2), soa_mul(b0, b1)));
+        r[8] = soa_sub(soa_add(b0_2, b3_2), soa_add(b2_2, b1_2));
+        s    = soa_add(soa_add(b0_2, b1_2), soa_add(b2_2, b3_2));
+    }
+
+    // Lane-wise analogue of the point translation coefficients of soa_coeffs
+    // for the motors with partitions (b0, b1, b2, b3) and (c0, c1, c2, c3).
+    KLN_INLINE void KLN_VEC_CALL soa_translation(soa_reg b0,
+                                                 soa_reg b1,
+                                                 soa_reg b2,
+                                                 soa_reg b3,
+                                                 soa_reg c0,
+                                                 soa_reg c1,
+                                                 soa_reg c2,
+                                                 soa_reg c3,
+                                                 soa_reg* t) noexcept
+    {
+        soa_reg two = soa_set1(2.f);
+
+        // 2(b2 c3 - b0 c1 - b3 c2 - b1 c0) e032
+        t[0] = soa_mul(b2, c3);
+        t[0] = soa_sub(t[0], soa_mul(b0, c1));
+        t[0] = soa_sub(t[0], soa_mul(b3, c2));
+        t[0] = soa_mul(two, soa_sub(t[0], soa_mul(b1, c0)));
+
+        // 2(b3 c1 - b0 c2 - b1 c3 - b2 c0) e013
+        t[1] = soa_mul(b3, c1);
+        t[1] = soa_sub(t[1], soa_mul(b0, c2));
+        t[1] = soa_sub(t[1], soa_mul(b1, c3));
+        t[1] = soa_mul(two, soa_sub(t[1], soa_mul(b2, c0)));
+
+        // 2(b1 c2 - b0 c3 - b2 c1 - b3 c0) e021
+        t[2] = soa_mul(b1, c2);
+        t[2] = soa_sub(t[2], soa_mul(b0, c3));
+        t[2] = soa_sub(t[2], soa_mul(b2, c1));
+        t[2] = soa_mul(two, soa_sub(t[2], soa_mul(b3, c0)));
+    }
+
+    // Compose two SoA motor batches lane by lane (out[i] = a[i] * b[i]). Any
+    // of the three buffers may alias one another.
+    KLN_INLINE void KLN_VEC_CALL gpMM_soa(float const* a,
+                                          size_t a_stride,
+                                          float const* b,
+                                          size_t b_stride,
+                                          float* out,
+                                          size_t out_stride,
+                                          size_t count) noexcept
+    {
+        // See gpMM for the expansion. Here, (a, b) denote the (p1, p2)
+        // partitions of the first motor and (c, d) the partitions of the
+        // second.
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg a1 = soa_load(a + i, k);
+            soa_reg a2 = soa_load(a + a_stride + i, k);
+            soa_reg a3 = soa_load(a + 2 * a_stride + i, k);
+            soa_reg a0 = soa_load(a + 3 * a_stride + i, k);
+            soa_reg b1 = soa_load(a + 4 * a_stride + i, k);
+            soa_reg b2 = soa_load(a + 5 * a_stride + i, k);
+            soa_reg b3 = soa_load(a + 6 * a_stride + i, k);
+            soa_reg b0 = soa_load(a + 7 * a_stride + i, k);
+            soa_reg c1 = soa_load(b + i, k);
+            soa_reg c2 = soa_load(b + b_stride + i, k);
+            soa_reg c3 = soa_load(b + 2 * b_stride + i, k);
+            soa_reg c0 = soa_load(b + 3 * b_stride + i, k);
+            soa_reg d1 = soa_load(b + 4 * b_stride + i, k);
+            soa_reg d2 = soa_load(b + 5 * b_stride + i, k);
+            soa_reg d3 = soa_load(b + 6 * b_stride + i, k);
+            soa_reg d0 = soa_load(b + 7 * b_stride + i, k);
+
+            // (a0 c0 - a1 c1 - a2 c2 - a3 c3)
+            soa_reg e0 = soa_mul(a0, c0);
+            e0         = soa_sub(e0, soa_mul(a1, c1));
+            e0         = soa_sub(e0, soa_mul(a2, c2));
+            e0         = soa_sub(e0, soa_mul(a3, c3));
+
+            // (a0 c1 + a3 c2 + a1 c0 - a2 c3) e23
+            soa_reg e1 = soa_mul(a0, c1);
+            e1         = soa_add(e1, soa_mul(a3, c2));
+            e1         = soa_add(e1, soa_mul(a1, c0));
+            e1         = soa_sub(e1, soa_mul(a2, c3));
+
+            // (a0 c2 + a1 c3 + a2 c0 - a3 c1) e31
+            soa_reg e2 = soa_mul(a0, c2);
+            e2         = soa_add(e2, soa_mul(a1, c3));
+            e2         = soa_add(e2, soa_mul(a2, c0));
+            e2         = soa_sub(e2, soa_mul(a3, c1));
+
+            // (a0 c3 + a2 c1 + a3 c0 - a1 c2) e12
+            soa_reg e3 = soa_mul(a0, c3);
+            e3         = soa_add(e3, soa_mul(a2, c1));
+            e3         = soa_add(e3, soa_mul(a3, c0));
+            e3         = soa_sub(e3, soa_mul(a1, c2));
+
+            // (a0 d0 + b0 c0 + a1 d1 + b1 c1 + a2 d2 + a3 d3 + b2 c2 + b3 c3)
+            //  e0123
+            soa_reg f0 = soa_mul(a0, d0);
+            f0         = soa_add(f0, soa_mul(b0, c0));
+            f0         = soa_add(f0, soa_mul(a1, d1));
+            f0         = soa_add(f0, soa_mul(b1, c1));
+            f0         = soa_add(f0, soa_mul(a2, d2));
+            f0         = soa_add(f0, soa_mul(a3, d3));
+            f0         = soa_add(f0, soa_mul(b2, c2));
+            f0         = soa_add(f0, soa_mul(b3, c3));
+
+            // (a0 d1 + b1 c0 + a3 d2 + b3 c2 - a1 d0 - a2 d3 - b0 c1 - b2 c3)
+            //  e01
+            soa_reg f1 = soa_mul(a0, d1);
+            f1         = soa_add(f1, soa_mul(b1, c0));
+            f1         = soa_add(f1, soa_mul(a3, d2));
+            f1         = soa_add(f1, soa_mul(b3, c2));
+            f1         = soa_sub(f1, soa_mul(a1, d0));
+            f1         = soa_sub(f1, soa_mul(a2, d3));
+            f1         = soa_sub(f1, soa_mul(b0, c1));
+            f1         = soa_sub(f1, soa_mul(b2, c3));
+
+            // (a0 d2 + b2 c0 + a1 d3 + b1 c3 - a2 d0 - a3 d1 - b0 c2 - b3 c1)
+            //  e02
+            soa_reg f2 = soa_mul(a0, d2);
+            f2         = soa_add(f2, soa_mul(b2, c0));
+            f2         = soa_add(f2, soa_mul(a1, d3));
+            f2         = soa_add(f2, soa_mul(b1, c3));
+            f2         = soa_sub(f2, soa_mul(a2, d0));
+            f2         = soa_sub(f2, soa_mul(a3, d1));
+            f2         = soa_sub(f2, soa_mul(b0, c2));
+            f2         = soa_sub(f2, soa_mul(b3, c1));
+
+            // (a0 d3 + b3 c0 + a2 d1 + b2 c1 - a3 d0 - a1 d2 - b0 c3 - b1 c2)
+            //  e03
+            soa_reg f3 = soa_mul(a0, d3);
+            f3         = soa_add(f3, soa_mul(b3, c0));
+            f3         = soa_add(f3, soa_mul(a2, d1));
+            f3         = soa_add(f3, soa_mul(b2, c1));
+            f3         = soa_sub(f3, soa_mul(a3, d0));
+            f3         = soa_sub(f3, soa_mul(a1, d2));
+            f3         = soa_sub(f3, soa_mul(b0, c3));
+            f3         = soa_sub(f3, soa_mul(b1, c2));
+
+            soa_store(out + i, e1, k);
+            soa_store(out + out_stride + i, e2, k);
+            soa_store(out + 2 * out_stride + i, e3, k);
+            soa_store(out + 3 * out_stride + i, e0, k);
+            soa_store(out + 4 * out_stride + i, f1, k);
+            soa_store(out + 5 * out_stride + i, f2, k);
+            soa_store(out + 6 * out_stride + i, f3, k);
+            soa_store(out + 7 * out_stride + i, f0, k);
+        }
+    }
+
+    // Conjugate SoA points with streams (x, y, z, w) by SoA motors lane by
+    // lane. `in` and `out` may alias only if they are equal.
+    KLN_INLINE void KLN_VEC_CALL sw312_soa_motors(float const* m,
+                                                  size_t m_stride,
+                                                  float const* in,
+                                                  size_t in_stride,
+                                                  float* out,
+                                                  size_t out_stride,
+                                                  size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg b1 = soa_load(m + i, k);
+            soa_reg b2 = soa_load(m + m_stride + i, k);
+            soa_reg b3 = soa_load(m + 2 * m_stride + i, k);
+            soa_reg b0 = soa_load(m + 3 * m_stride + i, k);
+            soa_reg c1 = soa_load(m + 4 * m_stride + i, k);
+            soa_reg c2 = soa_load(m + 5 * m_stride + i, k);
+            soa_reg c3 = soa_load(m + 6 * m_stride + i, k);
+            soa_reg c0 = soa_load(m + 7 * m_stride + i, k);
+
+            soa_reg r[9];
+            soa_reg s;
+            soa_rotation(b0, b1, b2, b3, r, s);
+
+            soa_reg t[3];
+            soa_translation(b0, b1, b2, b3, c0, c1, c2, c3, t);
+
+            soa_reg x = soa_load(in + i, k);
+            soa_reg y = soa_load(in + in_stride + i, k);
+            soa_reg z = soa_load(in + 2 * in_stride + i, k);
+            soa_reg w = soa_load(in + 3 * in_stride + i, k);
+
+            soa_reg xo = soa_mul(r[0], x);
+            xo         = soa_add(xo, soa_mul(r[1], y));
+            xo         = soa_add(xo, soa_mul(r[2], z));
+            xo         = soa_add(xo, soa_mul(t[0], w));
+
+            soa_reg yo = soa_mul(r[3], x);
+            yo         = soa_add(yo, soa_mul(r[4], y));
+            yo         = soa_add(yo, soa_mul(r[5], z));
+            yo         = soa_add(yo, soa_mul(t[1], w));
+
+            soa_reg zo = soa_mul(r[6], x);
+            zo         = soa_add(zo, soa_mul(r[7], y));
+            zo         = soa_add(zo, soa_mul(r[8], z));
+            zo         = soa_add(zo, soa_mul(t[2], w));
+
+            soa_store(out + i, xo, k);
+            soa_store(out + out_stride + i, yo, k);
+            soa_store(out + 2 * out_stride + i, zo, k);
+            soa_store(out + 3 * out_stride + i, soa_mul(s, w), k);
+        }
+    }
+
+    // Conjugate SoA planes with streams (x, y, z, d) by SoA motors lane by
+    // lane. `in` and `out` may alias only if they are equal.
+    KLN_INLINE void KLN_VEC_CALL sw012_soa_motors(float const* m,
+                                                  size_t m_stride,
+                                                  float const* in,
+                                                  size_t in_stride,
+                                                  float* out,
+                                                  size_t out_stride,
+                                                  size_t count) noexcept
+    {
+        soa_reg two = soa_set1(2.f);
+        for (size_t i = 0; i < count; i += soa_width)
+        {
+            soa_mask k = soa_tail(count - i);
+            soa_reg b1 = soa_load(m + i, k);
+            soa_reg b2 = soa_load(m + m_stride + i, k);
+            soa_reg b3 = soa_load(m + 2 * m_stride + i, k);
+            soa_reg b0 = soa_load(m + 3 * m_stride + i, k);
+            soa_reg c1 = soa_load(m + 4 * m_stride + i, k);
+            soa_reg c2 = soa_load(m + 5 * m_stride + i, k);
+            soa_reg c3 = soa_load(m + 6 * m_stride + i, k);
+            soa_reg c0 = soa_load(m + 7 * m_stride + i, k);
+
+            soa_reg r[9];
+            soa_reg s;
+            soa_rotation(b0, b1, b2, b3, r, s);
+
+            // 2(b0 c1 + b2 c3 + b1 c0 - b3 c2) e1
+            soa_reg q0 = soa_mul(b0, c1);
+            q0         = soa_add(q0, soa_mul(b2, c3));
+            q0         = soa_add(q0, soa_mul(b1, c0));
+            q0         = soa_mul(two, soa_sub(q0, soa_mul(b3, c2)));
+
+            // 2(b0 c2 + b3 c1 + b2 c0 - b1 c3) e2
+            soa_reg q1 = soa_mul(b0, c2);
+            q1         = soa_add(q1, soa_mul(b3, c1));
+            q1         = soa_add(q1, soa_mul(b2, c0));
+            q1         = soa_mul(two, soa_sub(q1, soa_mul(b1, c3)));
+
+            // 2(b0 c3 + b1 c2 + b3 c0 - b2 c1) e3
+            soa_reg q2 = soa_mul(b0, c3);
+            q2         = soa_add(q2, soa_mul(b1, c2));
+            q2         = soa_add(q2, soa_mul(b3, c0));
+            q2         = soa_mul(two, soa_sub(q2, soa_mul(b2, c1)));
+
+            soa_reg x = soa_load(in + i, k);
+            soa_reg y = soa_load(in + in_stride + i, k);
+            soa_reg z = soa_load(in + 2 * in_stride + i, k);
+            soa_reg d = soa_load(in + 3 * in_stride + i, k);
+
+            soa_reg xo = soa_mul(r[0], x);
+            xo         = soa_add(xo, soa_mul(r[1], y));
+            xo         = soa_add(xo, soa_mul(r[2], z));
+
+            soa_reg yo = soa_mul(r[3], x);
+            yo         = soa_add(yo, soa_mul(r[4], y));
+            yo         = soa_add(yo, soa_mul(r[5], z));
+
+            soa_reg zo = soa_mul(r[6], x);
+            zo         = soa_add(zo, soa_mul(r[7], y));
+            zo         = soa_add(zo, soa_mul(r[8], z));
+
+            soa_reg d_out = soa_mul(s, d);
+            d_out         = soa_add(d_out, soa_mul(q0, x));
+            d_out         = soa_add(d_out, soa_mul(q1, y));
+            d_out         = soa_add(d_out, soa_mul(q2, z));
+
+            soa_store(out + i, xo, k);
+            soa_store(out + out_stride + i, yo, k);
+            soa_store(out + 2 * out_stride + i, zo, k);
+            soa_store(out + 3 * out_stride + i, d_out, k);
+        }
+    }
+} // namespace detail
+} // namespace kln
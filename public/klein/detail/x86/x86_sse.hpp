@@ -3,7 +3,35 @@
 // intrinsics
 #pragma once
 
-#ifdef KLEIN_SSE_4_1
+// AVX-512F implies AVX2, which is a strict superset of SSE4.1
+#if defined(KLEIN_AVX512) && !defined(KLEIN_AVX2)
+#    define KLEIN_AVX2
+#endif
+
+// FMA3 shipped alongside AVX2 but is usable independently of it
+#if (defined(KLEIN_AVX2) || defined(KLEIN_FMA)) && !defined(KLEIN_SSE_4_1)
+#    define KLEIN_SSE_4_1
+#endif
+
+#ifdef KLEIN_AVX512
+#    ifdef KLEIN_USE_SIMDE
+#        include <x86/avx512.h>
+#    else
+#        include <immintrin.h>
+#    endif
+#elif defined(KLEIN_AVX2)
+#    ifdef KLEIN_USE_SIMDE
+#        include <x86/avx2.h>
+#    else
+#        include <immintrin.h>
+#    endif
+#elif defined(KLEIN_FMA)
+#    ifdef KLEIN_USE_SIMDE
+#        include <x86/fma.h>
+#    else
+#        include <immintrin.h>
+#    endif
+#elif defined(KLEIN_SSE_4_1)
 #    ifdef KLEIN_USE_SIMDE
 #        include <x86/sse4.1.h>
 #    else
@@ -54,6 +82,29 @@ namespace kln
 {
 namespace detail
 {
+    // a * b + c
+    //
+    // With KLEIN_FMA, the product is not rounded before the addition.
+    // Otherwise, this is equivalent to _mm_add_ps(c, _mm_mul_ps(a, b)).
+    KLN_INLINE __m128 KLN_VEC_CALL fmadd(__m128 a, __m128 b, __m128 c) noexcept
+    {
+#ifdef KLEIN_FMA
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(c, _mm_mul_ps(a, b));
+#endif
+    }
+
+    // c - a * b
+    KLN_INLINE __m128 KLN_VEC_CALL fnmadd(__m128 a, __m128 b, __m128 c) noexcept
+    {
+#ifdef KLEIN_FMA
+        return _mm_fnmadd_ps(a, b, c);
+#else
+        return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+    }
+
     // DP high components and caller ignores returned high components
     KLN_INLINE __m128 KLN_VEC_CALL hi_dp_ss(__m128 a, __m128 b) noexcept
     {
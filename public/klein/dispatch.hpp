@@ -0,0 +1,108 @@
+// File: dispatch.hpp
+// Purpose: Declare the batched operations provided by the compiled
+// `klein_dispatch` library. Unlike the rest of Klein, these routines are not
+// header-only. The library contains a copy of each kernel for every supported
+// instruction set tier and selects the best one supported by the host CPU the
+// first time a routine is invoked.
+
+#pragma once
+
+#include "line.hpp"
+#include "motor.hpp"
+#include "motor_soa.hpp"
+#include "point.hpp"
+#include "soa.hpp"
+
+#include <cstddef>
+
+namespace kln
+{
+namespace dispatch
+{
+/// \defgroup dispatch Runtime Dispatch
+///
+/// The instruction set used by the header-only library is fixed at compile
+/// time by choosing one of the `klein`, `klein_sse42`, `klein_avx2`, or
+/// `klein_avx512` targets. A binary shipped to many machines must therefore
+/// target the lowest common denominator. The optional `klein_dispatch`
+/// library (enabled with the `KLEIN_BUILD_DISPATCH` CMake option) instead
+/// compiles the batched operations below once per instruction set tier and
+/// picks the fastest tier supported by the host via `cpuid`.
+///
+/// !!! example
+///
+///     ```c++
+///         #include <klein/dispatch.hpp>
+///
+///         // Uses AVX-512, AVX2, SSE4.1, or SSE3 kernels as available
+///         kln::dispatch::apply(m, in.data(), out.data(), in.size());
+///
+///         // Query the tier in use
+///         kln::dispatch::isa tier = kln::dispatch::active_isa();
+///         std::printf("%s\n", kln::dispatch::isa_name(tier));
+///     ```
+///
+/// !!! tip
+///
+///     Each call incurs an indirect function call, so the routines here are
+///     only worthwhile for batches. For single entities, use the header-only
+///     operators directly.
+
+/// \addtogroup dispatch
+/// @{
+
+/// Instruction set tiers, ordered from least to most capable.
+enum class isa
+{
+    sse3,
+    sse4_1,
+    avx2,
+    avx512
+};
+
+/// Human readable name of an instruction set tier.
+[[nodiscard]] char const* isa_name(isa tier) noexcept;
+
+/// The most capable tier supported by the host CPU and operating system.
+[[nodiscard]] isa best_isa() noexcept;
+
+/// The tier currently used by the routines in this group. Unless overridden
+/// with `select_isa`, this is `best_isa()`.
+[[nodiscard]] isa active_isa() noexcept;
+
+/// Override the tier used by the routines in this group, for example to
+/// compare the output of different tiers. Returns false and leaves the active
+/// tier unchanged if the requested tier is not supported by the host.
+bool select_isa(isa tier) noexcept;
+
+/// Conjugates `count` points with the motor `m`. Aliasing is only permitted
+/// when `in == out`.
+void apply(motor const& m, point const* in, point* out, size_t count) noexcept;
+
+/// Conjugates a batch of points with the motor `m`. `out` is resized to
+/// match `in`, and aliasing is only permitted when `&in == &out`.
+void apply(motor const& m, point_soa const& in, point_soa& out);
+
+/// Conjugates the i-th point of `in` with the i-th motor of `m`. `out` is
+/// resized to match `m`, and aliasing is only permitted when `&in == &out`.
+void apply(motor_soa const& m, point_soa const& in, point_soa& out);
+
+/// Composes `count` pairs of motors such that `out[i] = a[i] * b[i]`. Any
+/// of the three arrays may alias one another.
+void compose(motor const* a,
+             motor const* b,
+             motor* out,
+             size_t count) noexcept;
+
+/// Composes two motor batches element by element (see `kln::compose`).
+void compose(motor_soa const& a, motor_soa const& b, motor_soa& out);
+
+/// Exponentiates `count` lines. Equivalent to `out[i] = kln::exp(in[i])`.
+void exp(line const* in, motor* out, size_t count) noexcept;
+
+/// Takes the logarithm of `count` motors. Equivalent to
+/// `out[i] = kln::log(in[i])`.
+void log(motor const* in, line* out, size_t count) noexcept;
+/// @}
+} // namespace dispatch
+} // namespace kln
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "detail/distance.hpp"
+#include "line.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+#include "soa.hpp"
+
+namespace kln
+{
+/// \defgroup distance Distances
+///
+/// The distance from a normalized point $P$ to a plane $p$ is the inner
+/// product $P \cdot p$ divided by the norm of the plane, and is positive on
+/// the side of the plane its normal points to. The distance from $P$ to a
+/// line $\ell$ is the norm of the join $P \vee \ell$ divided by the norm of
+/// the line (see `plane::norm`), and is always nonnegative.
+///
+/// The routines here evaluate these quantities for whole batches of points,
+/// either tightly packed or stored as a `point_soa`, and write one `float`
+/// per point. Planes and lines need not be normalized. Quantities that
+/// depend only on a shared plane or line are computed once per batch, and the
+/// join with a line is never formed.
+///
+/// !!! example
+///
+///     ```c++
+///         // Height of every foot above the ground
+///         std::vector<float> heights(feet.size());
+///         kln::signed_distance(
+///             feet.data(), ground, heights.data(), feet.size());
+///
+///         // Distances of SoA agents to a navmesh edge. The output holds
+///         // agents.stride() floats.
+///         std::vector<float> offsets(agents.stride());
+///         kln::distance(agents, edge, offsets.data());
+///     ```
+///
+/// !!! tip
+///
+///     The SoA overloads write whole registers, so their output must hold
+///     `stride()` floats rather than `size()` floats.
+
+/// \addtogroup distance
+/// @{
+
+/// Signed distance from the normalized point `a` to the plane `b`
+[[nodiscard]] inline float KLN_VEC_CALL signed_distance(point a,
+                                                        plane b) noexcept
+{
+    float out;
+    detail::dist30(&a.p3_, &b.p0_, &out, 1);
+    return out;
+}
+
+/// Write the signed distance from each of the `count` normalized points to
+/// the plane `b` to `out`.
+inline void signed_distance(point const* in,
+                            plane b,
+                            float* out,
+                            size_t count) noexcept
+{
+    detail::dist30(&in->p3_, b.p0_, out, count);
+}
+
+/// Write the signed distance from each of the `count` normalized points to
+/// the plane with the same index such that
+/// `out[i] = signed_distance(in[i], planes[i])`.
+inline void signed_distance(point const* in,
+                            plane const* planes,
+                            float* out,
+                            size_t count) noexcept
+{
+    detail::dist30(&in->p3_, &planes->p0_, out, count);
+}
+
+/// Write the signed distance from each normalized point of `in` to the plane
+/// `b` to `out`, which must hold at least `in.stride()` floats.
+inline void signed_distance(point_soa const& in, plane b, float* out) noexcept
+{
+    detail::dist30_soa<false>(
+        in.data(), in.stride(), b.p0_, nullptr, 0, out, in.size());
+}
+
+/// Write the signed distance from the i-th normalized point of `in` to the
+/// i-th plane of `planes` to `out`, which must hold at least `in.stride()`
+/// floats. `planes` must contain at least `in.size()` planes.
+inline void signed_distance(point_soa const& in,
+                            plane_soa const& planes,
+                            float* out) noexcept
+{
+    detail::dist30_soa<true>(in.data(),
+                             in.stride(),
+                             _mm_set1_ps(1.f),
+                             planes.data(),
+                             planes.stride(),
+                             out,
+                             in.size());
+}
+
+/// Distance from the normalized point `a` to the line `b`
+[[nodiscard]] inline float KLN_VEC_CALL distance(point a, line b) noexcept
+{
+    float out;
+    detail::dist312(&a.p3_, b.p1_, b.p2_, &out, 1);
+    return out;
+}
+
+/// Write the distance from each of the `count` normalized points to the line
+/// `b` to `out`.
+inline void distance(point const* in, line b, float* out, size_t count) noexcept
+{
+    detail::dist312(&in->p3_, b.p1_, b.p2_, out, count);
+}
+
+/// Write the distance from each normalized point of `in` to the line `b` to
+/// `out`, which must hold at least `in.stride()` floats.
+inline void distance(point_soa const& in, line b, float* out) noexcept
+{
+    detail::dist312_soa(in.data(), in.stride(), b.p1_, b.p2_, out, in.size());
+}
+/// @}
+} // namespace kln
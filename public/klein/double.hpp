@@ -0,0 +1,876 @@
+// File: double.hpp
+// Include this header to gain access to the double precision entities in the
+// kln::d namespace. This header is not included by klein.hpp.
+
+#pragma once
+
+#include "detail/f64.hpp"
+#include "line.hpp"
+#include "motor.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+#include "rotor.hpp"
+#include "translator.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+namespace kln
+{
+/// \defgroup double Double Precision
+///
+/// Single precision floats run out of precision quickly far from the origin.
+/// At a distance of 100km, adjacent floats are roughly 8mm apart, which is
+/// insufficient for large worlds, orbital mechanics, or CAD. The `kln::d`
+/// namespace provides double precision counterparts of `point`, `plane`,
+/// `line`, `rotor`, `translator`, and `motor`. Their storage and the kernels
+/// operating on them mirror the single precision versions lane for lane. When
+/// compiled with `KLEIN_AVX2`, each partition is a single `__m256d` register.
+/// Otherwise, each partition is a pair of SSE2 `__m128d` registers.
+///
+/// Unlike their single precision counterparts, normalization and division
+/// here are exact rather than Newton-Raphson refined estimates.
+///
+/// !!! example
+///
+///     ```c++
+///         #include <klein/double.hpp>
+///
+///         kln::d::translator t{1e7, 1.0, 0.0, 0.0};
+///         kln::d::rotor r{1.5707963267948966, 0.0, 0.0, 1.0};
+///         kln::d::motor m = t * r;
+///
+///         kln::d::point p{1e7, 0.25, 0.0};
+///         kln::d::point q = m(p);
+///
+///         // Re-center on the camera before narrowing for rendering
+///         kln::d::translator to_camera{-1e7, 1.0, 0.0, 0.0};
+///         kln::point local = to_camera(q).to_float();
+///     ```
+///
+/// !!! danger
+///
+///     With `KLEIN_AVX2`, the entities here require 32-byte alignment. Prior
+///     to C++17, standard allocators do not honor this, so heap-allocated
+///     arrays of these entities must be allocated with an aligned allocator.
+
+namespace d
+{
+/// \addtogroup double
+/// @{
+
+/// Double precision counterpart of `kln::plane`.
+class plane final
+{
+public:
+    plane() noexcept = default;
+
+    plane(detail::f64x4 p0) noexcept
+        : p0_{p0}
+    {}
+
+    /// The plane $ax + by + cz + d = 0$.
+    plane(double a, double b, double c, double d) noexcept
+        : p0_{detail::f64_set(c, b, a, d)}
+    {}
+
+    /// Widen a single precision plane.
+    explicit plane(kln::plane const& p) noexcept
+        : plane{p.x(), p.y(), p.z(), p.d()}
+    {}
+
+    /// Unaligned load of 4 doubles with layout `(d, a, b, c)`.
+    void load(double const* data) noexcept
+    {
+        p0_ = detail::f64_loadu(data);
+    }
+
+    /// Unaligned store of 4 doubles with layout `(d, a, b, c)`.
+    void store(double* data) const noexcept
+    {
+        detail::f64_storeu(data, p0_);
+    }
+
+    /// Normalize this plane $p$ such that $p \cdot p = 1$.
+    void normalize() noexcept
+    {
+        double inv_norm
+            = 1.0 / std::sqrt(detail::f64_lane0(detail::f64_hi_dp(p0_, p0_)));
+        p0_ = detail::f64_mul(p0_, detail::f64_set1(inv_norm));
+    }
+
+    /// Return a normalized copy of this plane.
+    [[nodiscard]] plane normalized() const noexcept
+    {
+        plane out = *this;
+        out.normalize();
+        return out;
+    }
+
+    /// Narrow to a single precision plane.
+    [[nodiscard]] kln::plane to_float() const noexcept
+    {
+        double p[4];
+        store(p);
+        return {static_cast<float>(p[1]),
+                static_cast<float>(p[2]),
+                static_cast<float>(p[3]),
+                static_cast<float>(p[0])};
+    }
+
+    [[nodiscard]] double x() const noexcept
+    {
+        return lane(1);
+    }
+
+    [[nodiscard]] double e1() const noexcept
+    {
+        return x();
+    }
+
+    [[nodiscard]] double y() const noexcept
+    {
+        return lane(2);
+    }
+
+    [[nodiscard]] double e2() const noexcept
+    {
+        return y();
+    }
+
+    [[nodiscard]] double z() const noexcept
+    {
+        return lane(3);
+    }
+
+    [[nodiscard]] double e3() const noexcept
+    {
+        return z();
+    }
+
+    [[nodiscard]] double d() const noexcept
+    {
+        return detail::f64_lane0(p0_);
+    }
+
+    [[nodiscard]] double e0() const noexcept
+    {
+        return d();
+    }
+
+    /// Plane coefficients `(e0, e1, e2, e3)`
+    detail::f64x4 p0_;
+
+private:
+    double lane(size_t i) const noexcept
+    {
+        double p[4];
+        store(p);
+        return p[i];
+    }
+};
+
+/// Double precision counterpart of `kln::point`.
+class point final
+{
+public:
+    point() noexcept = default;
+
+    point(detail::f64x4 p3) noexcept
+        : p3_{p3}
+    {}
+
+    /// Component-wise constructor (homogeneous coordinate is automatically
+    /// initialized to 1)
+    point(double x, double y, double z) noexcept
+        : p3_{detail::f64_set(z, y, x, 1.0)}
+    {}
+
+    /// Widen a single precision point.
+    explicit point(kln::point const& p) noexcept
+        : p3_{detail::f64_set(p.z(), p.y(), p.x(), p.w())}
+    {}
+
+    /// Unaligned load of 4 doubles with layout `(w, x, y, z)`.
+    void load(double const* data) noexcept
+    {
+        p3_ = detail::f64_loadu(data);
+    }
+
+    /// Unaligned store of 4 doubles with layout `(w, x, y, z)`.
+    void store(double* data) const noexcept
+    {
+        detail::f64_storeu(data, p3_);
+    }
+
+    /// Normalize this point such that $w = 1$.
+    void normalize() noexcept
+    {
+        p3_ = detail::f64_mul(p3_, detail::f64_set1(1.0 / w()));
+    }
+
+    /// Return a normalized copy of this point.
+    [[nodiscard]] point normalized() const noexcept
+    {
+        point out = *this;
+        out.normalize();
+        return out;
+    }
+
+    /// Narrow to a single precision point. The homogeneous coordinate is
+    /// preserved.
+    [[nodiscard]] kln::point to_float() const noexcept
+    {
+        double p[4];
+        store(p);
+        return {_mm_set_ps(static_cast<float>(p[3]),
+                           static_cast<float>(p[2]),
+                           static_cast<float>(p[1]),
+                           static_cast<float>(p[0]))};
+    }
+
+    [[nodiscard]] double x() const noexcept
+    {
+        return lane(1);
+    }
+
+    [[nodiscard]] double e032() const noexcept
+    {
+        return x();
+    }
+
+    [[nodiscard]] double y() const noexcept
+    {
+        return lane(2);
+    }
+
+    [[nodiscard]] double e013() const noexcept
+    {
+        return y();
+    }
+
+    [[nodiscard]] double z() const noexcept
+    {
+        return lane(3);
+    }
+
+    [[nodiscard]] double e021() const noexcept
+    {
+        return z();
+    }
+
+    /// The homogeneous coordinate `w` is exactly $1$ when normalized.
+    [[nodiscard]] double w() const noexcept
+    {
+        return detail::f64_lane0(p3_);
+    }
+
+    [[nodiscard]] double e123() const noexcept
+    {
+        return w();
+    }
+
+    /// Point coefficients `(e123, e032, e013, e021)`
+    detail::f64x4 p3_;
+
+private:
+    double lane(size_t i) const noexcept
+    {
+        double p[4];
+        store(p);
+        return p[i];
+    }
+};
+
+/// Double precision counterpart of `kln::line`.
+class line final
+{
+public:
+    line() noexcept = default;
+
+    /// The line
+    /// $a\mathbf{e}_{01} + b\mathbf{e}_{02} + c\mathbf{e}_{03} +\
+    /// d\mathbf{e}_{23} + e\mathbf{e}_{31} + f\mathbf{e}_{12}$.
+    line(double a, double b, double c, double d, double e, double f) noexcept
+        : p1_{detail::f64_set(f, e, d, 0.0)}
+        , p2_{detail::f64_set(c, b, a, 0.0)}
+    {}
+
+    line(detail::f64x4 p1, detail::f64x4 p2) noexcept
+        : p1_{p1}
+        , p2_{p2}
+    {}
+
+    /// Widen a single precision line.
+    explicit line(kln::line const& l) noexcept
+        : line{l.e01(), l.e02(), l.e03(), l.e23(), l.e31(), l.e12()}
+    {}
+
+    /// Narrow to a single precision line.
+    [[nodiscard]] kln::line to_float() const noexcept
+    {
+        return {static_cast<float>(e01()),
+                static_cast<float>(e02()),
+                static_cast<float>(e03()),
+                static_cast<float>(e23()),
+                static_cast<float>(e31()),
+                static_cast<float>(e12())};
+    }
+
+    [[nodiscard]] double e12() const noexcept
+    {
+        return lane(p1_, 3);
+    }
+
+    [[nodiscard]] double e31() const noexcept
+    {
+        return lane(p1_, 2);
+    }
+
+    [[nodiscard]] double e23() const noexcept
+    {
+        return lane(p1_, 1);
+    }
+
+    [[nodiscard]] double e01() const noexcept
+    {
+        return lane(p2_, 1);
+    }
+
+    [[nodiscard]] double e02() const noexcept
+    {
+        return lane(p2_, 2);
+    }
+
+    [[nodiscard]] double e03() const noexcept
+    {
+        return lane(p2_, 3);
+    }
+
+    /// Direction components `(_, e23, e31, e12)`
+    detail::f64x4 p1_;
+    /// Moment components `(_, e01, e02, e03)`
+    detail::f64x4 p2_;
+
+private:
+    static double lane(detail::f64x4 p, size_t i) noexcept
+    {
+        double out[4];
+        detail::f64_storeu(out, p);
+        return out[i];
+    }
+};
+
+/// Double precision counterpart of `kln::rotor`.
+class rotor final
+{
+public:
+    rotor() noexcept = default;
+
+    /// Rotation of `ang_rad` radians about the axis `(x, y, z)` through the
+    /// origin. The axis need not be normalized.
+    rotor(double ang_rad, double x, double y, double z) noexcept
+    {
+        double inv_norm = 1.0 / std::sqrt(x * x + y * y + z * z);
+        double half     = 0.5 * ang_rad;
+        double scale    = std::sin(half) * inv_norm;
+        p1_             = detail::f64_set(z, y, x, std::cos(half));
+        p1_ = detail::f64_mul(p1_, detail::f64_set(scale, scale, scale, 1.0));
+    }
+
+    rotor(detail::f64x4 p1) noexcept
+        : p1_{p1}
+    {}
+
+    /// Widen a single precision rotor.
+    explicit rotor(kln::rotor const& r) noexcept
+        : p1_{detail::f64_set(r.e12(), r.e31(), r.e23(), r.scalar())}
+    {}
+
+    /// Normalize a rotor such that $\mathbf{r}\widetilde{\mathbf{r}} = 1$.
+    void normalize() noexcept
+    {
+        double inv_norm
+            = 1.0 / std::sqrt(detail::f64_lane0(detail::f64_dp_bc(p1_, p1_)));
+        p1_ = detail::f64_mul(p1_, detail::f64_set1(inv_norm));
+    }
+
+    /// Return a normalized copy of this rotor.
+    [[nodiscard]] rotor normalized() const noexcept
+    {
+        rotor out = *this;
+        out.normalize();
+        return out;
+    }
+
+    /// Narrow to a single precision rotor.
+    [[nodiscard]] kln::rotor to_float() const noexcept
+    {
+        double p[4];
+        detail::f64_storeu(p, p1_);
+        return {_mm_set_ps(static_cast<float>(p[3]),
+                           static_cast<float>(p[2]),
+                           static_cast<float>(p[1]),
+                           static_cast<float>(p[0]))};
+    }
+
+    /// Conjugates a plane $p$ with this rotor and returns the result
+    /// $rp\widetilde{r}$.
+    [[nodiscard]] plane operator()(plane const& p) const noexcept
+    {
+        plane out;
+        detail::d::sw012<false, false>(&p.p0_, p1_, nullptr, &out.p0_);
+        return out;
+    }
+
+    /// Conjugates a line $\ell$ with this rotor and returns the result
+    /// $r\ell \widetilde{r}$.
+    [[nodiscard]] line operator()(line const& l) const noexcept
+    {
+        line out;
+        detail::d::swMM<false, false, true>(&l.p1_, p1_, nullptr, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates a point $p$ with this rotor and returns the result
+    /// $rp\widetilde{r}$.
+    [[nodiscard]] point operator()(point const& p) const noexcept
+    {
+        point out;
+        detail::d::sw012<false, false>(&p.p3_, p1_, nullptr, &out.p3_);
+        return out;
+    }
+
+    /// Conjugates an array of points with this rotor. `in` and `out` may
+    /// alias iff `in == out`.
+    void operator()(point const* in, point* out, size_t count) const noexcept
+    {
+        detail::d::sw012<true, false>(&in->p3_, p1_, nullptr, &out->p3_, count);
+    }
+
+    [[nodiscard]] double scalar() const noexcept
+    {
+        return detail::f64_lane0(p1_);
+    }
+
+    [[nodiscard]] double e23() const noexcept
+    {
+        return lane(1);
+    }
+
+    [[nodiscard]] double e31() const noexcept
+    {
+        return lane(2);
+    }
+
+    [[nodiscard]] double e12() const noexcept
+    {
+        return lane(3);
+    }
+
+    /// Rotor components `(1, e23, e31, e12)`
+    detail::f64x4 p1_;
+
+private:
+    double lane(size_t i) const noexcept
+    {
+        double p[4];
+        detail::f64_storeu(p, p1_);
+        return p[i];
+    }
+};
+
+/// Double precision counterpart of `kln::translator`.
+class translator final
+{
+public:
+    translator() noexcept = default;
+
+    /// Translation by `delta` along the direction `(x, y, z)`. The direction
+    /// need not be normalized.
+    translator(double delta, double x, double y, double z) noexcept
+    {
+        double scale = -0.5 * delta / std::sqrt(x * x + y * y + z * z);
+        p2_          = detail::f64_set(z, y, x, 0.0);
+        p2_ = detail::f64_mul(p2_, detail::f64_set(scale, scale, scale, 0.0));
+    }
+
+    translator(detail::f64x4 p2) noexcept
+        : p2_{p2}
+    {}
+
+    /// Widen a single precision translator.
+    explicit translator(kln::translator const& t) noexcept
+        : p2_{detail::f64_set(t.e03(), t.e02(), t.e01(), 0.0)}
+    {}
+
+    /// Narrow to a single precision translator.
+    [[nodiscard]] kln::translator to_float() const noexcept
+    {
+        double p[4];
+        detail::f64_storeu(p, p2_);
+        kln::translator out;
+        out.p2_ = _mm_set_ps(static_cast<float>(p[3]),
+                             static_cast<float>(p[2]),
+                             static_cast<float>(p[1]),
+                             0.f);
+        return out;
+    }
+
+    /// Conjugates a plane $p$ with this translator and returns the result
+    /// $tp\widetilde{t}$.
+    [[nodiscard]] plane operator()(plane const& p) const noexcept
+    {
+        return {detail::d::sw02(
+            p.p0_, detail::f64_add(p2_, detail::f64_set_ss(1.0)))};
+    }
+
+    /// Conjugates a line $\ell$ with this translator and returns the result
+    /// $t\ell\widetilde{t}$.
+    [[nodiscard]] line operator()(line const& l) const noexcept
+    {
+        line out;
+        detail::d::swL2(l.p1_, l.p2_, p2_, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates a point $p$ with this translator and returns the result
+    /// $tp\widetilde{t}$.
+    [[nodiscard]] point operator()(point const& p) const noexcept
+    {
+        return {detail::d::sw32(p.p3_, p2_)};
+    }
+
+    [[nodiscard]] double e01() const noexcept
+    {
+        return lane(1);
+    }
+
+    [[nodiscard]] double e02() const noexcept
+    {
+        return lane(2);
+    }
+
+    [[nodiscard]] double e03() const noexcept
+    {
+        return lane(3);
+    }
+
+    /// Translator components `(_, e01, e02, e03)`
+    detail::f64x4 p2_;
+
+private:
+    double lane(size_t i) const noexcept
+    {
+        double p[4];
+        detail::f64_storeu(p, p2_);
+        return p[i];
+    }
+};
+
+/// Double precision counterpart of `kln::motor`.
+class motor final
+{
+public:
+    motor() noexcept = default;
+
+    /// Direct initialization from components. The arguments correspond to the
+    /// multivector
+    /// $a + b\mathbf{e}_{23} + c\mathbf{e}_{31} + d\mathbf{e}_{12} +\
+    /// e\mathbf{e}_{01} + f\mathbf{e}_{02} + g\mathbf{e}_{03} +\
+    /// h\mathbf{e}_{0123}$.
+    motor(double a,
+          double b,
+          double c,
+          double d,
+          double e,
+          double f,
+          double g,
+          double h) noexcept
+        : p1_{detail::f64_set(d, c, b, a)}
+        , p2_{detail::f64_set(g, f, e, h)}
+    {}
+
+    motor(detail::f64x4 p1, detail::f64x4 p2) noexcept
+        : p1_{p1}
+        , p2_{p2}
+    {}
+
+    explicit motor(rotor r) noexcept
+        : p1_{r.p1_}
+        , p2_{detail::f64_setzero()}
+    {}
+
+    explicit motor(translator t) noexcept
+        : p1_{detail::f64_set_ss(1.0)}
+        , p2_{t.p2_}
+    {}
+
+    /// Widen a single precision motor.
+    explicit motor(kln::motor const& m) noexcept
+        : motor{m.scalar(),
+                m.e23(),
+                m.e31(),
+                m.e12(),
+                m.e01(),
+                m.e02(),
+                m.e03(),
+                m.e0123()}
+    {}
+
+    /// Unaligned load of 8 doubles with layout
+    /// `(1, e23, e31, e12, e0123, e01, e02, e03)`.
+    void load(double const* data) noexcept
+    {
+        p1_ = detail::f64_loadu(data);
+        p2_ = detail::f64_loadu(data + 4);
+    }
+
+    /// Unaligned store of 8 doubles with the layout accepted by `load`.
+    void store(double* data) const noexcept
+    {
+        detail::f64_storeu(data, p1_);
+        detail::f64_storeu(data + 4, p2_);
+    }
+
+    /// Normalizes this motor $m$ such that $m\widetilde{m} = 1$.
+    void normalize() noexcept
+    {
+        // See kln::motor::normalize for the derivation
+        detail::f64x4 flip = detail::f64_set_ss(-0.0);
+
+        double b2 = detail::f64_lane0(detail::f64_dp_bc(p1_, p1_));
+        double s  = 1.0 / std::sqrt(b2);
+        double bc = detail::f64_lane0(
+            detail::f64_dp_bc(detail::f64_xor(p1_, flip), p2_));
+        double t = bc / b2 * s;
+
+        p2_ = detail::f64_sub(
+            detail::f64_mul(p2_, detail::f64_set1(s)),
+            detail::f64_xor(detail::f64_mul(p1_, detail::f64_set1(t)), flip));
+        p1_ = detail::f64_mul(p1_, detail::f64_set1(s));
+    }
+
+    /// Return a normalized copy of this motor.
+    [[nodiscard]] motor normalized() const noexcept
+    {
+        motor out = *this;
+        out.normalize();
+        return out;
+    }
+
+    /// Narrow to a single precision motor.
+    [[nodiscard]] kln::motor to_float() const noexcept
+    {
+        double p[8];
+        store(p);
+        return {static_cast<float>(p[0]),
+                static_cast<float>(p[1]),
+                static_cast<float>(p[2]),
+                static_cast<float>(p[3]),
+                static_cast<float>(p[5]),
+                static_cast<float>(p[6]),
+                static_cast<float>(p[7]),
+                static_cast<float>(p[4])};
+    }
+
+    /// Conjugates a plane $p$ with this motor and returns the result
+    /// $mp\widetilde{m}$.
+    [[nodiscard]] plane operator()(plane const& p) const noexcept
+    {
+        plane out;
+        detail::d::sw012<false, true>(&p.p0_, p1_, &p2_, &out.p0_);
+        return out;
+    }
+
+    /// Conjugates an array of planes with this motor. `in` and `out` may
+    /// alias iff `in == out`.
+    void operator()(plane const* in, plane* out, size_t count) const noexcept
+    {
+        detail::d::sw012<true, true>(&in->p0_, p1_, &p2_, &out->p0_, count);
+    }
+
+    /// Conjugates a line $\ell$ with this motor and returns the result
+    /// $m\ell \widetilde{m}$.
+    [[nodiscard]] line operator()(line const& l) const noexcept
+    {
+        line out;
+        detail::d::swMM<false, true, true>(&l.p1_, p1_, &p2_, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates an array of lines with this motor. `in` and `out` may alias
+    /// iff `in == out`.
+    void operator()(line const* in, line* out, size_t count) const noexcept
+    {
+        detail::d::swMM<true, true, true>(
+            &in->p1_, p1_, &p2_, &out->p1_, count);
+    }
+
+    /// Conjugates a point $p$ with this motor and returns the result
+    /// $mp\widetilde{m}$.
+    [[nodiscard]] point operator()(point const& p) const noexcept
+    {
+        point out;
+        detail::d::sw312<false, true>(&p.p3_, p1_, &p2_, &out.p3_);
+        return out;
+    }
+
+    /// Conjugates an array of points with this motor. `in` and `out` may
+    /// alias iff `in == out`.
+    void operator()(point const* in, point* out, size_t count) const noexcept
+    {
+        detail::d::sw312<true, true>(&in->p3_, p1_, &p2_, &out->p3_, count);
+    }
+
+    [[nodiscard]] double scalar() const noexcept
+    {
+        return detail::f64_lane0(p1_);
+    }
+
+    [[nodiscard]] double e23() const noexcept
+    {
+        return lane(1);
+    }
+
+    [[nodiscard]] double e31() const noexcept
+    {
+        return lane(2);
+    }
+
+    [[nodiscard]] double e12() const noexcept
+    {
+        return lane(3);
+    }
+
+    [[nodiscard]] double e01() const noexcept
+    {
+        return lane(5);
+    }
+
+    [[nodiscard]] double e02() const noexcept
+    {
+        return lane(6);
+    }
+
+    [[nodiscard]] double e03() const noexcept
+    {
+        return lane(7);
+    }
+
+    [[nodiscard]] double e0123() const noexcept
+    {
+        return detail::f64_lane0(p2_);
+    }
+
+    /// Rotor components `(1, e23, e31, e12)`
+    detail::f64x4 p1_;
+    /// Translator components `(e0123, e01, e02, e03)`
+    detail::f64x4 p2_;
+
+private:
+    double lane(size_t i) const noexcept
+    {
+        double p[8];
+        store(p);
+        return p[i];
+    }
+};
+
+/// Compose two rotors (`b` will be applied, then `a`)
+[[nodiscard]] inline rotor operator*(rotor const& a, rotor const& b) noexcept
+{
+    rotor out;
+    detail::d::gp11(a.p1_, b.p1_, out.p1_);
+    return out;
+}
+
+/// Compose the action of a translator and rotor (`b` will be applied, then `a`)
+[[nodiscard]] inline motor operator*(rotor const& a,
+                                     translator const& b) noexcept
+{
+    motor out;
+    out.p1_ = a.p1_;
+    detail::d::gpRT<false>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+/// Compose the action of a rotor and translator (`a` will be applied, then `b`)
+[[nodiscard]] inline motor operator*(translator const& b,
+                                     rotor const& a) noexcept
+{
+    motor out;
+    out.p1_ = a.p1_;
+    detail::d::gpRT<true>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+/// Compose the action of a rotor and motor (`b` will be applied, then `a`)
+[[nodiscard]] inline motor operator*(rotor const& a, motor const& b) noexcept
+{
+    motor out;
+    detail::d::gp11(a.p1_, b.p1_, out.p1_);
+    detail::d::gp12<false>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+/// Compose the action of a rotor and motor (`a` will be applied, then `b`)
+[[nodiscard]] inline motor operator*(motor const& b, rotor const& a) noexcept
+{
+    motor out;
+    detail::d::gp11(b.p1_, a.p1_, out.p1_);
+    detail::d::gp12<true>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+/// Compose the action of a translator and motor (`b` will be applied, then `a`)
+[[nodiscard]] inline motor operator*(translator const& a,
+                                     motor const& b) noexcept
+{
+    motor out;
+    out.p1_ = b.p1_;
+    detail::d::gpRT<true>(b.p1_, a.p2_, out.p2_);
+    out.p2_ = detail::f64_add(out.p2_, b.p2_);
+    return out;
+}
+
+/// Compose the action of a translator and motor (`a` will be applied, then `b`)
+[[nodiscard]] inline motor operator*(motor const& b,
+                                     translator const& a) noexcept
+{
+    motor out;
+    out.p1_ = b.p1_;
+    detail::d::gpRT<false>(b.p1_, a.p2_, out.p2_);
+    out.p2_ = detail::f64_add(out.p2_, b.p2_);
+    return out;
+}
+
+/// Compose the action of two motors (`b` will be applied, then `a`)
+[[nodiscard]] inline motor operator*(motor const& a, motor const& b) noexcept
+{
+    motor out;
+    detail::d::gpMM(a.p1_, b.p1_, &out.p1_);
+    return out;
+}
+
+/// Reversion operator
+[[nodiscard]] inline rotor operator~(rotor const& r) noexcept
+{
+    return {detail::f64_xor(r.p1_, detail::f64_set(-0.0, -0.0, -0.0, 0.0))};
+}
+
+/// Reversion operator
+[[nodiscard]] inline translator operator~(translator const& t) noexcept
+{
+    return {detail::f64_xor(t.p2_, detail::f64_set(-0.0, -0.0, -0.0, 0.0))};
+}
+
+/// Reversion operator
+[[nodiscard]] inline motor operator~(motor const& m) noexcept
+{
+    detail::f64x4 flip = detail::f64_set(-0.0, -0.0, -0.0, 0.0);
+    return {detail::f64_xor(m.p1_, flip), detail::f64_xor(m.p2_, flip)};
+}
+/// @}
+} // namespace d
+} // namespace kln
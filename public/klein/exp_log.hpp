@@ -54,6 +54,40 @@ namespace kln
     return out;
 }
 
+/// Takes the logarithm of `count` motors, equivalent to `out[i] = log(in[i])`.
+/// The motors are processed 4, 8, or 16 at a time (with SSE, AVX2, and
+/// AVX-512 respectively) using polynomial approximations of the arctangent.
+/// The input and output may alias.
+///
+/// For normalized motors, each component of the result differs from that of
+/// the single-motor `log` by at most $2\times 10^{-6}$ times the largest
+/// component magnitude of the result (or 1, if greater).
+///
+/// !!! tip
+///
+///     Interpolating many motors at once (for example, when blending the
+///     joints of a skeleton) is most efficient as a `log` over all the
+///     motors, followed by the scaling of each line, followed by an `exp`
+///     over all the lines.
+inline void log(motor const* in, line* out, size_t count) noexcept
+{
+    detail::log_batch(&in->p1_, &out->p1_, count);
+}
+
+/// Exponentiates `count` lines, equivalent to `out[i] = exp(in[i])`. The
+/// lines are processed 4, 8, or 16 at a time (with SSE, AVX2, and AVX-512
+/// respectively) using polynomial approximations of the sine and cosine. The
+/// input and output may alias.
+///
+/// Each component of the result differs from that of the single-line `exp`
+/// by at most $2\times 10^{-6}$ times the largest component magnitude of the
+/// result (or 1, if greater), provided the norm of the line's Euclidean part
+/// is at most 8192. Beyond this, the reduction of the angle loses accuracy.
+inline void exp(line const* in, motor* out, size_t count) noexcept
+{
+    detail::exp_batch(&in->p1_, &out->p1_, count);
+}
+
 /// Compute the logarithm of the translator, producing an ideal line axis.
 /// In practice, the logarithm of a translator is simply the ideal partition
 /// (without the scalar $1$).
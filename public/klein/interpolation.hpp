@@ -0,0 +1,188 @@
+#pragma once
+
+#include "exp_log.hpp"
+#include "geometric_product.hpp"
+#include "line.hpp"
+#include "motor.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#ifdef KLEIN_VALIDATE
+#    include <cassert>
+#endif
+
+namespace kln
+{
+/// \defgroup interpolation Interpolation
+///
+/// Motors are interpolated by scaling the logarithm of the motion between
+/// them (see [Exponential and Logarithm](../exp_log)). For two motors $a$ and
+/// $b$, the motion from $a$ to $b$ is $b\widetilde{a}$, and the interpolant is
+/// given as
+///
+/// $$\exp{\left[t\log{\left(b\widetilde{a}\right)}\right]} a$$
+///
+/// which is the "dual quaternion slerp." The logarithm is the expensive part
+/// of this expression and only depends on the endpoints, so when the same
+/// keyframes are sampled repeatedly (as with an animation clip), it should be
+/// computed once. A `motor_track` does exactly this for a sequence of
+/// keyframes.
+///
+/// !!! example
+///
+///     ```c++
+///         // Keyframe poses of a joint and the time of each keyframe
+///         kln::motor_track track{poses.data(), times.data(), poses.size()};
+///
+///         // Every frame, sample the track. No logarithms are computed here.
+///         kln::motor pose = track.sample(clock);
+///
+///         // Or, sample many times at once (e.g. for motion blur or to
+///         // resample the clip at a different rate)
+///         track.sample(sample_times.data(), out.data(), sample_times.size());
+///     ```
+
+/// \addtogroup interpolation
+/// @{
+
+/// Interpolates between the motors `a` (at `t = 0`) and `b` (at `t = 1`) along
+/// the screw motion that takes `a` to `b`. The interpolation follows the
+/// shorter of the two screw motions relating `a` and `b` (`b` and `-b`
+/// represent the same rigid transform). Both motors are presumed to be
+/// normalized.
+[[nodiscard]] inline motor KLN_VEC_CALL slerp(motor a,
+                                              motor b,
+                                              float t) noexcept
+{
+    motor motion = b * ~a;
+    if (motion.scalar() < 0.f)
+    {
+        motion = -motion;
+    }
+    return exp(log(motion) * t) * a;
+}
+
+/// A sequence of keyframe motors along with the cached logarithm of the
+/// motion between each pair of consecutive keyframes.
+class motor_track final
+{
+public:
+    motor_track() = default;
+
+    /// Create a track from `count` keyframe motors, where `times` is
+    /// the strictly increasing sequence of times associated with each motor.
+    /// The keyframes are presumed to be normalized.
+    motor_track(motor const* keyframes, float const* times, size_t count)
+        : keyframes_{keyframes, keyframes + count}
+        , times_{times, times + count}
+        , logs_(count)
+    {
+        // The log of segment i is stored at index i. The last entry (past
+        // the last keyframe) is left as the zero line which exponentiates to
+        // the identity, so samples clamped to the end reproduce the last
+        // keyframe exactly.
+        if (count < 2)
+        {
+            return;
+        }
+
+        std::vector<motor> motions(count - 1);
+        for (size_t i = 0; i != count - 1; ++i)
+        {
+#ifdef KLEIN_VALIDATE
+            assert(times[i] < times[i + 1]
+                   && "Keyframe times must be strictly increasing");
+#endif
+            motions[i] = keyframes[i + 1] * ~keyframes[i];
+            if (motions[i].scalar() < 0.f)
+            {
+                motions[i] = -motions[i];
+            }
+        }
+        log(motions.data(), logs_.data(), count - 1);
+    }
+
+    /// Number of keyframes in the track.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return keyframes_.size();
+    }
+
+    /// The logarithm of the motion from keyframe `i` to keyframe `i + 1`.
+    [[nodiscard]] line const& segment_log(size_t i) const noexcept
+    {
+        return logs_[i];
+    }
+
+    /// Sample the track at `time`. Times before the first keyframe and after
+    /// the last keyframe are clamped to the first and last keyframes
+    /// respectively. The track must not be empty.
+    [[nodiscard]] motor KLN_VEC_CALL sample(float time) const noexcept
+    {
+        float t;
+        uint32_t segment = locate(time, t);
+        return exp(logs_[segment] * t) * keyframes_[segment];
+    }
+
+    /// Sample the track at `count` times, equivalent to
+    /// `out[i] = sample(times[i])`. The exponentials of all samples are
+    /// evaluated with the batched `exp`.
+    void sample(float const* times, motor* out, size_t count) const noexcept
+    {
+        constexpr size_t chunk = 64;
+        line steps[chunk];
+        uint32_t segments[chunk];
+
+        for (size_t base = 0; base < count; base += chunk)
+        {
+            size_t n = std::min(chunk, count - base);
+            for (size_t i = 0; i != n; ++i)
+            {
+                float t;
+                segments[i] = locate(times[base + i], t);
+                steps[i]    = logs_[segments[i]] * t;
+            }
+
+            exp(steps, out + base, n);
+
+            for (size_t i = 0; i != n; ++i)
+            {
+                out[base + i] = out[base + i] * keyframes_[segments[i]];
+            }
+        }
+    }
+
+private:
+    // Returns the index of the segment containing time and the normalized
+    // time within it
+    uint32_t locate(float time, float& t) const noexcept
+    {
+#ifdef KLEIN_VALIDATE
+        assert(!keyframes_.empty() && "Cannot sample an empty track");
+#endif
+        auto it = std::upper_bound(times_.begin(), times_.end(), time);
+        if (it == times_.begin())
+        {
+            t = 0.f;
+            return 0;
+        }
+        if (it == times_.end())
+        {
+            t = 0.f;
+            return static_cast<uint32_t>(times_.size() - 1);
+        }
+
+        uint32_t segment = static_cast<uint32_t>(it - times_.begin() - 1);
+        t                = (time - times_[segment])
+            / (times_[segment + 1] - times_[segment]);
+        return segment;
+    }
+
+    std::vector<motor> keyframes_;
+    std::vector<float> times_;
+    std::vector<line> logs_;
+};
+/// @}
+} // namespace kln
@@ -83,6 +83,21 @@ KLN_INLINE dual KLN_VEC_CALL operator!(dual in) noexcept
 ///         // p2 contains both p1 and l2.
 ///         kln::plane p2 = p1 & l2;
 ///     ```
+///
+/// The `join` functions evaluate the regressive product for whole arrays of
+/// operands selected by pairs (or triples) of indices. For example, the
+/// lines along the edges of a mesh and the planes of its triangles are
+/// produced directly from the vertex positions and index buffers.
+///
+/// !!! example "Joining points by index"
+///
+///     ```cpp
+///         // Two vertex indices per edge
+///         kln::join(vertices.data(), edges.data(), lines.data(), edge_count);
+///
+///         // Three vertex indices per triangle
+///         kln::join(vertices.data(), indices.data(), planes.data(), n);
+///     ```
 
 /// \addtogroup reg
 /// @{
@@ -130,5 +145,39 @@ KLN_INLINE dual KLN_VEC_CALL operator!(dual in) noexcept
 {
     return !(!a ^ !b);
 }
+
+/// Write `a[pairs[2 * i]] & a[pairs[2 * i + 1]]` to `out[i]` for each of the
+/// `count` index pairs.
+inline void join(point const* a,
+                 uint32_t const* pairs,
+                 line* out,
+                 size_t count) noexcept
+{
+    detail::ext00<true>(&a->p3_, pairs, &out->p1_, count);
+}
+
+/// Write the plane `a[t0] & a[t1] & a[t2]` through three points to `out[i]`,
+/// where `t0`, `t1`, and `t2` are `triples[3 * i]`, `triples[3 * i + 1]`,
+/// and `triples[3 * i + 2]`, for each of the `count` index triples. The
+/// normal of a plane points away from the side its triangle appears
+/// counter-clockwise from.
+inline void join(point const* a,
+                 uint32_t const* triples,
+                 plane* out,
+                 size_t count) noexcept
+{
+    detail::ext000(&a->p3_, triples, &out->p0_, count);
+}
+
+/// Write `a[pairs[2 * i]] & b[pairs[2 * i + 1]]` to `out[i]` for each of the
+/// `count` index pairs.
+inline void join(point const* a,
+                 line const* b,
+                 uint32_t const* pairs,
+                 plane* out,
+                 size_t count) noexcept
+{
+    detail::ext012<true>(&a->p3_, &b->p1_, pairs, &out->p0_, count);
+}
 /// @}
 } // namespace kln
\ No newline at end of file
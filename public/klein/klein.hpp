@@ -6,10 +6,20 @@
 
 #pragma once
 
+#include "compressed_motor.hpp"
+#include "culling.hpp"
+#include "distance.hpp"
 #include "exp_log.hpp"
 #include "geometric_product.hpp"
+#include "hierarchy.hpp"
 #include "inner_product.hpp"
+#include "interpolation.hpp"
 #include "join.hpp"
 #include "meet.hpp"
+#include "motor_soa.hpp"
 #include "projection.hpp"
-#include "util.hpp"
\ No newline at end of file
+#include "raycast.hpp"
+#include "skinning.hpp"
+#include "soa.hpp"
+#include "util.hpp"
+#include "vertex_buffer.hpp"
\ No newline at end of file
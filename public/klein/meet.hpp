@@ -39,6 +39,20 @@ namespace kln
 ///         // p2 lies at the intersection of p1 and l2.
 ///         kln::point p2 = p1 ^ l2;
 ///     ```
+///
+/// The `meet` functions evaluate the exterior product for whole arrays of
+/// operands selected by pairs (or triples) of indices, such as the edges or
+/// faces of a mesh.
+///
+/// !!! example "Meeting planes by index"
+///
+///     ```cpp
+///         // Two plane indices per line
+///         kln::meet(planes.data(), edges.data(), lines.data(), edge_count);
+///
+///         // Three plane indices per point
+///         kln::meet(planes.data(), corners.data(), points.data(), n);
+///     ```
 
 /// \addtogroup ext
 /// @{
@@ -76,12 +90,7 @@ namespace kln
 
 [[nodiscard]] inline point KLN_VEC_CALL operator^(plane a, line b) noexcept
 {
-    point out;
-    detail::extPB(a.p0_, b.p1_, out.p3_);
-    __m128 tmp;
-    detail::ext02(a.p0_, b.p2_, tmp);
-    out.p3_ = _mm_add_ps(tmp, out.p3_);
-    return out;
+    return {detail::ext012(a.p0_, b.p1_, b.p2_)};
 }
 
 [[nodiscard]] inline point KLN_VEC_CALL operator^(line b, plane a) noexcept
@@ -149,5 +158,50 @@ namespace kln
 {
     return a ^ b;
 }
+
+/// Write `a[pairs[2 * i]] ^ a[pairs[2 * i + 1]]` to `out[i]` for each of the
+/// `count` index pairs.
+inline void meet(plane const* a,
+                 uint32_t const* pairs,
+                 line* out,
+                 size_t count) noexcept
+{
+    detail::ext00<false>(&a->p0_, pairs, &out->p1_, count);
+}
+
+/// Write the point `a[t0] ^ a[t1] ^ a[t2]` shared by three planes to
+/// `out[i]`, where `t0`, `t1`, and `t2` are `triples[3 * i]`,
+/// `triples[3 * i + 1]`, and `triples[3 * i + 2]`, for each of the `count`
+/// index triples.
+inline void meet(plane const* a,
+                 uint32_t const* triples,
+                 point* out,
+                 size_t count) noexcept
+{
+    detail::ext000(&a->p0_, triples, &out->p3_, count);
+}
+
+/// Write `a[pairs[2 * i]] ^ b[pairs[2 * i + 1]]` to `out[i]` for each of the
+/// `count` index pairs.
+inline void meet(plane const* a,
+                 line const* b,
+                 uint32_t const* pairs,
+                 point* out,
+                 size_t count) noexcept
+{
+    detail::ext012<false>(&a->p0_, &b->p1_, pairs, &out->p3_, count);
+}
+
+/// Write the $\mathbf{e}_{0123}$ coefficient of
+/// `a[pairs[2 * i]] ^ b[pairs[2 * i + 1]]` to `out[i]` for each of the
+/// `count` index pairs.
+inline void meet(plane const* a,
+                 point const* b,
+                 uint32_t const* pairs,
+                 float* out,
+                 size_t count) noexcept
+{
+    detail::ext03(&a->p0_, &b->p3_, pairs, out, count);
+}
 /// @}
 } // namespace kln
\ No newline at end of file
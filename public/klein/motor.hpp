@@ -12,6 +12,7 @@
 #include "plane.hpp"
 #include "point.hpp"
 #include "rotor.hpp"
+#include "soa.hpp"
 #include "translator.hpp"
 
 namespace kln
@@ -76,6 +77,8 @@ namespace kln
 
 /// \addtogroup motor
 /// @{
+class prepared_motor;
+
 /// \ingroup motor
 class motor final
 {
@@ -383,6 +386,54 @@ public:
         detail::sw312<true, false>(&in->p3_, p1_, nullptr, &out->p3_, count);
     }
 
+    /// Precompute the motor-dependent terms of the sandwich products with
+    /// this motor. The returned `prepared_motor` offers the same call
+    /// operators as the motor, but its setup cost is paid once.
+    ///
+    /// !!! tip
+    ///
+    ///     Prefer this when a motor is applied many times to single entities
+    ///     or to small batches (e.g. once per instance per draw). For one
+    ///     large array, the array overloads already amortize the setup.
+    [[nodiscard]] prepared_motor prepare() const noexcept;
+
+    /// Conjugates a structure-of-arrays batch of points with this motor and
+    /// stores the result in `out`, which is resized to match `in`. Aliasing is
+    /// only permitted when `&in == &out` (in place motor application).
+    ///
+    /// !!! tip
+    ///
+    ///     For large batches, this routine is faster than the array overload
+    ///     taking `point*` as every register lane transforms a different point
+    ///     and no shuffles are required. With AVX2 or AVX-512 enabled, 8 or 16
+    ///     points are processed per instruction respectively.
+    void operator()(point_soa const& in, point_soa& out) const
+    {
+        out.resize(in.size());
+        detail::sw312_soa<true>(p1_,
+                                &p2_,
+                                in.data(),
+                                in.stride(),
+                                out.data(),
+                                out.stride(),
+                                in.size());
+    }
+
+    /// Conjugates a structure-of-arrays batch of planes with this motor and
+    /// stores the result in `out`, which is resized to match `in`. Aliasing is
+    /// only permitted when `&in == &out` (in place motor application).
+    void operator()(plane_soa const& in, plane_soa& out) const
+    {
+        out.resize(in.size());
+        detail::sw012_soa<true>(p1_,
+                                &p2_,
+                                in.data(),
+                                in.stride(),
+                                out.data(),
+                                out.stride(),
+                                in.size());
+    }
+
     /// Motor addition
     motor& KLN_VEC_CALL operator+=(motor b) noexcept
     {
@@ -600,5 +651,129 @@ public:
     __m128 flip = _mm_set_ps(-0.f, -0.f, -0.f, 0.f);
     return {_mm_xor_ps(m.p1_, flip), _mm_xor_ps(m.p2_, flip)};
 }
+
+/// Convert `count` normalized motors to tightly packed row-major 3x4 matrices
+/// (12 floats, or 48 bytes, per motor) suitable for a GPU bone palette.
+/// Unlike `motor::as_mat3x4`, the omitted fourth row and the column-major
+/// padding are never written.
+///
+/// If `out` is 16-byte aligned, the matrices are written with non-temporal
+/// (streaming) stores that bypass the cache, followed by a store fence. Write
+/// directly into a mapped upload buffer in this case; reading the
+/// matrices back on the CPU afterwards is slow.
+///
+/// !!! example
+///
+///     ```c++
+///         // Matrix i occupies floats [12 i, 12 i + 12) with rows
+///         // (m00, m01, m02, tx), (m10, m11, m12, ty), (m20, m21, m22, tz)
+///         float* mapped = static_cast<float*>(map_buffer(bone_palette));
+///         kln::to_mat3x4(joints.data(), mapped, joints.size());
+///     ```
+inline void to_mat3x4(motor const* in, float* out, size_t count) noexcept
+{
+    mat3x4_12_rows(&in->p1_, out, count);
+}
+
+/// A motor along with the motor-dependent terms of its sandwich products with
+/// planes, lines, points and directions (see `motor::prepare`). Applying a
+/// prepared motor gives the same results as applying the motor it was
+/// prepared from. The prepared terms occupy 224 bytes.
+class prepared_motor final
+{
+public:
+    prepared_motor() noexcept = default;
+
+    explicit prepared_motor(motor const& m) noexcept
+    {
+        detail::sw012_prepare(m.p1_, m.p2_, plane_);
+        detail::swMM_prepare(m.p1_, m.p2_, line_);
+        detail::sw312_prepare(m.p1_, m.p2_, point_);
+    }
+
+    /// Conjugates a plane $p$ with the prepared motor.
+    [[nodiscard]] plane KLN_VEC_CALL operator()(plane const& p) const noexcept
+    {
+        plane out;
+        out.p0_ = detail::sw012_apply(plane_, p.p0_);
+        return out;
+    }
+
+    /// Conjugates an array of planes with the prepared motor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(plane* in, plane* out, size_t count) const noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i].p0_ = detail::sw012_apply(plane_, in[i].p0_);
+        }
+    }
+
+    /// Conjugates a line $\ell$ with the prepared motor.
+    [[nodiscard]] line KLN_VEC_CALL operator()(line const& l) const noexcept
+    {
+        line out;
+        detail::swMM_apply(line_, &l.p1_, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates an array of lines with the prepared motor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(line* in, line* out, size_t count) const noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            detail::swMM_apply(line_, &in[i].p1_, &out[i].p1_);
+        }
+    }
+
+    /// Conjugates a point $p$ with the prepared motor.
+    [[nodiscard]] point KLN_VEC_CALL operator()(point const& p) const noexcept
+    {
+        point out;
+        out.p3_ = detail::sw312_apply(point_, p.p3_);
+        return out;
+    }
+
+    /// Conjugates an array of points with the prepared motor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(point* in, point* out, size_t count) const noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i].p3_ = detail::sw312_apply(point_, in[i].p3_);
+        }
+    }
+
+    /// Conjugates a direction $d$ with the prepared motor.
+    [[nodiscard]] direction KLN_VEC_CALL operator()(direction const& d) const noexcept
+    {
+        direction out;
+        out.p3_ = detail::sw312_apply<false>(point_, d.p3_);
+        return out;
+    }
+
+    /// Conjugates an array of directions with the prepared motor. Aliasing is
+    /// only permitted when `in == out`.
+    void KLN_VEC_CALL operator()(direction* in,
+                                 direction* out,
+                                 size_t count) const noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i].p3_ = detail::sw312_apply<false>(point_, in[i].p3_);
+        }
+    }
+
+private:
+    detail::sw012_state plane_;
+    detail::swMM_state line_;
+    detail::sw312_state point_;
+};
+
+inline prepared_motor motor::prepare() const noexcept
+{
+    return prepared_motor{*this};
+}
 } // namespace kln
   /// @}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "detail/soa.hpp"
+#include "detail/sse.hpp"
+#include "motor.hpp"
+#include "soa.hpp"
+
+#ifdef KLEIN_VALIDATE
+#    include <cassert>
+#endif
+
+namespace kln
+{
+/// \defgroup motor_soa Motor Batches
+///
+/// A `motor_soa` stores a batch of motors as eight component streams, in the
+/// same fashion as `point_soa` and `plane_soa`. Unlike applying a single motor
+/// to a batch of points, every lane of a register here holds a *different*
+/// motor, so batches of motors can be composed with one another and applied to
+/// batches of points and planes element by element. This is the building block
+/// for propagating transforms through large hierarchies level by level.
+///
+/// The kernels process 4 motors per instruction by default, 8 with AVX2, and
+/// 16 when compiled with AVX-512 support (via the `klein_avx512` target or the
+/// `KLEIN_AVX512` define). With AVX-512, the final partial register of each
+/// batch is processed with masked loads and stores.
+///
+/// !!! example
+///
+///     ```c++
+///         // World transforms of the parents of each node on one level
+///         kln::motor_soa parents = gather_parents(level);
+///         // Local transforms of each node on the level
+///         kln::motor_soa locals = load_locals(level);
+///
+///         // world[i] = parents[i] * locals[i]
+///         kln::motor_soa world;
+///         kln::compose(parents, locals, world);
+///
+///         // Apply world[i] to the i-th point
+///         world(points, points);
+///     ```
+
+/// \addtogroup motor_soa
+/// @{
+
+/// A batch of motors stored as separate `e23`, `e31`, `e12`, `scalar`, `e01`,
+/// `e02`, `e03`, and `e0123` streams.
+class motor_soa final
+{
+public:
+    motor_soa() noexcept = default;
+
+    /// Create a batch of `count` zero-initialized motors.
+    explicit motor_soa(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Create a batch by transposing `count` tightly packed motors.
+    motor_soa(motor const* in, size_t count)
+    {
+        load(in, count);
+    }
+
+    /// Resize the batch, preserving existing elements. Newly added elements
+    /// are zero-initialized.
+    void resize(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Replace the contents of this batch with `count` tightly packed motors.
+    void load(motor const* in, size_t count)
+    {
+        buf_.resize(count);
+        if (count > 0)
+        {
+            buf_.load(&in->p1_, count);
+        }
+    }
+
+    /// Transpose the batch back into `size()` tightly packed motors.
+    void store(motor* out) const noexcept
+    {
+        buf_.store(&out->p1_);
+    }
+
+    [[nodiscard]] motor get(size_t i) const noexcept
+    {
+        motor out;
+        out.p1_ = buf_.get(i, 0);
+        out.p2_ = buf_.get(i, 1);
+        return out;
+    }
+
+    void set(size_t i, motor const& m) noexcept
+    {
+        buf_.set(i, m.p1_, 0);
+        buf_.set(i, m.p2_, 1);
+    }
+
+    /// Number of motors in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /// Distance in floats between consecutive streams. This is the size
+    /// rounded up to a multiple of 16.
+    [[nodiscard]] size_t stride() const noexcept
+    {
+        return buf_.stride();
+    }
+
+    /// Pointer to the start of the stream buffer. The eight streams follow one
+    /// another, separated by `stride()` floats.
+    [[nodiscard]] float* data() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* data() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* e23() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* e23() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* e31() noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float const* e31() const noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float* e12() noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float const* e12() const noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float* scalar() noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+    [[nodiscard]] float const* scalar() const noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+    [[nodiscard]] float* e01() noexcept
+    {
+        return buf_.data() + 4 * stride();
+    }
+
+    [[nodiscard]] float const* e01() const noexcept
+    {
+        return buf_.data() + 4 * stride();
+    }
+
+    [[nodiscard]] float* e02() noexcept
+    {
+        return buf_.data() + 5 * stride();
+    }
+
+    [[nodiscard]] float const* e02() const noexcept
+    {
+        return buf_.data() + 5 * stride();
+    }
+
+    [[nodiscard]] float* e03() noexcept
+    {
+        return buf_.data() + 6 * stride();
+    }
+
+    [[nodiscard]] float const* e03() const noexcept
+    {
+        return buf_.data() + 6 * stride();
+    }
+
+    [[nodiscard]] float* e0123() noexcept
+    {
+        return buf_.data() + 7 * stride();
+    }
+
+    [[nodiscard]] float const* e0123() const noexcept
+    {
+        return buf_.data() + 7 * stride();
+    }
+
+    /// Conjugates the i-th point of `in` with the i-th motor of this batch
+    /// for every motor in the batch. `in` must contain at least `size()`
+    /// points and `out` is resized to `size()`. Aliasing is only permitted
+    /// when `&in == &out` (in place motor application).
+    void operator()(point_soa const& in, point_soa& out) const
+    {
+#ifdef KLEIN_VALIDATE
+        assert(in.size() >= size() && "Too few points for the motor batch");
+#endif
+        out.resize(size());
+        detail::sw312_soa_motors(data(),
+                                 stride(),
+                                 in.data(),
+                                 in.stride(),
+                                 out.data(),
+                                 out.stride(),
+                                 size());
+    }
+
+    /// Conjugates the i-th plane of `in` with the i-th motor of this batch
+    /// for every motor in the batch. `in` must contain at least `size()`
+    /// planes and `out` is resized to `size()`. Aliasing is only permitted
+    /// when `&in == &out` (in place motor application).
+    void operator()(plane_soa const& in, plane_soa& out) const
+    {
+#ifdef KLEIN_VALIDATE
+        assert(in.size() >= size() && "Too few planes for the motor batch");
+#endif
+        out.resize(size());
+        detail::sw012_soa_motors(data(),
+                                 stride(),
+                                 in.data(),
+                                 in.stride(),
+                                 out.data(),
+                                 out.stride(),
+                                 size());
+    }
+
+private:
+    detail::soa_buffer<8> buf_;
+};
+
+/// Composes two motor batches element by element such that `out[i] = a[i] *
+/// b[i]`. Both inputs must have the same size and `out` is resized to match.
+/// Any of the three batches may alias one another.
+inline void compose(motor_soa const& a, motor_soa const& b, motor_soa& out)
+{
+#ifdef KLEIN_VALIDATE
+    assert(a.size() == b.size() && "Motor batches must have the same size");
+#endif
+    out.resize(a.size());
+    detail::gpMM_soa(a.data(),
+                     a.stride(),
+                     b.data(),
+                     b.stride(),
+                     out.data(),
+                     out.stride(),
+                     a.size());
+}
+
+/// Element-wise composition of two motor batches (see `compose`).
+[[nodiscard]] inline motor_soa operator*(motor_soa const& a,
+                                         motor_soa const& b)
+{
+    motor_soa out;
+    compose(a, b, out);
+    return out;
+}
+/// @}
+} // namespace kln
@@ -0,0 +1,265 @@
+// File: parallel.hpp
+// Include this header to split batch routines across threads. This header is
+// not included by klein.hpp since it depends on <thread> (link against the
+// platform threading library, e.g. Threads::Threads in CMake).
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kln
+{
+namespace parallel
+{
+/// \defgroup parallel Parallel Batches
+///
+/// The array overloads of Klein (such as `motor::operator()(point*, point*,
+/// size_t)`) run on the calling thread. The `kln::parallel` front end splits
+/// such a call into tiles and hands the tiles to an _executor_, which is any
+/// callable `ex(size_t count, kln::parallel::job const& j)` that invokes
+/// `j(i)` exactly once for every `i` in `[0, count)` and returns once all
+/// invocations have completed. A simple `thread_pool` is provided, and any
+/// existing job system can be used by wrapping it in a lambda.
+///
+/// Each tile covers roughly `tile_bytes` bytes of output so that a tile's
+/// inputs and outputs stay in the L1 cache. Tile boundaries are placed on
+/// 64-byte boundaries of the output array (when the element size allows it)
+/// so that no cache line of the output is written by two threads.
+///
+/// !!! example
+///
+///     ```c++
+///         #include <klein/parallel.hpp>
+///
+///         kln::parallel::thread_pool pool;
+///
+///         // Equivalent to m(points, points, count), split across the pool
+///         kln::parallel::transform(pool, m, points, points, count);
+///
+///         // Or, hand the tiles to an existing job system
+///         auto ex = [&](size_t n, kln::parallel::job const& j) {
+///             my_job_system.parallel_for(0, n, j);
+///         };
+///         kln::parallel::transform(ex, m, points, points, count);
+///     ```
+///
+/// !!! tip
+///
+///     Batches spanning at most two tiles are processed on the calling thread
+///     without involving the executor.
+
+/// \addtogroup parallel
+/// @{
+
+/// The unit of work handed to an executor. It is invoked with the index of a
+/// tile.
+using job = std::function<void(size_t)>;
+
+/// Approximate number of output bytes per tile.
+constexpr size_t tile_bytes = 16384;
+
+/// A fixed set of worker threads. The thread calling `run` participates in
+/// the work, so a pool of size `n` spawns `n - 1` workers.
+class thread_pool final
+{
+public:
+    /// Create a pool running up to `threads` jobs at once, including the
+    /// calling thread. If `threads` is zero, the number of hardware threads
+    /// is used.
+    explicit thread_pool(size_t threads = 0)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+        }
+        for (size_t i = 1; i < threads; ++i)
+        {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    /// Number of jobs run at once, including the calling thread.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return workers_.size() + 1;
+    }
+
+    /// Invoke `j(i)` for every `i` in `[0, count)` and return once all
+    /// invocations have completed. Calls to `run` from different threads are
+    /// serialized. `j` must not throw and must not call `run` on this pool.
+    void run(size_t count, job const& j)
+    {
+        std::lock_guard<std::mutex> serialize{run_mutex_};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            job_     = &j;
+            count_   = count;
+            pending_ = workers_.size();
+            next_.store(0, std::memory_order_relaxed);
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        drain(j, count);
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        done_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+    /// Executor interface (see above).
+    void operator()(size_t count, job const& j)
+    {
+        run(count, j);
+    }
+
+private:
+    void drain(job const& j, size_t count) noexcept
+    {
+        for (size_t i = next_.fetch_add(1, std::memory_order_relaxed);
+             i < count;
+             i = next_.fetch_add(1, std::memory_order_relaxed))
+        {
+            j(i);
+        }
+    }
+
+    void work()
+    {
+        uint64_t seen = 0;
+        while (true)
+        {
+            job const* j;
+            size_t count;
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                {
+                    return;
+                }
+                seen  = generation_;
+                j     = job_;
+                count = count_;
+            }
+
+            drain(*j, count);
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (--pending_ == 0)
+            {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    job const* job_ = nullptr;
+    size_t count_   = 0;
+    size_t pending_ = 0;
+    std::atomic<size_t> next_{0};
+    uint64_t generation_ = 0;
+    bool stop_           = false;
+};
+
+/// Split `[0, count)` into tiles and call `body(begin, end)` for each tile
+/// through the executor `ex`. `out` is the output array of the batch, with
+/// `element_size` bytes per element, and is used to align the tile boundaries
+/// to cache lines.
+template <typename Executor, typename Body>
+void for_each_tile(Executor&& ex,
+                   size_t count,
+                   size_t element_size,
+                   void const* out,
+                   Body const& body)
+{
+    // Smallest number of elements spanning a whole number of cache lines
+    size_t a = element_size;
+    size_t b = 64;
+    while (b != 0)
+    {
+        size_t r = a % b;
+        a        = b;
+        b        = r;
+    }
+    size_t period = 64 / a;
+
+    size_t tile = tile_bytes / element_size / period * period;
+    if (tile == 0)
+    {
+        tile = period;
+    }
+
+    // Elements preceding the first cache line boundary of the output, which
+    // are merged into the first tile. Without such a boundary (the output is
+    // not aligned to a multiple of the gcd of element_size and 64), no
+    // alignment is attempted.
+    size_t misalign = reinterpret_cast<uintptr_t>(out) % 64;
+    size_t head     = 0;
+    while (head != period && (misalign + head * element_size) % 64 != 0)
+    {
+        ++head;
+    }
+    if (head == period)
+    {
+        head = 0;
+    }
+
+    size_t first = head + tile;
+    if (count <= first + tile)
+    {
+        body(size_t{0}, count);
+        return;
+    }
+
+    size_t tiles = 1 + (count - first + tile - 1) / tile;
+    ex(tiles, job{[&](size_t i) {
+           size_t begin = i == 0 ? 0 : first + (i - 1) * tile;
+           size_t end   = i == 0 ? first : begin + tile;
+           body(begin, end < count ? end : count);
+       }});
+}
+
+/// Evaluate `op(in + begin, out + begin, end - begin)` for tiles covering the
+/// `count` elements through the executor `ex`. `op` is any entity or
+/// function object with an array overload taking an input array, an output
+/// array, and a count, such as a `motor`, `rotor`, or `translator`. As with
+/// the array overloads, `in` and `out` may alias only if they are equal.
+template <typename Executor, typename Op, typename T, typename U>
+void transform(Executor&& ex, Op const& op, T* in, U* out, size_t count)
+{
+    for_each_tile(
+        ex, count, sizeof(U), out, [&](size_t begin, size_t end) {
+            op(in + begin, out + begin, end - begin);
+        });
+}
+/// @}
+} // namespace parallel
+} // namespace kln
@@ -132,6 +132,19 @@ public:
         return out;
     }
 
+    /// Reflect an array of planes through this plane and store the result in
+    /// the output array. Aliasing is only permitted when `in == out` (in place
+    /// reflection).
+    ///
+    /// !!! tip
+    ///
+    ///     When reflecting a list of tightly packed planes, this routine will
+    ///     be *significantly faster* than reflecting each plane individually.
+    void KLN_VEC_CALL operator()(plane* in, plane* out, size_t count) const noexcept
+    {
+        detail::sw00(p0_, &in->p0_, &out->p0_, count);
+    }
+
     /// Reflect line $\ell$ through this plane $p$. The operation
     /// performed via this call operator is an optimized routine equivalent to
     /// the expression $p \ell p$.
@@ -145,6 +158,14 @@ public:
         return out;
     }
 
+    /// Reflect an array of lines through this plane and store the result in
+    /// the output array. Aliasing is only permitted when `in == out` (in place
+    /// reflection).
+    void KLN_VEC_CALL operator()(line* in, line* out, size_t count) const noexcept
+    {
+        detail::sw10(p0_, &in->p1_, &out->p1_, count);
+    }
+
     /// Reflect the point $P$ through this plane $p$. The operation
     /// performed via this call operator is an optimized routine equivalent to
     /// the expression $p P p$.
@@ -155,6 +176,19 @@ public:
         return out;
     }
 
+    /// Reflect an array of points through this plane and store the result in
+    /// the output array. Aliasing is only permitted when `in == out` (in place
+    /// reflection).
+    ///
+    /// !!! tip
+    ///
+    ///     When reflecting a list of tightly packed points, this routine will
+    ///     be *significantly faster* than reflecting each point individually.
+    void KLN_VEC_CALL operator()(point* in, point* out, size_t count) const noexcept
+    {
+        detail::sw30(p0_, &in->p3_, &out->p3_, count);
+    }
+
     /// Plane addition
     plane& KLN_VEC_CALL operator+=(plane b) noexcept
     {
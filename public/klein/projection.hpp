@@ -1,5 +1,6 @@
 #pragma once
 
+#include "detail/projection.hpp"
 #include "inner_product.hpp"
 #include "line.hpp"
 #include "meet.hpp"
@@ -32,6 +33,24 @@ namespace kln
 /// same as the grade of $a$. As this projection occurs in the opposite sense
 /// from what one may have seen before, additional clarification is provided
 /// below.
+///
+/// The projections of points onto lines and planes are evaluated in closed
+/// form without forming the intermediate inner product. Array overloads are
+/// provided for projecting many points at once (e.g. when resolving the
+/// contacts of a physics step), in which case quantities that depend only on
+/// the line or plane are computed once.
+///
+/// !!! example
+///
+///     ```c++
+///         // Project every contact point onto the ground plane
+///         kln::project(contacts.data(), ground, resolved.data(),
+///                      contacts.size());
+///
+///         // Or, project each contact point onto its own contact plane
+///         kln::project(contacts.data(), planes.data(), resolved.data(),
+///                      contacts.size());
+///     ```
 
 /// \addtogroup proj
 /// @{
@@ -39,13 +58,41 @@ namespace kln
 /// Project a point onto a line
 inline point KLN_VEC_CALL project(point a, line b) noexcept
 {
-    return {(a | b) ^ b};
+    return {detail::proj312(a.p3_, b.p1_, b.p2_)};
+}
+
+/// Project `count` points onto the same line. The input and output arrays may
+/// alias.
+inline void project(point const* in, line b, point* out, size_t count) noexcept
+{
+    detail::proj312(&in->p3_, b.p1_, b.p2_, &out->p3_, count);
 }
 
 /// Project a point onto a plane
 inline point KLN_VEC_CALL project(point a, plane b) noexcept
 {
-    return {(a | b) ^ b};
+    return {detail::proj30(a.p3_, b.p0_)};
+}
+
+/// Project `count` points onto the same plane. The input and output arrays
+/// may alias.
+inline void project(point const* in, plane b, point* out, size_t count) noexcept
+{
+    detail::proj30(&in->p3_, b.p0_, &out->p3_, count);
+}
+
+/// Project each of the `count` points onto the plane with the same index such
+/// that `out[i] = project(in[i], planes[i])`. The input and output arrays may
+/// alias.
+inline void project(point const* in,
+                    plane const* planes,
+                    point* out,
+                    size_t count) noexcept
+{
+    for (size_t i = 0; i != count; ++i)
+    {
+        out[i].p3_ = detail::proj30(in[i].p3_, planes[i].p0_);
+    }
 }
 
 /// Project a line onto a plane
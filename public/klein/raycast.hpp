@@ -0,0 +1,258 @@
+#pragma once
+
+#include "detail/raycast.hpp"
+#include "join.hpp"
+#include "soa.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#ifdef KLEIN_VALIDATE
+#    include <cassert>
+#endif
+
+namespace kln
+{
+/// \defgroup raycast Ray Casting
+///
+/// A ray is represented by the `line` it travels along together with its
+/// origin. Constructing the line as the join `o & p` of the origin `o` with a
+/// second point `p` orients the ray from `o` towards `p`. Batches of rays are
+/// stored in a `line_soa` and a `point_soa` holding the origins, and are
+/// intersected with planes and triangles 4, 8, or 16 rays at a time (with SSE,
+/// AVX2, and AVX-512 respectively).
+///
+/// The intersection with a plane is the meet of the plane with the line (see
+/// [Exterior Product](../exterior_product)), normalized. Each ray also
+/// reports the parameter $t$ such that the hit point is $o + t(p - o)$, which
+/// is the distance from the origin to the hit point if the line is
+/// normalized. A ray hits if $0 \leq t < t_{\mathit{max}}$. Rays parallel to
+/// the plane never hit.
+///
+/// Triangles are prepared once as their supporting plane along with three
+/// edge planes, so a ray-triangle test is a ray-plane meet followed by three
+/// plane evaluations.
+///
+/// !!! example
+///
+///     ```c++
+///         // Rays from the camera through each pixel of a picking region
+///         kln::line_soa rays{lines.data(), lines.size()};
+///         kln::point_soa origins{eyes.data(), eyes.size()};
+///
+///         kln::triangle tri{a, b, c};
+///         kln::ray_hits hits;
+///         kln::raycast(rays, origins, tri, hits);
+///
+///         for (size_t i = 0; i != hits.size(); ++i)
+///         {
+///             if (hits.hit(i))
+///             {
+///                 kln::point p = hits.points().get(i);
+///                 float distance = hits.t()[i];
+///             }
+///         }
+///     ```
+
+/// \addtogroup raycast
+/// @{
+
+/// A triangle prepared for ray intersection tests.
+class triangle final
+{
+public:
+    triangle() noexcept = default;
+
+    /// Prepare the triangle with the normalized vertices `a`, `b`, and `c`.
+    /// The vertices must not be collinear.
+    triangle(point a, point b, point c) noexcept
+    {
+        plane support = a & b & c;
+        point normal{
+            _mm_set_ps(support.z(), support.y(), support.x(), 0.f)};
+
+        planes_[0] = support;
+        planes_[1] = scale_edge(b & c & normal, a);
+        planes_[2] = scale_edge(c & a & normal, b);
+        planes_[3] = scale_edge(a & b & normal, c);
+    }
+
+    /// The plane containing the triangle.
+    [[nodiscard]] plane support() const noexcept
+    {
+        return planes_[0];
+    }
+
+    /// The plane containing the edge opposite to vertex `i` and orthogonal to
+    /// the supporting plane. It evaluates to 1 at vertex `i`, such that the
+    /// three edge planes evaluated at a point of the supporting plane are its
+    /// barycentric coordinates.
+    [[nodiscard]] plane edge(size_t i) const noexcept
+    {
+        return planes_[1 + i];
+    }
+
+private:
+    // Scales the edge plane p to evaluate to 1 at the opposite vertex
+    static plane scale_edge(plane p, point opposite) noexcept
+    {
+        p /= p.x() * opposite.x() + p.y() * opposite.y()
+             + p.z() * opposite.z() + p.d();
+        return p;
+    }
+
+    plane planes_[4];
+};
+
+/// The result of casting a batch of rays. Rays that miss have their hit point
+/// and parameter zeroed.
+class ray_hits final
+{
+public:
+    ray_hits() noexcept = default;
+
+    /// Resize the result to hold `count` rays.
+    void resize(size_t count)
+    {
+        points_.resize(count);
+        t_.resize(points_.stride());
+        mask_.resize((points_.stride() + 31) / 32);
+    }
+
+    /// Number of rays in the result.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return points_.size();
+    }
+
+    /// The normalized hit point of each ray.
+    [[nodiscard]] point_soa const& points() const noexcept
+    {
+        return points_;
+    }
+
+    /// The ray parameter of each hit point.
+    [[nodiscard]] float const* t() const noexcept
+    {
+        return t_.data();
+    }
+
+    /// One bit per ray, set if the ray hit. Ray `i` is stored in bit `i % 32`
+    /// of word `i / 32`.
+    [[nodiscard]] uint32_t const* mask() const noexcept
+    {
+        return mask_.data();
+    }
+
+    [[nodiscard]] bool hit(size_t i) const noexcept
+    {
+        return (mask_[i / 32] >> (i % 32)) & 1;
+    }
+
+    [[nodiscard]] point_soa& points() noexcept
+    {
+        return points_;
+    }
+
+    [[nodiscard]] float* t() noexcept
+    {
+        return t_.data();
+    }
+
+    [[nodiscard]] uint32_t* mask() noexcept
+    {
+        return mask_.data();
+    }
+
+private:
+    point_soa points_;
+    std::vector<float> t_;
+    std::vector<uint32_t> mask_;
+};
+
+/// Intersect every ray with the plane `p`. `origins` must contain at least
+/// `rays.size()` normalized points, and `out` is resized to `rays.size()`.
+inline void raycast(line_soa const& rays,
+                    point_soa const& origins,
+                    plane p,
+                    ray_hits& out,
+                    float t_max = std::numeric_limits<float>::infinity())
+{
+#ifdef KLEIN_VALIDATE
+    assert(origins.size() >= rays.size() && "Too few ray origins for the rays");
+#endif
+    out.resize(rays.size());
+    detail::soa_raycast_planes<false>(rays.data(),
+                                      rays.stride(),
+                                      origins.data(),
+                                      origins.stride(),
+                                      p.p0_,
+                                      nullptr,
+                                      0,
+                                      t_max,
+                                      out.points().data(),
+                                      out.points().stride(),
+                                      out.t(),
+                                      out.mask(),
+                                      rays.size());
+}
+
+/// Intersect the i-th ray with the i-th plane for every ray. `origins` and
+/// `planes` must contain at least `rays.size()` elements, and `out` is
+/// resized to `rays.size()`.
+inline void raycast(line_soa const& rays,
+                    point_soa const& origins,
+                    plane_soa const& planes,
+                    ray_hits& out,
+                    float t_max = std::numeric_limits<float>::infinity())
+{
+#ifdef KLEIN_VALIDATE
+    assert(origins.size() >= rays.size() && "Too few ray origins for the rays");
+    assert(planes.size() >= rays.size() && "Too few planes for the rays");
+#endif
+    out.resize(rays.size());
+    detail::soa_raycast_planes<true>(rays.data(),
+                                     rays.stride(),
+                                     origins.data(),
+                                     origins.stride(),
+                                     _mm_setzero_ps(),
+                                     planes.data(),
+                                     planes.stride(),
+                                     t_max,
+                                     out.points().data(),
+                                     out.points().stride(),
+                                     out.t(),
+                                     out.mask(),
+                                     rays.size());
+}
+
+/// Intersect every ray with the triangle `tri`. Both faces of the triangle
+/// are hit. `origins` must contain at least `rays.size()` normalized points,
+/// and `out` is resized to `rays.size()`.
+inline void raycast(line_soa const& rays,
+                    point_soa const& origins,
+                    triangle const& tri,
+                    ray_hits& out,
+                    float t_max = std::numeric_limits<float>::infinity())
+{
+#ifdef KLEIN_VALIDATE
+    assert(origins.size() >= rays.size() && "Too few ray origins for the rays");
+#endif
+    out.resize(rays.size());
+    __m128 planes[4] = {
+        tri.support().p0_, tri.edge(0).p0_, tri.edge(1).p0_, tri.edge(2).p0_};
+    detail::soa_raycast_triangle(rays.data(),
+                                 rays.stride(),
+                                 origins.data(),
+                                 origins.stride(),
+                                 planes,
+                                 t_max,
+                                 out.points().data(),
+                                 out.points().stride(),
+                                 out.t(),
+                                 out.mask(),
+                                 rays.size());
+}
+/// @}
+} // namespace kln
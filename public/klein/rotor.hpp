@@ -6,6 +6,7 @@
 #include "mat4x4.hpp"
 #include "plane.hpp"
 #include "point.hpp"
+#include "soa.hpp"
 #include "util.hpp"
 #include <cmath>
 
@@ -347,6 +348,36 @@ public:
         detail::sw012<true, false>(&in->p3_, p1_, nullptr, &out->p3_, count);
     }
 
+    /// Conjugates a structure-of-arrays batch of points with this rotor and
+    /// stores the result in `out`, which is resized to match `in`. Aliasing is
+    /// only permitted when `&in == &out` (in place rotor application).
+    void operator()(point_soa const& in, point_soa& out) const
+    {
+        out.resize(in.size());
+        detail::sw312_soa<false>(p1_,
+                                 nullptr,
+                                 in.data(),
+                                 in.stride(),
+                                 out.data(),
+                                 out.stride(),
+                                 in.size());
+    }
+
+    /// Conjugates a structure-of-arrays batch of planes with this rotor and
+    /// stores the result in `out`, which is resized to match `in`. Aliasing is
+    /// only permitted when `&in == &out` (in place rotor application).
+    void operator()(plane_soa const& in, plane_soa& out) const
+    {
+        out.resize(in.size());
+        detail::sw012_soa<false>(p1_,
+                                 nullptr,
+                                 in.data(),
+                                 in.stride(),
+                                 out.data(),
+                                 out.stride(),
+                                 in.size());
+    }
+
     /// Rotor addition
     rotor& KLN_VEC_CALL operator+=(rotor b) noexcept
     {
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "detail/sandwich.hpp"
+#include "detail/sse.hpp"
+#include "motor.hpp"
+#include "point.hpp"
+
+#include <cstdint>
+
+namespace kln
+{
+/// \defgroup skinning Skinning
+///
+/// The array call operators on `motor` apply a single motor to many entities.
+/// Skeletal animation instead needs a *different* motor per vertex, selected
+/// through a bone index. The routines here gather the motor for each point
+/// from a palette, and optionally blend up to four weighted motors per point
+/// before application (dual-quaternion linear blending expressed with motors).
+///
+/// !!! example
+///
+///     ```c++
+///         // One world-space motor per joint, updated once per frame
+///         std::vector<kln::motor> palette = pose_skeleton();
+///
+///         // Rigid skinning: one joint index per vertex
+///         kln::skin(palette.data(), joint_indices.data(),
+///                   bind_pose.data(), skinned.data(), vertex_count);
+///
+///         // Blended skinning: four joint indices and weights per vertex
+///         kln::skin(palette.data(), joint_indices4.data(), weights4.data(),
+///                   bind_pose.data(), skinned.data(), vertex_count);
+///     ```
+
+/// \addtogroup skinning
+/// @{
+
+/// Conjugates each point `in[i]` with the motor `motors[indices[i]]` and stores
+/// the result in `out[i]`. Aliasing is only permitted when `in == out` (in
+/// place application).
+///
+/// !!! tip
+///
+///     The motor-dependent portion of the sandwich is only recomputed when the
+///     index changes between consecutive points, so sorting vertices by their
+///     joint index makes this routine approach the throughput of the
+///     single-motor array overload.
+inline void skin(motor const* motors,
+                 uint32_t const* indices,
+                 point const* in,
+                 point* out,
+                 size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    detail::sw312_state state;
+    uint32_t current = indices[0];
+    detail::sw312_prepare(motors[current].p1_, motors[current].p2_, state);
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        if (indices[i] != current)
+        {
+            current = indices[i];
+            detail::sw312_prepare(
+                motors[current].p1_, motors[current].p2_, state);
+        }
+        out[i].p3_ = detail::sw312_apply(state, in[i].p3_);
+    }
+}
+
+/// Blends up to four motors per point and conjugates the point with the
+/// normalized blend. For the point `in[i]`, the influences are given by
+/// `indices[4 * i + k]` and `weights[4 * i + k]` for `k` in `[0, 4)`. Each
+/// influence is flipped onto the hemisphere of the first influence prior to
+/// blending so that motors representing the same action with opposite signs do
+/// not cancel. Aliasing is only permitted when `in == out` (in place
+/// application).
+///
+/// !!! danger
+///
+///     Unused influences must have a weight of zero but still refer to a valid
+///     motor (e.g. index 0). Influences are blended without branching.
+inline void skin(motor const* motors,
+                 uint32_t const* indices,
+                 float const* weights,
+                 point const* in,
+                 point* out,
+                 size_t count) noexcept
+{
+    __m128 sign_mask = _mm_set1_ps(-0.f);
+    detail::sw312_state state;
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        uint32_t const* idx = indices + 4 * i;
+        __m128 w            = _mm_loadu_ps(weights + 4 * i);
+
+        motor const& m0 = motors[idx[0]];
+        motor blend;
+        __m128 w0 = KLN_SWIZZLE(w, 0, 0, 0, 0);
+        blend.p1_ = _mm_mul_ps(m0.p1_, w0);
+        blend.p2_ = _mm_mul_ps(m0.p2_, w0);
+
+        // Remaining influences are weighted by (w1, w2, w3) with the sign of
+        // each weight flipped if its rotor lies in the opposite hemisphere.
+        motor const& m1 = motors[idx[1]];
+        motor const& m2 = motors[idx[2]];
+        motor const& m3 = motors[idx[3]];
+        __m128 w1       = KLN_SWIZZLE(w, 1, 1, 1, 1);
+        __m128 w2       = KLN_SWIZZLE(w, 2, 2, 2, 2);
+        __m128 w3       = KLN_SWIZZLE(w, 3, 3, 3, 3);
+        w1 = _mm_xor_ps(
+            w1, _mm_and_ps(detail::dp_bc(m0.p1_, m1.p1_), sign_mask));
+        w2 = _mm_xor_ps(
+            w2, _mm_and_ps(detail::dp_bc(m0.p1_, m2.p1_), sign_mask));
+        w3 = _mm_xor_ps(
+            w3, _mm_and_ps(detail::dp_bc(m0.p1_, m3.p1_), sign_mask));
+
+        blend.p1_ = _mm_add_ps(blend.p1_, _mm_mul_ps(m1.p1_, w1));
+        blend.p2_ = _mm_add_ps(blend.p2_, _mm_mul_ps(m1.p2_, w1));
+        blend.p1_ = _mm_add_ps(blend.p1_, _mm_mul_ps(m2.p1_, w2));
+        blend.p2_ = _mm_add_ps(blend.p2_, _mm_mul_ps(m2.p2_, w2));
+        blend.p1_ = _mm_add_ps(blend.p1_, _mm_mul_ps(m3.p1_, w3));
+        blend.p2_ = _mm_add_ps(blend.p2_, _mm_mul_ps(m3.p2_, w3));
+
+        blend.normalize();
+        detail::sw312_prepare(blend.p1_, blend.p2_, state);
+        out[i].p3_ = detail::sw312_apply(state, in[i].p3_);
+    }
+}
+/// @}
+} // namespace kln
@@ -0,0 +1,656 @@
+#pragma once
+
+#include "detail/soa.hpp"
+#include "detail/sse.hpp"
+#include "line.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace kln
+{
+/// \defgroup soa Structure-of-Arrays Batches
+///
+/// The `point_soa`, `plane_soa`, and `line_soa` containers store a batch of
+/// entities as separate component streams rather than as an array of `__m128`
+/// registers. When a motor or rotor is applied to one of these batches, the
+/// motor-dependent coefficients are computed once and every register lane
+/// processes a different entity, so the inner loop consists entirely of
+/// broadcast multiply-adds without any shuffles. When compiled with AVX2
+/// support (via the `klein_avx2` target or the `KLEIN_AVX2` define), 8 entities
+/// are transformed per instruction, and with AVX-512 support (via the
+/// `klein_avx512` target or the `KLEIN_AVX512` define), 16 entities are.
+///
+/// !!! example
+///
+///     ```c++
+///         std::vector<kln::point> vertices = load_vertices();
+///
+///         // Transpose the vertices into component streams once
+///         kln::point_soa batch{vertices.data(), vertices.size()};
+///
+///         // Transform the entire batch in place
+///         kln::motor m = r * t;
+///         m(batch, batch);
+///
+///         // Individual elements can be read back as needed
+///         kln::point p = batch.get(0);
+///     ```
+///
+/// !!! tip
+///
+///     Streams are padded to a multiple of 16 floats and the padding lanes are
+///     kept zeroed, so the raw stream pointers may be handed directly to other
+///     SIMD routines that process whole cache lines.
+
+namespace detail
+{
+    // Streams are allocated by hand rather than as an array of an alignas(64)
+    // type because operator new only honours extended alignments from C++17
+    // onward. The block is over-allocated and the address of the allocation
+    // is kept just below the aligned pointer that is handed out.
+    struct soa_free
+    {
+        void operator()(float* p) const noexcept
+        {
+            ::operator delete(reinterpret_cast<void**>(p)[-1]);
+        }
+    };
+
+    // Allocate count floats aligned to 64 bytes
+    inline std::unique_ptr<float, soa_free> soa_alloc(size_t count)
+    {
+        void* raw = ::operator new(count * sizeof(float) + 64 + sizeof(void*));
+        uintptr_t addr = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        addr           = (addr + 63) & ~static_cast<uintptr_t>(63);
+
+        float* out                        = reinterpret_cast<float*>(addr);
+        reinterpret_cast<void**>(out)[-1] = raw;
+        return std::unique_ptr<float, soa_free>{out};
+    }
+
+    // Storage for entities made of Streams / 4 registers, each of which is
+    // transposed into four consecutive streams.
+    template <size_t Streams>
+    class soa_buffer
+    {
+    public:
+        soa_buffer() noexcept = default;
+
+        soa_buffer(soa_buffer const& other)
+        {
+            *this = other;
+        }
+
+        soa_buffer(soa_buffer&& other) noexcept = default;
+
+        soa_buffer& operator=(soa_buffer const& other)
+        {
+            if (this != &other)
+            {
+                // Discard the current contents so that resizing zeroes every
+                // lane before the copy
+                blocks_.reset();
+                size_   = 0;
+                stride_ = 0;
+                resize(other.size_);
+                for (size_t i = 0; i != Streams && size_ > 0; ++i)
+                {
+                    std::memcpy(data() + i * stride_,
+                                other.data() + i * other.stride_,
+                                size_ * sizeof(float));
+                }
+            }
+            return *this;
+        }
+
+        soa_buffer& operator=(soa_buffer&& other) noexcept = default;
+
+        // Resizing preserves the first min(size, count) elements and zeroes
+        // all other lanes up to the padded stride.
+        void resize(size_t count)
+        {
+            size_t stride = (count + soa_pad - 1) / soa_pad * soa_pad;
+            if (stride > stride_)
+            {
+                std::unique_ptr<float, soa_free> blocks
+                    = soa_alloc(Streams * stride);
+                float* dst = blocks.get();
+                std::memset(dst, 0, Streams * stride * sizeof(float));
+                for (size_t i = 0; i != Streams; ++i)
+                {
+                    if (size_ > 0)
+                    {
+                        std::memcpy(dst + i * stride,
+                                    data() + i * stride_,
+                                    size_ * sizeof(float));
+                    }
+                }
+                blocks_ = std::move(blocks);
+                stride_ = stride;
+            }
+            else if (count < size_)
+            {
+                for (size_t i = 0; i != Streams; ++i)
+                {
+                    std::memset(data() + i * stride_ + count,
+                                0,
+                                (size_ - count) * sizeof(float));
+                }
+            }
+            size_ = count;
+        }
+
+        float* data() noexcept
+        {
+            return blocks_.get();
+        }
+
+        float const* data() const noexcept
+        {
+            return blocks_.get();
+        }
+
+        size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        size_t stride() const noexcept
+        {
+            return stride_;
+        }
+
+        // Transpose count entities of Streams / 4 registers each into the
+        // streams
+        void load(__m128 const* in, size_t count) noexcept
+        {
+            for (size_t g = 0; g != groups; ++g)
+            {
+                float* s0 = data() + 4 * g * stride_;
+                float* s1 = s0 + stride_;
+                float* s2 = s1 + stride_;
+                float* s3 = s2 + stride_;
+
+                // The register layout is (e123, e032, e013, e021) for points
+                // and (e0, e1, e2, e3) for planes, so the low component is
+                // routed to the last stream.
+                size_t i    = 0;
+                size_t body = count & ~size_t{3};
+                for (; i != body; i += 4)
+                {
+                    __m128 r0 = in[i * groups + g];
+                    __m128 r1 = in[(i + 1) * groups + g];
+                    __m128 r2 = in[(i + 2) * groups + g];
+                    __m128 r3 = in[(i + 3) * groups + g];
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    _mm_storeu_ps(s3 + i, r0);
+                    _mm_storeu_ps(s0 + i, r1);
+                    _mm_storeu_ps(s1 + i, r2);
+                    _mm_storeu_ps(s2 + i, r3);
+                }
+
+                for (; i != count; ++i)
+                {
+                    set(i, in[i * groups + g], g);
+                }
+            }
+        }
+
+        // Transpose the streams back into size() entities of Streams / 4
+        // registers each
+        void store(__m128* out) const noexcept
+        {
+            for (size_t g = 0; g != groups; ++g)
+            {
+                float const* s0 = data() + 4 * g * stride_;
+                float const* s1 = s0 + stride_;
+                float const* s2 = s1 + stride_;
+                float const* s3 = s2 + stride_;
+
+                size_t i = 0;
+                for (; i + 4 <= size_; i += 4)
+                {
+                    __m128 r0 = _mm_loadu_ps(s3 + i);
+                    __m128 r1 = _mm_loadu_ps(s0 + i);
+                    __m128 r2 = _mm_loadu_ps(s1 + i);
+                    __m128 r3 = _mm_loadu_ps(s2 + i);
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    out[i * groups + g]       = r0;
+                    out[(i + 1) * groups + g] = r1;
+                    out[(i + 2) * groups + g] = r2;
+                    out[(i + 3) * groups + g] = r3;
+                }
+
+                for (; i != size_; ++i)
+                {
+                    out[i * groups + g] = get(i, g);
+                }
+            }
+        }
+
+        // Write register g of entity i
+        void set(size_t i, __m128 in, size_t g = 0) noexcept
+        {
+            float buf[4];
+            _mm_storeu_ps(buf, in);
+            float* s       = data() + 4 * g * stride_ + i;
+            s[0]           = buf[1];
+            s[stride_]     = buf[2];
+            s[2 * stride_] = buf[3];
+            s[3 * stride_] = buf[0];
+        }
+
+        // Read register g of entity i
+        __m128 get(size_t i, size_t g = 0) const noexcept
+        {
+            float const* s = data() + 4 * g * stride_ + i;
+            return _mm_set_ps(s[2 * stride_], s[stride_], s[0], s[3 * stride_]);
+        }
+
+    private:
+        static constexpr size_t groups = Streams / 4;
+
+        std::unique_ptr<float, soa_free> blocks_;
+        size_t size_   = 0;
+        size_t stride_ = 0;
+    };
+} // namespace detail
+
+/// \addtogroup soa
+/// @{
+
+/// A batch of points stored as separate `x`, `y`, `z`, and `w` streams.
+class point_soa final
+{
+public:
+    point_soa() noexcept = default;
+
+    /// Create a batch of `count` zero-initialized points.
+    explicit point_soa(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Create a batch by transposing `count` tightly packed points.
+    point_soa(point const* in, size_t count)
+    {
+        load(in, count);
+    }
+
+    /// Resize the batch, preserving existing elements. Newly added elements
+    /// are zero-initialized.
+    void resize(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Replace the contents of this batch with `count` tightly packed points.
+    void load(point const* in, size_t count)
+    {
+        buf_.resize(count);
+        if (count > 0)
+        {
+            buf_.load(&in->p3_, count);
+        }
+    }
+
+    /// Transpose the batch back into `size()` tightly packed points.
+    void store(point* out) const noexcept
+    {
+        buf_.store(&out->p3_);
+    }
+
+    [[nodiscard]] point get(size_t i) const noexcept
+    {
+        return {buf_.get(i)};
+    }
+
+    void set(size_t i, point const& p) noexcept
+    {
+        buf_.set(i, p.p3_);
+    }
+
+    /// Number of points in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /// Distance in floats between consecutive streams. This is the size
+    /// rounded up to a multiple of 16.
+    [[nodiscard]] size_t stride() const noexcept
+    {
+        return buf_.stride();
+    }
+
+    /// Pointer to the start of the stream buffer. The `x`, `y`, `z`, and `w`
+    /// streams follow one another, separated by `stride()` floats.
+    [[nodiscard]] float* data() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* data() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* x() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* x() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* y() noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float const* y() const noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float* z() noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float const* z() const noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    /// The homogeneous coordinate stream
+    [[nodiscard]] float* w() noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+    [[nodiscard]] float const* w() const noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+private:
+    detail::soa_buffer<4> buf_;
+};
+
+/// A batch of planes stored as separate `x`, `y`, `z`, and `d` streams
+/// corresponding to the plane equation $ax + by + cz + d = 0$.
+class plane_soa final
+{
+public:
+    plane_soa() noexcept = default;
+
+    /// Create a batch of `count` zero-initialized planes.
+    explicit plane_soa(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Create a batch by transposing `count` tightly packed planes.
+    plane_soa(plane const* in, size_t count)
+    {
+        load(in, count);
+    }
+
+    /// Resize the batch, preserving existing elements. Newly added elements
+    /// are zero-initialized.
+    void resize(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Replace the contents of this batch with `count` tightly packed planes.
+    void load(plane const* in, size_t count)
+    {
+        buf_.resize(count);
+        if (count > 0)
+        {
+            buf_.load(&in->p0_, count);
+        }
+    }
+
+    /// Transpose the batch back into `size()` tightly packed planes.
+    void store(plane* out) const noexcept
+    {
+        buf_.store(&out->p0_);
+    }
+
+    [[nodiscard]] plane get(size_t i) const noexcept
+    {
+        return {buf_.get(i)};
+    }
+
+    void set(size_t i, plane const& p) noexcept
+    {
+        buf_.set(i, p.p0_);
+    }
+
+    /// Number of planes in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /// Distance in floats between consecutive streams. This is the size
+    /// rounded up to a multiple of 16.
+    [[nodiscard]] size_t stride() const noexcept
+    {
+        return buf_.stride();
+    }
+
+    /// Pointer to the start of the stream buffer. The `x`, `y`, `z`, and `d`
+    /// streams follow one another, separated by `stride()` floats.
+    [[nodiscard]] float* data() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* data() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* x() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* x() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* y() noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float const* y() const noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float* z() noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float const* z() const noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float* d() noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+    [[nodiscard]] float const* d() const noexcept
+    {
+        return buf_.data() + 3 * stride();
+    }
+
+private:
+    detail::soa_buffer<4> buf_;
+};
+
+/// A batch of lines stored as separate `e23`, `e31`, `e12`, `e01`, `e02`, and
+/// `e03` streams. The streams are laid out as in `motor_soa`, with the
+/// `scalar` and `e0123` slots (always zero for a line) left in place so that
+/// the stream of a given component is found at the same offset in both.
+class line_soa final
+{
+public:
+    line_soa() noexcept = default;
+
+    /// Create a batch of `count` zero-initialized lines.
+    explicit line_soa(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Create a batch by transposing `count` tightly packed lines.
+    line_soa(line const* in, size_t count)
+    {
+        load(in, count);
+    }
+
+    /// Resize the batch, preserving existing elements. Newly added elements
+    /// are zero-initialized.
+    void resize(size_t count)
+    {
+        buf_.resize(count);
+    }
+
+    /// Replace the contents of this batch with `count` tightly packed lines.
+    void load(line const* in, size_t count)
+    {
+        buf_.resize(count);
+        if (count > 0)
+        {
+            buf_.load(&in->p1_, count);
+        }
+    }
+
+    /// Transpose the batch back into `size()` tightly packed lines.
+    void store(line* out) const noexcept
+    {
+        buf_.store(&out->p1_);
+    }
+
+    [[nodiscard]] line get(size_t i) const noexcept
+    {
+        line out;
+        out.p1_ = buf_.get(i, 0);
+        out.p2_ = buf_.get(i, 1);
+        return out;
+    }
+
+    void set(size_t i, line const& l) noexcept
+    {
+        buf_.set(i, l.p1_, 0);
+        buf_.set(i, l.p2_, 1);
+    }
+
+    /// Number of lines in the batch.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return buf_.size();
+    }
+
+    /// Distance in floats between consecutive streams. This is the size
+    /// rounded up to a multiple of 16.
+    [[nodiscard]] size_t stride() const noexcept
+    {
+        return buf_.stride();
+    }
+
+    /// Pointer to the start of the stream buffer. The eight streams follow one
+    /// another, separated by `stride()` floats.
+    [[nodiscard]] float* data() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* data() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* e23() noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float const* e23() const noexcept
+    {
+        return buf_.data();
+    }
+
+    [[nodiscard]] float* e31() noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float const* e31() const noexcept
+    {
+        return buf_.data() + stride();
+    }
+
+    [[nodiscard]] float* e12() noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float const* e12() const noexcept
+    {
+        return buf_.data() + 2 * stride();
+    }
+
+    [[nodiscard]] float* e01() noexcept
+    {
+        return buf_.data() + 4 * stride();
+    }
+
+    [[nodiscard]] float const* e01() const noexcept
+    {
+        return buf_.data() + 4 * stride();
+    }
+
+    [[nodiscard]] float* e02() noexcept
+    {
+        return buf_.data() + 5 * stride();
+    }
+
+    [[nodiscard]] float const* e02() const noexcept
+    {
+        return buf_.data() + 5 * stride();
+    }
+
+    [[nodiscard]] float* e03() noexcept
+    {
+        return buf_.data() + 6 * stride();
+    }
+
+    [[nodiscard]] float const* e03() const noexcept
+    {
+        return buf_.data() + 6 * stride();
+    }
+
+private:
+    detail::soa_buffer<8> buf_;
+};
+/// @}
+} // namespace kln
@@ -104,6 +104,25 @@ public:
         return out;
     }
 
+    /// Conjugates an array of planes with this translator in the input array
+    /// and stores the result in the output array. Aliasing is only permitted
+    /// when `in == out` (in place translator application).
+    ///
+    /// !!! tip
+    ///
+    ///     When applying a translator to a list of tightly packed planes, this
+    ///     routine will be *significantly faster* than applying the translator
+    ///     to each plane individually.
+    void KLN_VEC_CALL operator()(plane* in, plane* out, size_t count) const noexcept
+    {
+#ifdef KLEIN_SSE_4_1
+        __m128 tmp = _mm_blend_ps(p2_, _mm_set_ss(1.f), 1);
+#else
+        __m128 tmp = _mm_add_ps(p2_, _mm_set_ss(1.f));
+#endif
+        detail::sw02(&in->p0_, tmp, &out->p0_, count);
+    }
+
     /// Conjugates a line $\ell$ with this translator and returns the result
     /// $t\ell\widetilde{t}$.
     [[nodiscard]] line KLN_VEC_CALL operator()(line const& l) const noexcept
@@ -113,6 +132,14 @@ public:
         return out;
     }
 
+    /// Conjugates an array of lines with this translator in the input array
+    /// and stores the result in the output array. Aliasing is only permitted
+    /// when `in == out` (in place translator application).
+    void KLN_VEC_CALL operator()(line* in, line* out, size_t count) const noexcept
+    {
+        detail::swL2(&in->p1_, p2_, &out->p1_, count);
+    }
+
     /// Conjugates a point $p$ with this translator and returns the result
     /// $tp\widetilde{t}$.
     [[nodiscard]] point KLN_VEC_CALL operator()(point const& p) const noexcept
@@ -122,6 +149,20 @@ public:
         return out;
     }
 
+    /// Conjugates an array of points with this translator in the input array
+    /// and stores the result in the output array. Aliasing is only permitted
+    /// when `in == out` (in place translator application).
+    ///
+    /// !!! tip
+    ///
+    ///     When applying a translator to a list of tightly packed points, this
+    ///     routine will be *significantly faster* than applying the translator
+    ///     to each point individually.
+    void KLN_VEC_CALL operator()(point* in, point* out, size_t count) const noexcept
+    {
+        detail::sw32(&in->p3_, p2_, &out->p3_, count);
+    }
+
     /// Translator addition
     translator& KLN_VEC_CALL operator+=(translator b) noexcept
     {
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "detail/sandwich.hpp"
+#include "detail/sse.hpp"
+#include "motor.hpp"
+#include "rotor.hpp"
+
+#include <cstddef>
+
+namespace kln
+{
+/// \defgroup vertex_buffer Vertex Buffers
+///
+/// The array call operators on `motor` and `rotor` expect tightly packed
+/// `point` and `direction` arrays. Vertex buffers destined for the GPU instead
+/// interleave several attributes per vertex (position, normal, tangent,
+/// texture coordinates, ...) as plain floats. The routines here transform
+/// such buffers in place, given the byte stride between vertices and the byte
+/// offset of each attribute within a vertex. Each attribute is a triple of
+/// floats $(x, y, z)$. The position is transformed as a point while normals
+/// and tangents are transformed as directions (i.e. they are only rotated).
+/// Every attribute of a vertex is transformed before moving on to the next
+/// vertex, so the buffer is traversed once.
+///
+/// !!! example
+///
+///     ```c++
+///         struct vertex
+///         {
+///             float position[3];
+///             float normal[3];
+///             float tangent[3];
+///             float uv[2];
+///         };
+///
+///         size_t directions[2] = {offsetof(vertex, normal),
+///                                 offsetof(vertex, tangent)};
+///         kln::transform_vertices(m, vertices.data(), vertices.size(),
+///                                 sizeof(vertex), offsetof(vertex, position),
+///                                 directions, 2);
+///     ```
+///
+/// !!! danger
+///
+///     The motor or rotor must be normalized. The homogeneous weight of each
+///     transformed position is discarded rather than divided through.
+
+/// \addtogroup vertex_buffer
+/// @{
+
+/// Pass as the position offset when the vertices have no position attribute.
+constexpr size_t no_attribute = ~size_t{0};
+
+/// Conjugates the attributes of `count` interleaved vertices with the motor
+/// `m` in place. The vertex `i` begins `i * stride` bytes past `vertices`.
+/// The float triple at `position_offset` bytes into each vertex is
+/// transformed as a point (unless `position_offset` is `no_attribute`), and
+/// the triples at each of the `direction_count` offsets in
+/// `direction_offsets` are transformed as directions. Attributes need only be
+/// aligned to 4 bytes.
+inline void transform_vertices(motor const& m,
+                               void* vertices,
+                               size_t count,
+                               size_t stride,
+                               size_t position_offset,
+                               size_t const* direction_offsets = nullptr,
+                               size_t direction_count = 0) noexcept
+{
+    detail::sw312_state state;
+    detail::sw312_prepare(m.p1_, m.p2_, state);
+    detail::sw312_vertices(state,
+                           static_cast<unsigned char*>(vertices),
+                           count,
+                           stride,
+                           position_offset,
+                           direction_offsets,
+                           direction_count);
+}
+
+/// Rotates the attributes of `count` interleaved vertices with the rotor `r`
+/// in place. See the motor overload for the meaning of the arguments.
+inline void transform_vertices(rotor const& r,
+                               void* vertices,
+                               size_t count,
+                               size_t stride,
+                               size_t position_offset,
+                               size_t const* direction_offsets = nullptr,
+                               size_t direction_count = 0) noexcept
+{
+    detail::sw312_state state;
+    detail::sw312_prepare(r.p1_, _mm_setzero_ps(), state);
+    detail::sw312_vertices(state,
+                           static_cast<unsigned char*>(vertices),
+                           count,
+                           stride,
+                           position_offset,
+                           direction_offsets,
+                           direction_count);
+}
+/// @}
+} // namespace kln
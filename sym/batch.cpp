@@ -0,0 +1,419 @@
+#include "batch.hpp"
+
+#include "repl.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+namespace
+{
+// Bumped whenever the output of the shell changes
+constexpr char cache_header[] = "klein_shell cache 1";
+
+struct cached_output
+{
+    std::string out;
+    std::string err;
+};
+
+using cache = std::map<uint64_t, cached_output>;
+
+struct line_task
+{
+    std::string text;
+    size_t file   = 0;
+    size_t number = 0; // Line number within the file (starting from 1)
+
+    // Name bound by a .let or .values line
+    std::string defines;
+    bool defines_values = false;
+
+    // The lines defining the names this line mentions, and the lines
+    // mentioning the name defined by this line
+    std::vector<size_t> deps;
+    std::vector<size_t> dependents;
+
+    uint64_t key = 0;
+
+    // A line must be evaluated if its output is not cached or if a line that
+    // must be evaluated depends on it
+    bool needed = false;
+
+    std::string out;
+    std::string err;
+
+    // Multivector or values bound by the line once it is evaluated
+    bool bound = false;
+    mv value;
+    bool has_values = false;
+    std::vector<float> values;
+
+    size_t pending = 0;
+    bool done      = false;
+};
+
+uint64_t fnv1a(uint64_t h, void const* data, size_t size) noexcept
+{
+    auto bytes = static_cast<unsigned char const*>(data);
+    for (size_t i = 0; i != size; ++i)
+    {
+        h = (h ^ bytes[i]) * 0x100000001b3;
+    }
+    return h;
+}
+
+cache load_cache(std::string const& path)
+{
+    cache out;
+    std::ifstream is{path, std::ios::binary};
+    std::string header;
+    if (!is || !std::getline(is, header) || header != cache_header)
+    {
+        return out;
+    }
+
+    uint64_t key;
+    size_t out_size;
+    size_t err_size;
+    while (is >> std::hex >> key >> std::dec >> out_size >> err_size
+           && is.get() == '\n')
+    {
+        cached_output entry;
+        entry.out.resize(out_size);
+        entry.err.resize(err_size);
+        if (!is.read(&entry.out[0], out_size)
+            || !is.read(&entry.err[0], err_size))
+        {
+            break;
+        }
+        out.emplace(key, std::move(entry));
+    }
+    return out;
+}
+
+// The cache is replaced rather than appended to so that it only holds the
+// lines of the latest run
+void save_cache(std::string const& path, std::vector<line_task> const& tasks)
+{
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream os{temp, std::ios::binary};
+        os << cache_header << '\n';
+
+        std::set<uint64_t> written;
+        for (auto const& t : tasks)
+        {
+            if (written.insert(t.key).second)
+            {
+                os << std::hex << t.key << std::dec << ' ' << t.out.size()
+                   << ' ' << t.err.size() << '\n'
+                   << t.out << t.err;
+            }
+        }
+
+        if (!os)
+        {
+            std::cerr << "Unable to write " << temp << '\n';
+            return;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "Unable to write " << path << '\n';
+    }
+}
+
+// Fill in the name defined by the line, the lines it depends on, and its key.
+// A name is considered mentioned if it appears as an identifier anywhere in
+// the line, which may add dependencies that are not strictly needed but
+// never misses one.
+void analyze(std::vector<line_task>& tasks,
+             size_t i,
+             std::map<std::string, size_t>& definitions)
+{
+    line_task& t = tasks[i];
+
+    size_t start = t.text.find_first_not_of(" \t\r\n\v\f");
+    if (start != std::string::npos && t.text[start] != '#')
+    {
+        for (size_t j = start; j < t.text.size();)
+        {
+            if (!std::isalpha(static_cast<unsigned char>(t.text[j])))
+            {
+                ++j;
+                continue;
+            }
+
+            size_t end = j;
+            while (end != t.text.size()
+                   && std::isalnum(static_cast<unsigned char>(t.text[end])))
+            {
+                ++end;
+            }
+
+            auto it = definitions.find(t.text.substr(j, end - j));
+            if (it != definitions.end())
+            {
+                t.deps.push_back(it->second);
+            }
+            j = end;
+        }
+
+        // Parsed the same way as repl::command
+        std::istringstream is{t.text};
+        std::string cmd;
+        std::string name;
+        std::string eq;
+        is >> cmd >> name >> eq;
+        if ((cmd == ".let" || cmd == ".values") && !name.empty()
+            && eq == "=")
+        {
+            t.defines        = name;
+            t.defines_values = cmd == ".values";
+        }
+
+        // Variables with values may also be reached through bindings that
+        // mention them, so numeric commands depend on all of them
+        if (cmd == ".eval" || cmd == ".check")
+        {
+            for (auto&& [var, d] : definitions)
+            {
+                if (tasks[d].defines_values)
+                {
+                    t.deps.push_back(d);
+                }
+            }
+        }
+
+        std::sort(t.deps.begin(), t.deps.end());
+        t.deps.erase(std::unique(t.deps.begin(), t.deps.end()), t.deps.end());
+    }
+
+    t.key = fnv1a(0xcbf29ce484222325, t.text.data(), t.text.size());
+    for (size_t d : t.deps)
+    {
+        t.key = fnv1a(t.key, &tasks[d].key, sizeof(uint64_t));
+    }
+
+    if (!t.defines.empty())
+    {
+        definitions[t.defines] = i;
+    }
+}
+
+void evaluate(std::vector<line_task>& tasks, size_t i, algebra const& a)
+{
+    line_task& t = tasks[i];
+
+    bindings b;
+    samples s;
+    for (size_t d : t.deps)
+    {
+        if (tasks[d].bound)
+        {
+            b.emplace(tasks[d].defines, tasks[d].value);
+        }
+        else if (tasks[d].has_values)
+        {
+            s.emplace(tasks[d].defines, tasks[d].values);
+        }
+    }
+
+    std::ostringstream out;
+    std::ostringstream err;
+    repl r;
+    r.eval(t.text, a, b, s, out, err);
+    t.out = out.str();
+    t.err = err.str();
+
+    // A line that fails leaves the previous binding of its name in place
+    if (!t.defines.empty())
+    {
+        auto it = b.find(t.defines);
+        if (it != b.end())
+        {
+            t.bound = true;
+            t.value = std::move(it->second);
+        }
+
+        auto values = s.find(t.defines);
+        if (values != s.end())
+        {
+            t.has_values = true;
+            t.values     = std::move(values->second);
+        }
+    }
+}
+} // namespace
+
+int run_batch(std::vector<std::string> const& files,
+              batch_options const& options)
+{
+    int failures = 0;
+
+    std::vector<line_task> tasks;
+    for (size_t f = 0; f != files.size(); ++f)
+    {
+        std::ifstream is{files[f]};
+        if (!is)
+        {
+            std::cerr << "Unable to open " << files[f] << '\n';
+            ++failures;
+            continue;
+        }
+
+        // Bindings do not carry over from one file to the next
+        std::map<std::string, size_t> definitions;
+        size_t number = 0;
+        for (std::string line; std::getline(is, line);)
+        {
+            line_task t;
+            t.text   = std::move(line);
+            t.file   = f;
+            t.number = ++number;
+            tasks.push_back(std::move(t));
+            analyze(tasks, tasks.size() - 1, definitions);
+        }
+    }
+
+    cache c;
+    if (!options.cache.empty())
+    {
+        c = load_cache(options.cache);
+    }
+
+    // Dependencies precede their dependents, so a backwards pass marks every
+    // line that must be evaluated
+    for (size_t i = tasks.size(); i-- > 0;)
+    {
+        line_task& t = tasks[i];
+        auto it      = c.find(t.key);
+        if (it == c.end())
+        {
+            t.needed = true;
+        }
+        else if (!t.needed)
+        {
+            t.out  = it->second.out;
+            t.err  = it->second.err;
+            t.done = true;
+        }
+
+        if (t.needed)
+        {
+            for (size_t d : t.deps)
+            {
+                tasks[d].needed = true;
+                tasks[d].dependents.push_back(i);
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<size_t> ready;
+    size_t remaining = 0;
+    for (size_t i = 0; i != tasks.size(); ++i)
+    {
+        line_task& t = tasks[i];
+        if (t.needed)
+        {
+            ++remaining;
+            t.pending = t.deps.size();
+            if (t.pending == 0)
+            {
+                ready.push_back(i);
+            }
+        }
+    }
+    size_t evaluated = remaining;
+
+    algebra a{3, 0, 1};
+    auto work = [&] {
+        std::unique_lock<std::mutex> lock{mutex};
+        while (true)
+        {
+            changed.wait(lock, [&] { return !ready.empty() || remaining == 0; });
+            if (ready.empty())
+            {
+                return;
+            }
+
+            size_t i = ready.front();
+            ready.pop_front();
+
+            lock.unlock();
+            evaluate(tasks, i, a);
+            lock.lock();
+
+            tasks[i].done = true;
+            --remaining;
+            for (size_t d : tasks[i].dependents)
+            {
+                if (--tasks[d].pending == 0)
+                {
+                    ready.push_back(d);
+                }
+            }
+            changed.notify_all();
+        }
+    };
+
+    size_t threads = options.threads;
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<size_t>(evaluated, 1));
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i != threads; ++i)
+    {
+        workers.emplace_back(work);
+    }
+
+    // Output is written in order as soon as each line is done
+    for (auto& t : tasks)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            changed.wait(lock, [&] { return t.done; });
+        }
+
+        std::cout << t.out << std::flush;
+        if (!t.err.empty())
+        {
+            std::cerr << files[t.file] << ':' << t.number << ": "
+                      << t.err;
+            ++failures;
+        }
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (!options.cache.empty())
+    {
+        save_cache(options.cache, tasks);
+        std::cerr << "Evaluated " << evaluated << " of " << tasks.size()
+                  << " lines (" << tasks.size() - evaluated << " cached)\n";
+    }
+
+    return failures;
+}
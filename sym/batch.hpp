@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct batch_options
+{
+    // Number of worker threads (0 uses one per hardware thread)
+    size_t threads = 0;
+
+    // File in which the output of each line is cached between runs (empty to
+    // disable caching)
+    std::string cache;
+};
+
+// Evaluate the scripts non-interactively, as if each were piped to the shell
+// in turn, and return the number of lines (or files) that failed.
+//
+// Every file starts with no bindings. Within a file, a line only depends on
+// the .let and .values lines defining the names it mentions, so independent
+// lines are evaluated concurrently by a pool of workers. Output is buffered
+// per line and written in the order of the input regardless of the order in
+// which lines finish, and errors are written to stderr prefixed with the file
+// and line number.
+//
+// Cached results are keyed by a hash of the line along with the keys of the
+// lines it depends on, so after a script is edited only the changed lines
+// and the lines using names they (transitively) define are expanded again. A
+// .let or .values line is only evaluated when a line depending on it must be.
+int run_batch(std::vector<std::string> const& files,
+              batch_options const& options);
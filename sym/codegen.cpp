@@ -0,0 +1,752 @@
+#include "codegen.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+int kernel_stats::total() const noexcept
+{
+    return swizzles + muls + adds + xors;
+}
+
+int kernel_stats::total_fma() const noexcept
+{
+    return total() - fmas;
+}
+
+std::ostream& operator<<(std::ostream& os, kernel_stats const& s) noexcept
+{
+    os << s.swizzles << " swizzles, " << s.muls << " muls, " << s.adds
+       << " adds, " << s.xors << " sign flips, " << s.constants
+       << " constants (" << s.total() << " instructions, " << s.total_fma()
+       << " with KLN_FMA)";
+    return os;
+}
+
+namespace
+{
+// Partition memory layouts
+//     LSB --> MSB
+// p0: (e0, e1, e2, e3)
+// p1: (1, e23, e31, e12)
+// p2: (e0123, e01, e02, e03)
+// p3: (e123, e032, e013, e021)
+constexpr lane_blade partitions[4][4] = {
+    {{0b1, 1.f}, {0b10, 1.f}, {0b100, 1.f}, {0b1000, 1.f}},
+    {{0, 1.f}, {0b1100, 1.f}, {0b1010, -1.f}, {0b110, 1.f}},
+    {{0b1111, 1.f}, {0b11, 1.f}, {0b101, 1.f}, {0b1001, 1.f}},
+    {{0b1110, 1.f}, {0b1101, -1.f}, {0b1011, 1.f}, {0b111, -1.f}}};
+
+constexpr char const* partition_names[4] = {"(e0, e1, e2, e3)",
+                                            "(1, e23, e31, e12)",
+                                            "(e0123, e01, e02, e03)",
+                                            "(e123, e032, e013, e021)"};
+
+// A lane of an input register
+struct factor
+{
+    char reg;
+    int lane;
+};
+
+// A product of input lanes contributing to a single output lane
+struct scalar_term
+{
+    std::vector<factor> factors;
+    float coef;
+};
+
+// A swizzled input register. Lanes set to -1 are not read by any product and
+// may take any value.
+struct swizzle
+{
+    char reg;
+    std::array<int, 4> lanes;
+};
+
+// Up to four scalar terms (one per output lane) evaluated at once as the
+// product of swizzled registers. Absent lanes have a zero coefficient.
+struct vector_term
+{
+    std::vector<size_t> swizzles;
+    std::array<float, 4> coef;
+};
+
+bool compatible(std::array<int, 4> const& lhs,
+                std::array<int, 4> const& rhs) noexcept
+{
+    for (size_t i = 0; i != 4; ++i)
+    {
+        if (lhs[i] != -1 && rhs[i] != -1 && lhs[i] != rhs[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<factor> factors_of(mon const& m)
+{
+    std::vector<factor> out;
+    for (auto&& [id, deg] : m.factors())
+    {
+        std::string const& var = var_name(id);
+        if (var.size() != 2 || !std::islower(var[0]) || var[1] < '0'
+            || var[1] > '3')
+        {
+            throw std::runtime_error(
+                "Kernel inputs must be named by a register and a lane (e.g. "
+                "b2), found "
+                + var);
+        }
+        if (deg < 0)
+        {
+            throw std::runtime_error(
+                "Kernel inputs cannot have negative exponents");
+        }
+
+        for (int i = 0; i != deg; ++i)
+        {
+            out.push_back({var[0], var[1] - '0'});
+        }
+    }
+    return out;
+}
+
+// Order the factors such that registers with more factors come first and
+// return the resulting sequence of registers. Placing the repeated register
+// first lets products like b b a share the partial product b b.
+std::string signature(std::vector<factor>& factors)
+{
+    std::map<char, int> counts;
+    for (auto&& f : factors)
+    {
+        ++counts[f.reg];
+    }
+
+    std::sort(factors.begin(),
+              factors.end(),
+              [&](factor const& lhs, factor const& rhs) {
+                  if (counts[lhs.reg] != counts[rhs.reg])
+                  {
+                      return counts[lhs.reg] > counts[rhs.reg];
+                  }
+                  else if (lhs.reg != rhs.reg)
+                  {
+                      return lhs.reg < rhs.reg;
+                  }
+                  return lhs.lane < rhs.lane;
+              });
+
+    std::string out;
+    for (auto&& f : factors)
+    {
+        out.push_back(f.reg);
+    }
+    return out;
+}
+
+// Greedily pair the terms of the four output lanes sharing the signature sig
+// into vector terms. For each lane, the term chosen is the one reading the
+// most inputs either in place or through a swizzle already in use.
+void pair_terms(std::string const& sig,
+                std::array<std::vector<scalar_term>, 4>& lanes,
+                std::vector<swizzle>& swizzles,
+                std::vector<vector_term>& out)
+{
+    size_t n = sig.size();
+
+    while (true)
+    {
+        std::vector<std::array<int, 4>> pattern(n, {-1, -1, -1, -1});
+        std::array<float, 4> coef{};
+        float first = 0.f;
+
+        for (int l = 0; l != 4; ++l)
+        {
+            auto& terms    = lanes[l];
+            int best_score = -1;
+            size_t best    = 0;
+            std::vector<size_t> best_perm;
+
+            for (size_t i = 0; i != terms.size(); ++i)
+            {
+                auto const& f = terms[i].factors;
+
+                // Factors of the same register may be assigned to slots in any
+                // order. Permutations are only attempted for short products.
+                std::vector<size_t> perm(n);
+                std::iota(perm.begin(), perm.end(), 0);
+                do
+                {
+                    bool valid = true;
+                    for (size_t s = 0; s != n; ++s)
+                    {
+                        valid = valid && f[perm[s]].reg == sig[s];
+                    }
+                    if (!valid)
+                    {
+                        continue;
+                    }
+
+                    int score = 0;
+                    for (size_t s = 0; s != n; ++s)
+                    {
+                        int lane = f[perm[s]].lane;
+                        if (lane == l)
+                        {
+                            score += 2;
+                        }
+
+                        for (auto&& sw : swizzles)
+                        {
+                            if (sw.reg == sig[s] && sw.lanes[l] == lane
+                                && compatible(sw.lanes, pattern[s]))
+                            {
+                                score += 2;
+                                break;
+                            }
+                        }
+                    }
+
+                    if (first != 0.f
+                        && std::abs(terms[i].coef) == std::abs(first))
+                    {
+                        score += 1;
+                    }
+
+                    if (score > best_score)
+                    {
+                        best_score = score;
+                        best       = i;
+                        best_perm  = perm;
+                    }
+                } while (n <= 4 && std::next_permutation(perm.begin(), perm.end()));
+            }
+
+            if (best_score < 0)
+            {
+                continue;
+            }
+
+            for (size_t s = 0; s != n; ++s)
+            {
+                pattern[s][l] = terms[best].factors[best_perm[s]].lane;
+            }
+            coef[l] = terms[best].coef;
+            if (first == 0.f)
+            {
+                first = coef[l];
+            }
+            terms.erase(terms.begin() + best);
+        }
+
+        if (first == 0.f)
+        {
+            return;
+        }
+
+        vector_term vt;
+        vt.coef = coef;
+        for (size_t s = 0; s != n; ++s)
+        {
+            size_t i = 0;
+            for (; i != swizzles.size(); ++i)
+            {
+                if (swizzles[i].reg == sig[s]
+                    && compatible(swizzles[i].lanes, pattern[s]))
+                {
+                    break;
+                }
+            }
+
+            if (i == swizzles.size())
+            {
+                swizzles.push_back({sig[s], pattern[s]});
+            }
+            else
+            {
+                for (size_t l = 0; l != 4; ++l)
+                {
+                    if (pattern[s][l] != -1)
+                    {
+                        swizzles[i].lanes[l] = pattern[s][l];
+                    }
+                }
+            }
+            vt.swizzles.push_back(i);
+        }
+        out.push_back(vt);
+    }
+}
+
+std::string literal(float f)
+{
+    std::ostringstream os;
+    os.precision(9);
+    os << f;
+    std::string out = os.str();
+    if (out.find_first_of(".en") == std::string::npos)
+    {
+        out += '.';
+    }
+    return out + 'f';
+}
+
+// Emits the statements of a kernel while tracking instruction counts
+class emitter
+{
+public:
+    emitter(std::vector<swizzle> const& swizzles, kernel_stats& stats)
+        : swizzles_{swizzles}
+        , stats_{stats}
+    {}
+
+    // A register accumulating a sum of products
+    struct accumulator
+    {
+        std::string name;
+        // Whether the first assignment must declare the register
+        bool declare;
+        bool live = false;
+    };
+
+    std::ostringstream body;
+
+    std::string temporary()
+    {
+        return "tmp" + std::to_string(temporaries_++);
+    }
+
+    std::string constant(std::array<float, 4> const& c)
+    {
+        std::string out = "_mm_set_ps(" + literal(c[3]) + ", " + literal(c[2])
+                          + ", " + literal(c[1]) + ", " + literal(c[0]) + ')';
+        if (constants_.insert(out).second)
+        {
+            ++stats_.constants;
+        }
+        return out;
+    }
+
+    // Name of the swizzle i, declaring it on first use
+    std::string operand(size_t i)
+    {
+        swizzle const& sw = swizzles_[i];
+        bool identity     = true;
+        std::string name{sw.reg};
+        name += '_';
+        for (int l = 0; l != 4; ++l)
+        {
+            identity = identity && sw.lanes[l] == l;
+            name += "xyzw"[sw.lanes[l]];
+        }
+
+        if (identity)
+        {
+            return std::string{sw.reg};
+        }
+
+        if (declared_.insert(name).second)
+        {
+            body << "    __m128 " << name << " = KLN_SWIZZLE(" << sw.reg << ", "
+                 << sw.lanes[3] << ", " << sw.lanes[2] << ", " << sw.lanes[1]
+                 << ", " << sw.lanes[0] << ");\n";
+            ++stats_.swizzles;
+        }
+        return name;
+    }
+
+    // Name of the product of the first k swizzles of vt. Partial products are
+    // cached, so products sharing factors are computed once.
+    std::string product(vector_term const& vt, size_t k)
+    {
+        if (k == 1)
+        {
+            return operand(vt.swizzles[0]);
+        }
+
+        std::vector<std::string> key;
+        for (size_t i = 0; i != k; ++i)
+        {
+            key.push_back(operand(vt.swizzles[i]));
+        }
+        std::sort(key.begin(), key.end());
+
+        auto it = products_.find(key);
+        if (it != products_.end())
+        {
+            return it->second;
+        }
+
+        std::string lhs  = product(vt, k - 1);
+        std::string rhs  = operand(vt.swizzles[k - 1]);
+        std::string name = temporary();
+        body << "    __m128 " << name << " = _mm_mul_ps(" << lhs << ", " << rhs
+             << ");\n";
+        ++stats_.muls;
+        products_.emplace(std::move(key), name);
+        return name;
+    }
+
+    // Whether the product of all swizzles of vt was already computed
+    bool cached(vector_term const& vt)
+    {
+        if (vt.swizzles.size() == 1)
+        {
+            return true;
+        }
+        std::vector<std::string> key;
+        for (size_t i : vt.swizzles)
+        {
+            key.push_back(operand(i));
+        }
+        std::sort(key.begin(), key.end());
+        return products_.count(key) > 0;
+    }
+
+    // acc += sign * (product of the swizzles of vt)
+    void accumulate(accumulator& acc, vector_term const& vt, float sign)
+    {
+        // Operands are resolved first since they may declare swizzles and
+        // partial products
+        std::string expr;
+        if (!acc.live || cached(vt))
+        {
+            std::string x = product(vt, vt.swizzles.size());
+            if (!acc.live)
+            {
+                expr = negate(x, sign);
+            }
+            else
+            {
+                expr = (sign > 0.f ? "_mm_add_ps(" : "_mm_sub_ps(") + acc.name
+                       + ", " + x + ')';
+                ++stats_.adds;
+            }
+        }
+        else
+        {
+            std::string a = product(vt, vt.swizzles.size() - 1);
+            std::string b = operand(vt.swizzles.back());
+            expr = (sign > 0.f ? "fmadd(" : "fnmadd(") + a + ", " + b + ", "
+                   + acc.name + ')';
+            ++stats_.muls;
+            ++stats_.adds;
+            ++stats_.fmas;
+        }
+
+        assign(acc, expr);
+    }
+
+    // acc += c * x, or acc = c * x if acc holds no value yet
+    void scale_add(accumulator& acc, std::string const& x, std::array<float, 4> c)
+    {
+        bool ones  = true;
+        bool signs = true;
+        for (float f : c)
+        {
+            ones  = ones && f == 1.f;
+            signs = signs && std::abs(f) == 1.f;
+        }
+
+        std::string expr = x;
+        if (signs && !ones)
+        {
+            for (float& f : c)
+            {
+                f = f < 0.f ? -0.f : 0.f;
+            }
+            expr = "_mm_xor_ps(" + x + ", " + constant(c) + ')';
+            ++stats_.xors;
+        }
+        else if (!signs)
+        {
+            ++stats_.muls;
+            if (acc.live)
+            {
+                ++stats_.adds;
+                ++stats_.fmas;
+                assign(acc,
+                       "fmadd(" + x + ", " + constant(c) + ", " + acc.name
+                           + ')');
+                return;
+            }
+            expr = "_mm_mul_ps(" + x + ", " + constant(c) + ')';
+        }
+
+        if (acc.live)
+        {
+            expr = "_mm_add_ps(" + acc.name + ", " + expr + ')';
+            ++stats_.adds;
+        }
+        assign(acc, expr);
+    }
+
+    void assign(accumulator& acc, std::string const& expr)
+    {
+        body << "    " << (!acc.live && acc.declare ? "__m128 " : "") << acc.name
+             << " = " << expr << ";\n";
+        acc.live = true;
+    }
+
+private:
+    std::string negate(std::string const& x, float sign)
+    {
+        if (sign > 0.f)
+        {
+            return x;
+        }
+        ++stats_.xors;
+        return "_mm_xor_ps(" + x + ", " + constant({-0.f, -0.f, -0.f, -0.f})
+               + ')';
+    }
+
+    std::vector<swizzle> const& swizzles_;
+    kernel_stats& stats_;
+    std::map<std::vector<std::string>, std::string> products_;
+    std::set<std::string> declared_;
+    std::set<std::string> constants_;
+    int temporaries_ = 0;
+};
+
+// Vector terms sharing a coefficient (up to sign) that are summed before the
+// coefficient is applied
+struct term_group
+{
+    std::array<float, 4> coef;
+    std::vector<std::pair<vector_term, float>> terms;
+
+    bool uniform() const noexcept
+    {
+        return std::abs(coef[0]) == 1.f && coef[0] == coef[1]
+               && coef[0] == coef[2] && coef[0] == coef[3];
+    }
+};
+} // namespace
+
+lane_blade klein_lane(int partition, int lane) noexcept
+{
+    return partitions[partition][lane];
+}
+
+kernel_stats emit_kernel(std::ostream& os,
+                         std::string const& name,
+                         mv const& m,
+                         std::string const& comment)
+{
+    // Gather the terms of each output lane
+    std::array<std::array<std::vector<scalar_term>, 4>, 4> outputs;
+    std::array<std::array<float, 4>, 4> constants{};
+    std::array<bool, 4> present{};
+    std::set<char> inputs;
+
+    for (size_t p = 0; p != 4; ++p)
+    {
+        for (size_t l = 0; l != 4; ++l)
+        {
+            auto it = m.terms.find(partitions[p][l].blade);
+            if (it == m.terms.end())
+            {
+                continue;
+            }
+
+            present[p] = true;
+            for (auto const* t : it->second.sorted())
+            {
+                float c = t->second * partitions[p][l].sign;
+                auto f  = factors_of(t->first);
+                if (f.empty())
+                {
+                    constants[p][l] += c;
+                    continue;
+                }
+
+                for (auto&& x : f)
+                {
+                    inputs.insert(x.reg);
+                }
+                outputs[p][l].push_back({std::move(f), c});
+            }
+        }
+    }
+
+    if (inputs.empty())
+    {
+        throw std::runtime_error("Kernels must depend on at least one input");
+    }
+
+    // Pair up the terms of all outputs before emitting any code, since pairing
+    // may still assign the unused lanes of a swizzle
+    std::vector<swizzle> swizzles;
+    std::array<std::vector<vector_term>, 4> vector_terms;
+    for (size_t p = 0; p != 4; ++p)
+    {
+        std::map<std::string, std::array<std::vector<scalar_term>, 4>> by_sig;
+        for (size_t l = 0; l != 4; ++l)
+        {
+            for (auto& t : outputs[p][l])
+            {
+                std::string sig = signature(t.factors);
+                by_sig[sig][l].push_back(std::move(t));
+            }
+        }
+
+        for (auto& [sig, lanes] : by_sig)
+        {
+            pair_terms(sig, lanes, swizzles, vector_terms[p]);
+        }
+    }
+
+    // Unused swizzle lanes read in place where possible
+    for (auto& sw : swizzles)
+    {
+        for (int l = 0; l != 4; ++l)
+        {
+            if (sw.lanes[l] == -1)
+            {
+                sw.lanes[l] = l;
+            }
+        }
+    }
+
+    kernel_stats stats;
+    emitter e{swizzles, stats};
+
+    for (size_t p = 0; p != 4; ++p)
+    {
+        if (!present[p])
+        {
+            continue;
+        }
+
+        e.body << "    // p" << p << ": " << partition_names[p] << '\n';
+
+        // Group the vector terms by their coefficients, normalized such that
+        // the first nonzero coefficient is positive
+        std::vector<term_group> groups;
+        for (auto&& vt : vector_terms[p])
+        {
+            std::array<float, 4> c = vt.coef;
+            float sign             = 1.f;
+            for (float f : c)
+            {
+                if (f != 0.f)
+                {
+                    sign = f < 0.f ? -1.f : 1.f;
+                    break;
+                }
+            }
+            for (float& f : c)
+            {
+                f = f * sign + 0.f;
+            }
+
+            auto it = std::find_if(groups.begin(),
+                                   groups.end(),
+                                   [&](term_group const& g) { return g.coef == c; });
+            if (it == groups.end())
+            {
+                groups.push_back({c, {}});
+                it = groups.end() - 1;
+            }
+            it->terms.emplace_back(vt, sign);
+        }
+
+        // Terms of groups with a coefficient of 1 are accumulated directly
+        // into the output, and only once it holds a value
+        std::stable_partition(groups.begin(),
+                              groups.end(),
+                              [](term_group const& g) { return !g.uniform(); });
+
+        for (auto& g : groups)
+        {
+            // Start each sum with a positive term if possible
+            std::stable_partition(
+                g.terms.begin(), g.terms.end(), [](auto const& t) {
+                    return t.second > 0.f;
+                });
+            if (!g.uniform() && g.terms.front().second < 0.f)
+            {
+                for (float& f : g.coef)
+                {
+                    f = -f;
+                }
+                for (auto& t : g.terms)
+                {
+                    t.second = -t.second;
+                }
+            }
+        }
+
+        emitter::accumulator out{"p" + std::to_string(p) + "_out", false};
+        for (auto&& g : groups)
+        {
+            if (g.uniform())
+            {
+                for (auto&& [vt, sign] : g.terms)
+                {
+                    e.accumulate(out, vt, sign * g.coef[0]);
+                }
+                continue;
+            }
+
+            if (g.terms.size() == 1)
+            {
+                vector_term const& vt = g.terms.front().first;
+                e.scale_add(out, e.product(vt, vt.swizzles.size()), g.coef);
+                continue;
+            }
+
+            emitter::accumulator sum{e.temporary(), true};
+            for (auto&& [vt, sign] : g.terms)
+            {
+                e.accumulate(sum, vt, sign);
+            }
+            e.scale_add(out, sum.name, g.coef);
+        }
+
+        if (constants[p] != std::array<float, 4>{})
+        {
+            std::string c = e.constant(constants[p]);
+            if (out.live)
+            {
+                e.assign(out, "_mm_add_ps(" + out.name + ", " + c + ')');
+                ++stats.adds;
+            }
+            else
+            {
+                e.assign(out, c);
+            }
+        }
+    }
+
+    if (!comment.empty())
+    {
+        os << "// " << comment << '\n';
+    }
+    os << "// " << stats << '\n';
+    os << "KLN_INLINE void KLN_VEC_CALL " << name << '(';
+    for (char in : inputs)
+    {
+        os << "__m128 " << in << ", ";
+    }
+    bool first = true;
+    for (size_t p = 0; p != 4; ++p)
+    {
+        if (present[p])
+        {
+            os << (first ? "" : ", ") << "__m128& p" << p << "_out";
+            first = false;
+        }
+    }
+    os << ") noexcept\n{\n" << e.body.str() << "}\n";
+
+    return stats;
+}
\ No newline at end of file
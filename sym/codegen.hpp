@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ga.hpp"
+
+#include <iostream>
+#include <string>
+
+// Instruction counts of a generated kernel
+struct kernel_stats
+{
+    int swizzles  = 0;
+    int muls      = 0;
+    int adds      = 0; // Additions and subtractions
+    int xors      = 0; // Sign flips
+    int fmas      = 0; // Multiply-adds that fuse when KLN_FMA is defined
+    int constants = 0; // Constant registers materialized with _mm_set_ps
+
+    // Number of arithmetic and shuffle instructions without and with fused
+    // multiply-adds (constant loads are not included)
+    int total() const noexcept;
+    int total_fma() const noexcept;
+};
+
+std::ostream& operator<<(std::ostream& os, kernel_stats const& s) noexcept;
+
+// A basis blade of a partition lane as named by Klein along with the sign
+// relating it to the blade stored in an mv (indices in ascending order)
+struct lane_blade
+{
+    uint32_t blade;
+    float sign;
+};
+
+// The blade stored in a lane of one of the partitions p0 through p3:
+//     LSB --> MSB
+// p0: (e0, e1, e2, e3)
+// p1: (1, e23, e31, e12)
+// p2: (e0123, e01, e02, e03)
+// p3: (e123, e032, e013, e021)
+lane_blade klein_lane(int partition, int lane) noexcept;
+
+// Emit an SSE kernel named `name` that evaluates the multivector m.
+//
+// Each variable in the coefficients of m must be named by a register and a
+// lane (e.g. b2 refers to the third lane of the register b), so that an
+// expression written in terms of a0 ... a3, b0 ... b3, etc. becomes a kernel
+// taking the registers a, b, etc. as arguments. The components of m are
+// written to the partitions p0 through p3 in Klein's layout.
+//
+// Products sharing the same inputs are emitted as products of swizzled
+// registers with the lanes of all four outputs paired up so that swizzles
+// and partial products are reused. The kernel uses the fmadd and fnmadd
+// helpers, so the same source compiles to fused multiply-adds when KLN_FMA is
+// defined.
+kernel_stats emit_kernel(std::ostream& os,
+                         std::string const& name,
+                         mv const& m,
+                         std::string const& comment = {});
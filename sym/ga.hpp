@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <map>
 
 uint32_t popcnt(uint32_t i);
 
@@ -1,7 +1,21 @@
+#include "batch.hpp"
 #include "ga.hpp"
 #include "parser.hpp"
 #include "repl.hpp"
 
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int usage()
+{
+    std::cerr << "Usage: klein_shell [-j <threads>] [--cache <file>] "
+                 "[<script.klein> ...]\n"
+                 "Without scripts, expressions are read from stdin.\n";
+    return 1;
+}
+
 int main(int argc, char** argv)
 {
     // std::string test = "4e0 + (b + c) * e102";
@@ -10,6 +24,39 @@ int main(int argc, char** argv)
     // std::cout << tokenize(test, a);
     // mv mv1 = parse("(e23 + 2e012) * (2 - 3e01)", pga);
     // std::cout << mv1 << std::endl;
+
+    batch_options options;
+    std::vector<std::string> files;
+    for (int i = 1; i != argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "--cache") && i + 1 == argc)
+        {
+            return usage();
+        }
+        else if (arg == "-j")
+        {
+            options.threads = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--cache")
+        {
+            options.cache = argv[++i];
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            return usage();
+        }
+        else
+        {
+            files.push_back(std::move(arg));
+        }
+    }
+
+    if (!files.empty())
+    {
+        return run_batch(files, options) == 0 ? 0 : 1;
+    }
+
     repl r;
     r.run();
     return 0;
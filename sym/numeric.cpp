@@ -0,0 +1,259 @@
+#include "numeric.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <xmmintrin.h>
+
+namespace
+{
+// Registers per block of samples
+constexpr size_t block = 16;
+
+// Samples per block
+constexpr size_t block_samples = 4 * block;
+
+// The values of a slot for a block of samples
+struct slot_block
+{
+    __m128 v[block];
+};
+
+void print_blade(std::ostream& os, uint32_t e)
+{
+    if (e == 0)
+    {
+        return;
+    }
+
+    os << " e";
+    for (size_t i = 0; i != 9; ++i)
+    {
+        if ((e & (1 << i)) > 0)
+        {
+            os << i;
+        }
+    }
+}
+} // namespace
+
+evaluator::evaluator(mv const& m)
+{
+    // Variables are ordered by name
+    std::set<std::string> names;
+    for (auto&& [e, p] : m.terms)
+    {
+        for (auto&& [mon, coef] : p.terms)
+        {
+            for (auto&& [var, deg] : mon.factors())
+            {
+                names.insert(var_name(var));
+            }
+        }
+    }
+    variables_.assign(names.begin(), names.end());
+
+    std::unordered_map<var_id, size_t> variable_slots;
+    for (size_t i = 0; i != variables_.size(); ++i)
+    {
+        variable_slots.emplace(intern(variables_[i]), i);
+    }
+    size_t one = variables_.size();
+    slots_     = one + 1;
+
+    std::unordered_map<var_id, size_t> reciprocal_slots;
+    std::map<std::vector<size_t>, size_t> products;
+    std::unordered_map<mon, size_t> monomials;
+
+    for (auto&& [e, p] : m.terms)
+    {
+        blades_.push_back(e);
+
+        std::vector<term> terms;
+        for (auto t : p.sorted())
+        {
+            auto it = monomials.find(t->first);
+            if (it != monomials.end())
+            {
+                terms.push_back({it->second, t->second});
+                continue;
+            }
+
+            // Factors of the monomial with repeats, in order of their names
+            std::vector<size_t> factors;
+            for (auto&& [var, deg] : t->first.factors())
+            {
+                size_t slot = variable_slots[var];
+                if (deg < 0)
+                {
+                    auto r = reciprocal_slots.find(var);
+                    if (r == reciprocal_slots.end())
+                    {
+                        r = reciprocal_slots.emplace(var, slots_++).first;
+                        steps_.push_back({r->second, slot, slot, true});
+                    }
+                    slot = r->second;
+                }
+
+                factors.insert(factors.end(), std::abs(deg), slot);
+            }
+
+            // Each product extends the product of all but its last factor
+            size_t slot = factors.empty() ? one : factors.front();
+            for (size_t i = 1; i < factors.size(); ++i)
+            {
+                std::vector<size_t> prefix(factors.begin(),
+                                           factors.begin() + i + 1);
+                auto product = products.find(prefix);
+                if (product == products.end())
+                {
+                    product = products.emplace(std::move(prefix), slots_++)
+                                  .first;
+                    steps_.push_back(
+                        {product->second, slot, factors[i], false});
+                }
+                slot = product->second;
+            }
+
+            monomials.emplace(t->first, slot);
+            terms.push_back({slot, t->second});
+        }
+        outputs_.push_back(std::move(terms));
+    }
+}
+
+void evaluator::run(float const* const* inputs,
+                    float* const* outputs,
+                    size_t count) const
+{
+    std::vector<slot_block> slots(slots_);
+    std::fill_n(slots[variables_.size()].v, block, _mm_set1_ps(1.f));
+
+    // Partial blocks are staged through a buffer padded with zeros
+    alignas(16) float staging[block_samples];
+
+    for (size_t first = 0; first < count; first += block_samples)
+    {
+        size_t n = std::min(block_samples, count - first);
+
+        for (size_t i = 0; i != variables_.size(); ++i)
+        {
+            float const* in = inputs[i] + first;
+            if (n != block_samples)
+            {
+                std::fill(std::copy_n(in, n, staging),
+                          staging + block_samples,
+                          0.f);
+                in = staging;
+            }
+
+            __m128* dst = slots[i].v;
+            for (size_t k = 0; k != block; ++k)
+            {
+                dst[k] = _mm_loadu_ps(in + 4 * k);
+            }
+        }
+
+        for (step const& s : steps_)
+        {
+            __m128* dst       = slots[s.dst].v;
+            __m128 const* lhs = slots[s.lhs].v;
+            __m128 const* rhs = slots[s.rhs].v;
+            if (s.reciprocal)
+            {
+                for (size_t k = 0; k != block; ++k)
+                {
+                    dst[k] = _mm_div_ps(_mm_set1_ps(1.f), lhs[k]);
+                }
+            }
+            else
+            {
+                for (size_t k = 0; k != block; ++k)
+                {
+                    dst[k] = _mm_mul_ps(lhs[k], rhs[k]);
+                }
+            }
+        }
+
+        for (size_t j = 0; j != outputs_.size(); ++j)
+        {
+            __m128 acc[block];
+            std::fill_n(acc, block, _mm_setzero_ps());
+            for (term const& t : outputs_[j])
+            {
+                __m128 coef       = _mm_set1_ps(t.coef);
+                __m128 const* src = slots[t.slot].v;
+                for (size_t k = 0; k != block; ++k)
+                {
+                    acc[k] = _mm_add_ps(acc[k], _mm_mul_ps(coef, src[k]));
+                }
+            }
+
+            float* out = n == block_samples ? outputs[j] + first : staging;
+            for (size_t k = 0; k != block; ++k)
+            {
+                _mm_storeu_ps(out + 4 * k, acc[k]);
+            }
+            if (n != block_samples)
+            {
+                std::copy_n(staging, n, outputs[j] + first);
+            }
+        }
+    }
+}
+
+void print_samples(std::ostream& os, mv const& m, samples const& values)
+{
+    evaluator ev{m};
+
+    // Expressions without variables have a single sample
+    size_t count = 1;
+    std::vector<float const*> inputs;
+    for (size_t i = 0; i != ev.variables().size(); ++i)
+    {
+        std::string const& var = ev.variables()[i];
+        auto it                = values.find(var);
+        if (it == values.end())
+        {
+            throw std::runtime_error("No values bound to " + var);
+        }
+        else if (i > 0 && it->second.size() != count)
+        {
+            throw std::runtime_error("The values of " + ev.variables()[0]
+                                     + " and " + var
+                                     + " differ in number");
+        }
+        count = it->second.size();
+        inputs.push_back(it->second.data());
+    }
+
+    std::vector<std::vector<float>> results(ev.blades().size(),
+                                            std::vector<float>(count));
+    std::vector<float*> outputs;
+    for (auto& r : results)
+    {
+        outputs.push_back(r.data());
+    }
+    ev.run(inputs.data(), outputs.data(), count);
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        if (results.empty())
+        {
+            os << '0';
+        }
+
+        for (size_t j = 0; j != results.size(); ++j)
+        {
+            if (j > 0)
+            {
+                os << " + ";
+            }
+            os << results[j][i];
+            print_blade(os, ev.blades()[j]);
+        }
+        os << '\n';
+    }
+}
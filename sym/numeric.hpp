@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ga.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Values of variables bound with the .values command of the shell, one per
+// sample
+using samples = std::map<std::string, std::vector<float>>;
+
+// The polynomials of a multivector compiled for numeric evaluation.
+//
+// Every distinct monomial is computed once per sample and shared by all the
+// coefficients it appears in, and each monomial extends a shorter one already
+// computed where possible (e.g. a0 b1 c2 is computed from a0 b1). Samples are
+// evaluated in blocks with every operation applied to a block of SSE
+// registers at a time.
+class evaluator
+{
+public:
+    explicit evaluator(mv const& m);
+
+    // Names of the variables of m in the order their values are passed to run
+    std::vector<std::string> const& variables() const noexcept
+    {
+        return variables_;
+    }
+
+    // Blades of the coefficients of m in the order they are written by run
+    std::vector<uint32_t> const& blades() const noexcept
+    {
+        return blades_;
+    }
+
+    // Evaluate count samples. inputs[i] points to count values of the i-th
+    // variable and outputs[j] to storage for count values of the coefficient
+    // of the j-th blade.
+    void run(float const* const* inputs,
+             float* const* outputs,
+             size_t count) const;
+
+private:
+    // The product of two slots, or the reciprocal of lhs for variables with
+    // negative exponents
+    struct step
+    {
+        size_t dst;
+        size_t lhs;
+        size_t rhs;
+        bool reciprocal;
+    };
+
+    struct term
+    {
+        size_t slot;
+        float coef;
+    };
+
+    std::vector<std::string> variables_;
+    std::vector<uint32_t> blades_;
+
+    // Slots hold the variables followed by the constant 1 and then the
+    // products computed by steps_
+    size_t slots_ = 0;
+    std::vector<step> steps_;
+
+    // Terms of each coefficient
+    std::vector<std::vector<term>> outputs_;
+};
+
+// Print the value of each sample of m as a sum of blades
+void print_samples(std::ostream& os, mv const& m, samples const& values);
@@ -199,18 +199,19 @@ std::vector<token> tokenize(std::string const& input, algebra const& algebra_)
             t.type = token_type::number;
             t.num  = tokenize_number(it, input.end());
         }
-        else if (it != input.end() - 1)
+        else if (c == 'e' && it + 1 != input.end() && std::isdigit(*(it + 1)))
         {
-            if (c == 'e' && std::isdigit(*(it + 1)))
-            {
-                t.type = token_type::element;
-                t.e    = tokenize_element(it, input.end(), algebra_);
-            }
-            else
-            {
-                t.type = token_type::identifier;
-                t.id   = tokenize_identifier(it, input.end());
-            }
+            t.type = token_type::element;
+            t.e    = tokenize_element(it, input.end(), algebra_);
+        }
+        else if (std::isalpha(c))
+        {
+            t.type = token_type::identifier;
+            t.id   = tokenize_identifier(it, input.end());
+        }
+        else
+        {
+            throw std::runtime_error(std::string{"Unexpected character "} + c);
         }
         out.emplace_back(t);
     }
@@ -236,11 +237,13 @@ std::vector<token> tokenize(std::string const& input, algebra const& algebra_)
 
 static mv parse_expr(std::vector<token>::const_iterator& it,
                      std::vector<token>::const_iterator end,
-                     algebra const& a);
+                     algebra const& a,
+                     bindings const* b);
 
 static mv parse_factor(std::vector<token>::const_iterator& it,
                        std::vector<token>::const_iterator end,
-                       algebra const& a)
+                       algebra const& a,
+                       bindings const* b)
 {
     bool negate  = false;
     bool reverse = false;
@@ -262,6 +265,21 @@ static mv parse_factor(std::vector<token>::const_iterator& it,
         ++it;
     }
 
+    if (it->type == token_type::identifier && b != nullptr)
+    {
+        auto binding = b->find(std::string{it->id.data, it->id.size});
+        if (binding != b->end())
+        {
+            ++it;
+            mv out = binding->second;
+            if (negate)
+            {
+                out = -out;
+            }
+            return reverse ? ~out : out;
+        }
+    }
+
     if (it->type == token_type::identifier || it->type == token_type::number)
     {
         mv out{a};
@@ -316,7 +334,7 @@ static mv parse_factor(std::vector<token>::const_iterator& it,
     else if (it->type == token_type::delimiter && it->delimiter == '(')
     {
         ++it;
-        mv result = parse_expr(it, end, a);
+        mv result = parse_expr(it, end, a, b);
         if (it->type == token_type::delimiter && it->delimiter == ')')
         {
             ++it;
@@ -345,61 +363,66 @@ static mv parse_factor(std::vector<token>::const_iterator& it,
 
 static mv parse_dot_factor(std::vector<token>::const_iterator& it,
                            std::vector<token>::const_iterator end,
-                           algebra const& a)
+                           algebra const& a,
+                           bindings const* b)
 {
-    mv out = parse_factor(it, end, a);
+    mv out = parse_factor(it, end, a, b);
     while (it != end && it->type == token_type::op && it->op == '|')
     {
         ++it;
-        out |= parse_factor(it, end, a);
+        out |= parse_factor(it, end, a, b);
     }
     return out;
 }
 
 static mv parse_reg_factor(std::vector<token>::const_iterator& it,
                            std::vector<token>::const_iterator end,
-                           algebra const& a)
+                           algebra const& a,
+                           bindings const* b)
 {
-    mv out = parse_dot_factor(it, end, a);
+    mv out = parse_dot_factor(it, end, a, b);
     while (it != end && it->type == token_type::op && it->op == '&')
     {
         ++it;
-        out &= parse_dot_factor(it, end, a);
+        out &= parse_dot_factor(it, end, a, b);
     }
     return out;
 }
 
 static mv parse_ext_factor(std::vector<token>::const_iterator& it,
                            std::vector<token>::const_iterator end,
-                           algebra const& a)
+                           algebra const& a,
+                           bindings const* b)
 {
-    mv out = parse_reg_factor(it, end, a);
+    mv out = parse_reg_factor(it, end, a, b);
     while (it != end && it->type == token_type::op && it->op == '^')
     {
         ++it;
-        out ^= parse_reg_factor(it, end, a);
+        out ^= parse_reg_factor(it, end, a, b);
     }
     return out;
 }
 
 static mv parse_term(std::vector<token>::const_iterator& it,
                      std::vector<token>::const_iterator end,
-                     algebra const& a)
+                     algebra const& a,
+                     bindings const* b)
 {
-    mv out = parse_ext_factor(it, end, a);
+    mv out = parse_ext_factor(it, end, a, b);
     while (it != end && it->type == token_type::op && it->op == '*')
     {
         ++it;
-        out *= parse_ext_factor(it, end, a);
+        out *= parse_ext_factor(it, end, a, b);
     }
     return out;
 }
 
 static mv parse_expr(std::vector<token>::const_iterator& it,
                      std::vector<token>::const_iterator end,
-                     algebra const& a)
+                     algebra const& a,
+                     bindings const* b)
 {
-    mv out = parse_term(it, end, a);
+    mv out = parse_term(it, end, a, b);
 
     while (it != end && it->type != token_type::eof)
     {
@@ -408,12 +431,12 @@ static mv parse_expr(std::vector<token>::const_iterator& it,
             if (it->op == '+')
             {
                 ++it;
-                out += parse_term(it, end, a);
+                out += parse_term(it, end, a, b);
             }
             else if (it->op == '-')
             {
                 ++it;
-                out -= parse_term(it, end, a);
+                out -= parse_term(it, end, a, b);
             }
             else
             {
@@ -434,10 +457,10 @@ static mv parse_expr(std::vector<token>::const_iterator& it,
     return out;
 }
 
-mv parse(std::string const& input, algebra const& algebra_)
+mv parse(std::string const& input, algebra const& algebra_, bindings const* b)
 {
     std::vector<token> tokens = tokenize(input, algebra_);
 
     auto it = tokens.cbegin();
-    return parse_expr(it, tokens.cend(), algebra_);
+    return parse_expr(it, tokens.cend(), algebra_, b);
 }
\ No newline at end of file
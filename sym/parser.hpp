@@ -3,6 +3,8 @@
 #include "ga.hpp"
 
 #include <iostream>
+#include <map>
+#include <string>
 #include <vector>
 
 enum class token_type
@@ -48,4 +50,11 @@ std::ostream& operator<<(std::ostream& os, std::vector<token> const& tokens);
 
 std::vector<token> tokenize(std::string const& input, algebra const& algebra_);
 
-mv parse(std::string const& input, algebra const& a);
+// Multivectors bound to names with the .let command of the shell
+using bindings = std::map<std::string, mv>;
+
+// Identifiers found in b are replaced by the multivector bound to them, and
+// other identifiers are treated as scalar variables
+mv parse(std::string const& input,
+         algebra const& a,
+         bindings const* b = nullptr);
@@ -1,67 +1,208 @@
 #include "poly.hpp"
 
-mon& mon::push(std::string var, int deg) noexcept
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
 {
-    if (deg == 0)
-    {
-        return *this;
-    }
+// Interned variable names. Names are written once before the count is
+// published, so they may be read without holding the lock.
+struct var_table
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, var_id> ids;
+    std::array<std::string, max_vars> names;
+    std::atomic<size_t> count{0};
+};
 
-    auto it = factors.find(var);
-    if (it == factors.end())
-    {
-        factors.emplace(var, deg);
-    }
-    else
+var_table& vars()
+{
+    static var_table table;
+    return table;
+}
+
+// Storage for the tables of term_maps. Tables are carved out of large chunks
+// and recycled through free lists, one per power-of-two capacity, so the
+// temporaries created and destroyed throughout an expansion rarely reach the
+// system allocator. Chunks are never released, which permits a table to be
+// freed by a thread other than the one that allocated it.
+class arena
+{
+public:
+    void* allocate(uint32_t log2_capacity, size_t bytes)
     {
-        if (it->second + deg == 0)
+        block*& head = free_[log2_capacity];
+        if (head != nullptr)
         {
-            factors.erase(it);
+            block* out = head;
+            head       = head->next;
+            return out;
         }
-        else
+
+        bytes = (bytes + 63) & ~size_t{63};
+        if (bytes > chunk_size / 4)
         {
-            it->second += deg;
+            return ::operator new(bytes);
         }
+
+        if (bytes > remaining_)
+        {
+            cursor_    = static_cast<char*>(::operator new(chunk_size));
+            remaining_ = chunk_size;
+        }
+
+        void* out = cursor_;
+        cursor_ += bytes;
+        remaining_ -= bytes;
+        return out;
+    }
+
+    void release(void* p, uint32_t log2_capacity) noexcept
+    {
+        block* b               = static_cast<block*>(p);
+        b->next                = free_[log2_capacity];
+        free_[log2_capacity]   = b;
     }
 
+private:
+    static constexpr size_t chunk_size = 1 << 20;
+
+    struct block
+    {
+        block* next;
+    };
+
+    std::array<block*, 32> free_{};
+    char* cursor_     = nullptr;
+    size_t remaining_ = 0;
+};
+
+thread_local arena local_arena;
+
+uint32_t log2(uint32_t capacity) noexcept
+{
+    uint32_t out = 0;
+    while ((1u << out) < capacity)
+    {
+        ++out;
+    }
+    return out;
+}
+
+size_t table_bytes(uint32_t capacity) noexcept
+{
+    return capacity * (sizeof(term_map::entry) + 1);
+}
+} // namespace
+
+var_id intern(std::string const& name)
+{
+    var_table& table = vars();
+    std::lock_guard<std::mutex> lock{table.mutex};
+
+    auto it = table.ids.find(name);
+    if (it != table.ids.end())
+    {
+        return it->second;
+    }
+
+    size_t id = table.count.load(std::memory_order_relaxed);
+    if (id == max_vars)
+    {
+        throw std::runtime_error("Exceeded the maximum number of variables");
+    }
+
+    table.names[id] = name;
+    table.ids.emplace(name, static_cast<var_id>(id));
+    table.count.store(id + 1, std::memory_order_release);
+    return static_cast<var_id>(id);
+}
+
+std::string const& var_name(var_id id) noexcept
+{
+    return vars().names[id];
+}
+
+mon& mon::push(std::string const& var, int deg)
+{
+    return push(intern(var), deg);
+}
+
+mon& mon::push(var_id var, int deg) noexcept
+{
+    exponents[var] += deg;
     return *this;
 }
 
 int mon::degree() const noexcept
 {
     int out = 0;
-    for (auto&& [v, d] : factors)
+    for (int8_t d : exponents)
     {
         out += d;
     }
     return out;
 }
 
-bool operator==(mon const& lhs, mon const& rhs) noexcept
+int mon::exponent(std::string const& var) const noexcept
 {
-    if (lhs.factors.size() != rhs.factors.size())
+    var_table& table = vars();
+    size_t count     = table.count.load(std::memory_order_acquire);
+    for (size_t i = 0; i != count; ++i)
     {
-        return false;
+        if (table.names[i] == var)
+        {
+            return exponents[i];
+        }
     }
+    return 0;
+}
 
-    auto lhs_it = lhs.factors.begin();
-    auto rhs_it = rhs.factors.begin();
-
-    while (lhs_it != lhs.factors.end() && rhs_it != rhs.factors.end())
+std::vector<std::pair<var_id, int>> mon::factors() const
+{
+    std::vector<std::pair<var_id, int>> out;
+    for (size_t i = 0; i != max_vars; ++i)
     {
-        if (lhs_it->first != rhs_it->first)
+        if (exponents[i] != 0)
         {
-            return false;
+            out.emplace_back(static_cast<var_id>(i), exponents[i]);
         }
+    }
 
-        if (lhs_it->second != rhs_it->second)
-        {
-            return false;
-        }
-        ++lhs_it;
-        ++rhs_it;
+    std::sort(out.begin(), out.end(), [](auto const& lhs, auto const& rhs) {
+        return var_name(lhs.first) < var_name(rhs.first);
+    });
+    return out;
+}
+
+size_t std::hash<mon>::operator()(mon const& in) const noexcept
+{
+    uint64_t words[max_vars / 8];
+    std::memcpy(words, in.exponents.data(), max_vars);
+
+    uint64_t out = 0;
+    for (uint64_t w : words)
+    {
+        out = (out ^ w) * 0x9e3779b97f4a7c15;
+        out ^= out >> 29;
     }
-    return true;
+    return static_cast<size_t>(out);
+}
+
+bool operator==(mon const& lhs, mon const& rhs) noexcept
+{
+    return std::memcmp(lhs.exponents.data(), rhs.exponents.data(), max_vars)
+           == 0;
+}
+
+bool operator!=(mon const& lhs, mon const& rhs) noexcept
+{
+    return !(lhs == rhs);
 }
 
 // Graded lexical comparison (grlex)
@@ -78,24 +219,29 @@ bool operator<(mon const& lhs, mon const& rhs) noexcept
         return false;
     }
 
-    auto lhs_it = lhs.factors.begin();
-    auto rhs_it = rhs.factors.begin();
+    auto lhs_f  = lhs.factors();
+    auto rhs_f  = rhs.factors();
+    auto lhs_it = lhs_f.begin();
+    auto rhs_it = rhs_f.begin();
 
-    while (lhs_it != lhs.factors.end() || rhs_it != rhs.factors.end())
+    while (lhs_it != lhs_f.end() || rhs_it != rhs_f.end())
     {
-        if (lhs_it == lhs.factors.end())
+        if (lhs_it == lhs_f.end())
         {
             return true;
         }
-        else if (rhs_it == rhs.factors.end())
+        else if (rhs_it == rhs_f.end())
         {
             return false;
         }
-        else if (lhs_it->first < rhs_it->first)
+
+        std::string const& lhs_var = var_name(lhs_it->first);
+        std::string const& rhs_var = var_name(rhs_it->first);
+        if (lhs_var < rhs_var)
         {
             return true;
         }
-        else if (rhs_it->first < lhs_it->first)
+        else if (rhs_var < lhs_var)
         {
             return false;
         }
@@ -117,25 +263,9 @@ bool operator<(mon const& lhs, mon const& rhs) noexcept
 
 mon& mon::operator*=(mon const& other) noexcept
 {
-    for (auto&& [v, d] : other.factors)
+    for (size_t i = 0; i != max_vars; ++i)
     {
-        auto it = factors.find(v);
-
-        if (it == factors.end())
-        {
-            factors.emplace(v, d);
-        }
-        else
-        {
-            if (it->second + d == 0)
-            {
-                factors.erase(it);
-            }
-            else
-            {
-                it->second += d;
-            }
-        }
+        exponents[i] += other.exponents[i];
     }
 
     return *this;
@@ -148,29 +278,187 @@ mon operator*(mon const& lhs, mon const& rhs) noexcept
     return out;
 }
 
-poly& poly::push(mon const& m, float f) noexcept
+term_map::term_map(term_map const& other)
+{
+    *this = other;
+}
+
+term_map::term_map(term_map&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+term_map& term_map::operator=(term_map const& other)
 {
-    auto it = terms.find(m);
-    if (it == terms.end())
+    if (this == &other)
     {
-        terms.emplace(m, f);
+        return *this;
     }
-    else
+
+    release();
+    if (other.capacity_ > 0)
     {
-        if (it->second + f == 0.f)
+        void* p = local_arena.allocate(log2(other.capacity_),
+                                       table_bytes(other.capacity_));
+        slots_    = static_cast<entry*>(p);
+        used_     = reinterpret_cast<uint8_t*>(slots_ + other.capacity_);
+        capacity_ = other.capacity_;
+        size_     = other.size_;
+        std::memcpy(p, other.slots_, table_bytes(capacity_));
+    }
+    return *this;
+}
+
+term_map& term_map::operator=(term_map&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(slots_, other.slots_);
+        std::swap(used_, other.used_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+    }
+    return *this;
+}
+
+term_map::~term_map()
+{
+    release();
+}
+
+void term_map::release() noexcept
+{
+    if (slots_ != nullptr)
+    {
+        local_arena.release(slots_, log2(capacity_));
+        slots_    = nullptr;
+        used_     = nullptr;
+        capacity_ = 0;
+        size_     = 0;
+    }
+}
+
+// Index of the slot holding m or of the empty slot where m belongs. The table
+// must not be full.
+size_t term_map::slot(mon const& m) const noexcept
+{
+    size_t mask = capacity_ - 1;
+    size_t i    = std::hash<mon>{}(m) & mask;
+    while (used_[i] != 0 && slots_[i].first != m)
+    {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+term_map::iterator term_map::find(mon const& m) noexcept
+{
+    if (size_ == 0)
+    {
+        return end();
+    }
+    size_t i = slot(m);
+    return used_[i] != 0 ? iterator{slots_, used_, i, capacity_} : end();
+}
+
+term_map::const_iterator term_map::find(mon const& m) const noexcept
+{
+    if (size_ == 0)
+    {
+        return end();
+    }
+    size_t i = slot(m);
+    return used_[i] != 0 ? const_iterator{slots_, used_, i, capacity_} : end();
+}
+
+void term_map::reserve(size_t n)
+{
+    // Keep the load factor at or below 3/4
+    uint32_t capacity = 8;
+    while (capacity * 3 < n * 4)
+    {
+        capacity *= 2;
+    }
+    if (capacity <= capacity_)
+    {
+        return;
+    }
+
+    term_map old{std::move(*this)};
+    void* p   = local_arena.allocate(log2(capacity), table_bytes(capacity));
+    slots_    = static_cast<entry*>(p);
+    used_     = reinterpret_cast<uint8_t*>(slots_ + capacity);
+    capacity_ = capacity;
+    std::memset(used_, 0, capacity);
+
+    for (size_t i = 0; i != old.capacity_; ++i)
+    {
+        if (old.used_[i] != 0)
+        {
+            size_t j  = slot(old.slots_[i].first);
+            slots_[j] = old.slots_[i];
+            used_[j]  = 1;
+        }
+    }
+    size_ = old.size_;
+}
+
+void term_map::add(mon const& m, float f)
+{
+    reserve(size_ + 1);
+    size_t i = slot(m);
+    if (used_[i] == 0)
+    {
+        if (f != 0.f)
         {
-            terms.erase(it);
+            slots_[i] = {m, f};
+            used_[i]  = 1;
+            ++size_;
         }
-        else
+    }
+    else if (slots_[i].second + f == 0.f)
+    {
+        erase(i);
+    }
+    else
+    {
+        slots_[i].second += f;
+    }
+}
+
+// Removes slot i, shifting back the entries displaced past it so that no
+// probe sequence contains a gap
+void term_map::erase(size_t i) noexcept
+{
+    size_t mask = capacity_ - 1;
+    used_[i]    = 0;
+    --size_;
+
+    for (size_t j = (i + 1) & mask; used_[j] != 0; j = (j + 1) & mask)
+    {
+        size_t home = std::hash<mon>{}(slots_[j].first) & mask;
+
+        // Move the entry at j into the gap at i if its home slot does not lie
+        // cyclically within (i, j]
+        bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays)
         {
-            it->second += f;
+            slots_[i] = slots_[j];
+            used_[i]  = 1;
+            used_[j]  = 0;
+            i         = j;
         }
     }
+}
 
+poly& poly::push(mon const& m, float f)
+{
+    terms.add(m, f);
     return *this;
 }
 
-poly poly::operator-() const& noexcept
+poly poly::operator-() const&
 {
     poly out = *this;
     for (auto& [m, f] : out.terms)
@@ -190,112 +478,137 @@ poly& poly::operator-() && noexcept
     return *this;
 }
 
-poly& poly::operator+=(poly const& other) noexcept
+poly& poly::operator+=(poly const& other)
 {
+    terms.reserve(terms.size() + other.terms.size());
     for (auto&& [m, f] : other.terms)
     {
-        auto it = terms.find(m);
-        if (it == terms.end())
-        {
-            terms.emplace(m, f);
-        }
-        else
-        {
-            if (it->second + f == 0.f)
-            {
-                terms.erase(it);
-            }
-            else
-            {
-                it->second += f;
-            }
-        }
+        terms.add(m, f);
     }
     return *this;
 }
 
-poly operator+(poly const& lhs, poly const& rhs) noexcept
+poly operator+(poly const& lhs, poly const& rhs)
 {
     poly out = lhs;
     out += rhs;
     return out;
 }
 
-poly operator*(poly const& lhs, poly const& rhs) noexcept
+poly operator*(poly const& lhs, poly const& rhs)
 {
     poly out;
+    out.terms.reserve(std::max(lhs.terms.size(), rhs.terms.size()));
 
     for (auto&& [m1, f1] : lhs.terms)
     {
-        poly t;
-
         for (auto&& [m2, f2] : rhs.terms)
         {
             if (f1 * f2 != 0.f)
             {
-                auto m = m1 * m2;
-                t.terms[m] += f1 * f2;
+                out.terms.add(m1 * m2, f1 * f2);
             }
         }
-
-        out += t;
     }
 
     return out;
 }
 
-poly& poly::operator*=(poly const& other) noexcept
+poly& poly::operator*=(poly const& other)
 {
     poly temp = *this * other;
     std::swap(terms, temp.terms);
     return *this;
 }
 
-std::ostream&
-operator<<(std::ostream& os,
-           std::map<std::string, int>::const_iterator const& it) noexcept
+std::vector<term_map::entry const*> poly::sorted() const
 {
-    if (it->second == 0)
+    // The factors of each monomial are ordered once up front rather than in
+    // every comparison
+    struct key
     {
-        return os;
+        int degree;
+        std::vector<std::pair<std::string const*, int>> factors;
+        term_map::entry const* term;
+    };
+
+    std::vector<key> keys;
+    keys.reserve(terms.size());
+    for (auto&& t : terms)
+    {
+        key k{t.first.degree(), {}, &t};
+        for (auto&& [var, deg] : t.first.factors())
+        {
+            k.factors.emplace_back(&var_name(var), deg);
+        }
+        keys.push_back(std::move(k));
     }
 
-    os << it->first;
-    if (it->second != 1)
+    // Graded lexical order as in operator<(mon, mon)
+    std::sort(keys.begin(), keys.end(), [](key const& lhs, key const& rhs) {
+        if (lhs.degree != rhs.degree)
+        {
+            return lhs.degree < rhs.degree;
+        }
+
+        size_t n = std::min(lhs.factors.size(), rhs.factors.size());
+        for (size_t i = 0; i != n; ++i)
+        {
+            auto const& [lhs_var, lhs_deg] = lhs.factors[i];
+            auto const& [rhs_var, rhs_deg] = rhs.factors[i];
+            if (*lhs_var != *rhs_var)
+            {
+                return *lhs_var < *rhs_var;
+            }
+            else if (lhs_deg != rhs_deg)
+            {
+                return lhs_deg < rhs_deg;
+            }
+        }
+        return lhs.factors.size() < rhs.factors.size();
+    });
+
+    std::vector<term_map::entry const*> out;
+    out.reserve(keys.size());
+    for (auto&& k : keys)
     {
-        os << '^' << it->second;
+        out.push_back(k.term);
     }
-    return os;
+    return out;
 }
 
-std::ostream& operator<<(std::ostream& os,
-                         std::map<mon, float>::const_iterator const& it) noexcept
+namespace
 {
-    if (it->second == -1.f)
+std::ostream& operator<<(std::ostream& os, term_map::entry const& t) noexcept
+{
+    if (t.second == -1.f)
     {
         os << '-';
     }
-    else if (it->second != 1.f)
+    else if (t.second != 1.f)
     {
-        os << it->second;
+        os << t.second;
     }
 
-    if (it->first.factors.empty())
+    bool first = true;
+    for (auto&& [var, deg] : t.first.factors())
     {
-        return os;
-    }
-
-    auto factor = it->first.factors.cbegin();
-    os << factor;
-    ++factor;
+        if (!first)
+        {
+            os << ' ';
+        }
+        first = false;
 
-    for (; factor != it->first.factors.cend(); ++factor)
-    {
-        os << ' ' << factor;
+        os << var_name(var);
+        if (deg != 1)
+        {
+            os << '^' << deg;
+        }
     }
 
     return os;
 }
+} // namespace
 
 std::ostream& operator<<(std::ostream& os, poly const& p) noexcept
 {
@@ -311,13 +624,12 @@ std::ostream& operator<<(std::ostream& os, poly const& p) noexcept
         os << '(';
     }
 
-    auto it = p.terms.cbegin();
-    os << it;
-    ++it;
+    auto terms = p.sorted();
+    os << *terms.front();
 
-    for (; it != p.terms.cend(); ++it)
+    for (size_t i = 1; i != terms.size(); ++i)
     {
-        os << " + " << it;
+        os << " + " << *terms[i];
     }
 
     if (multi)
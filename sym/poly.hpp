@@ -1,21 +1,45 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <iostream>
-#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Variables are interned to small integer ids shared by all monomials
+using var_id = uint8_t;
+
+// Maximum number of distinct variables in a session
+constexpr size_t max_vars = 64;
+
+// Returns the id of the variable, interning it if needed. Safe to call from
+// multiple threads.
+var_id intern(std::string const& name);
+
+std::string const& var_name(var_id id) noexcept;
 
 class mon
 {
 public:
-    // Map from variable to degree
-    // A map is used here so that traversal order is deterministic
-    std::map<std::string, int> factors;
+    // Exponent of each interned variable, indexed by id
+    std::array<int8_t, max_vars> exponents{};
 
     mon& operator*=(mon const& other) noexcept;
 
     // Multiply the monomial by a named variable with degree
-    mon& push(std::string var, int deg = 1) noexcept;
+    mon& push(std::string const& var, int deg = 1);
+    mon& push(var_id var, int deg = 1) noexcept;
 
     int degree() const noexcept;
+
+    // Exponent of the variable (zero if it was never interned)
+    int exponent(std::string const& var) const noexcept;
+
+    // Variables with nonzero exponents along with their exponents in order of
+    // the variable names. This order is independent of the order in which
+    // variables were interned.
+    std::vector<std::pair<var_id, int>> factors() const;
 };
 
 mon operator*(mon const& lhs, mon const& rhs) noexcept;
@@ -25,45 +49,158 @@ namespace std
 template <>
 struct hash<mon>
 {
-    size_t operator()(mon const& in) const noexcept
+    size_t operator()(mon const& in) const noexcept;
+};
+} // namespace std
+
+bool operator==(mon const& lhs, mon const& rhs) noexcept;
+bool operator!=(mon const& lhs, mon const& rhs) noexcept;
+bool operator<(mon const& lhs, mon const& rhs) noexcept;
+
+// Map from monomials to coefficients using open addressing (linear probing).
+// Tables are allocated from a thread-local arena and recycled rather than
+// returned to the system allocator. Iteration order is unspecified; use
+// poly::sorted for a deterministic order.
+class term_map
+{
+public:
+    struct entry
+    {
+        mon first;
+        float second;
+    };
+
+    template <typename T>
+    class iterator_t
     {
-        size_t out = 0;
-        size_t k;
-        if constexpr (sizeof(void*) == 8)
+    public:
+        iterator_t(T* slots, uint8_t const* used, size_t i, size_t capacity) noexcept
+            : slots_{slots}
+            , used_{used}
+            , i_{i}
+            , capacity_{capacity}
+        {
+            skip();
+        }
+
+        T& operator*() const noexcept
         {
-            k = 0x517cc1b727220a95;
+            return slots_[i_];
         }
-        else
+
+        T* operator->() const noexcept
+        {
+            return slots_ + i_;
+        }
+
+        iterator_t& operator++() noexcept
         {
-            k = 0x9e3779b9;
+            ++i_;
+            skip();
+            return *this;
         }
 
-        for (auto&& [var, deg] : in.factors)
+        bool operator==(iterator_t const& other) const noexcept
         {
-            out ^= std::hash<std::string>{}(var) + k + (out >> 2) + (out << 6);
-            out ^= std::hash<int>{}(deg) + k + (out >> 2) + (out << 6);
+            return i_ == other.i_;
         }
-        return out;
+
+        bool operator!=(iterator_t const& other) const noexcept
+        {
+            return i_ != other.i_;
+        }
+
+    private:
+        void skip() noexcept
+        {
+            while (i_ != capacity_ && used_[i_] == 0)
+            {
+                ++i_;
+            }
+        }
+
+        T* slots_;
+        uint8_t const* used_;
+        size_t i_;
+        size_t capacity_;
+    };
+
+    using iterator       = iterator_t<entry>;
+    using const_iterator = iterator_t<entry const>;
+
+    term_map() noexcept = default;
+    term_map(term_map const& other);
+    term_map(term_map&& other) noexcept;
+    term_map& operator=(term_map const& other);
+    term_map& operator=(term_map&& other) noexcept;
+    ~term_map();
+
+    size_t size() const noexcept
+    {
+        return size_;
     }
-};
-} // namespace std
 
-bool operator==(mon const& lhs, mon const& rhs) noexcept;
-bool operator<(mon const& lhs, mon const& rhs) noexcept;
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    iterator begin() noexcept
+    {
+        return {slots_, used_, 0, capacity_};
+    }
+
+    iterator end() noexcept
+    {
+        return {slots_, used_, capacity_, capacity_};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return {slots_, used_, 0, capacity_};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return {slots_, used_, capacity_, capacity_};
+    }
+
+    iterator find(mon const& m) noexcept;
+    const_iterator find(mon const& m) const noexcept;
+
+    // Add f to the coefficient of m, removing the term if it cancels
+    void add(mon const& m, float f);
+
+    // Ensure that n terms fit without growing the table
+    void reserve(size_t n);
+
+private:
+    size_t slot(mon const& m) const noexcept;
+    void erase(size_t i) noexcept;
+    void release() noexcept;
+
+    entry* slots_  = nullptr;
+    uint8_t* used_ = nullptr;
+    uint32_t capacity_ = 0;
+    uint32_t size_     = 0;
+};
 
 class poly
 {
 public:
     // Map from monomial to scalar coefficient
-    std::map<mon, float> terms;
+    term_map terms;
 
-    poly& push(mon const& m, float f = 1.f) noexcept;
-    poly& operator+=(poly const& other) noexcept;
-    poly& operator*=(poly const& other) noexcept;
-    poly operator-() const& noexcept;
+    poly& push(mon const& m, float f = 1.f);
+    poly& operator+=(poly const& other);
+    poly& operator*=(poly const& other);
+    poly operator-() const&;
     poly& operator-() && noexcept;
+
+    // Terms in graded lexical order of their monomials
+    std::vector<term_map::entry const*> sorted() const;
 };
 
-poly operator+(poly const& lhs, poly const& rhs) noexcept;
-poly operator*(poly const& lhs, poly const& rhs) noexcept;
+poly operator+(poly const& lhs, poly const& rhs);
+poly operator*(poly const& lhs, poly const& rhs);
 std::ostream& operator<<(std::ostream& os, poly const& p) noexcept;
\ No newline at end of file
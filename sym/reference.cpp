@@ -0,0 +1,367 @@
+#include "reference.hpp"
+
+#include "codegen.hpp"
+
+#include <klein/klein.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using namespace kln::detail;
+
+// A routine reading the registers a through d (r[0] through r[3]) and writing
+// the partitions p0 through p3
+struct reference
+{
+    char const* name;
+    char const* inputs; // Registers read by the routine
+    uint32_t outputs;   // Bit i is set if the partition pi is written
+    void (*run)(__m128 const* r, __m128* p);
+};
+
+// sw02 is omitted as its result is only projectively equivalent to the
+// sandwich product, and swo12 as it assumes that the motor is normalized
+reference const references[] = {
+    {"sw00",
+     "ab",
+     0b1,
+     [](__m128 const* r, __m128* p) { sw00(r[0], r[1], p[0]); }},
+    {"sw10",
+     "ab",
+     0b110,
+     [](__m128 const* r, __m128* p) { sw10(r[0], r[1], p[1], p[2]); }},
+    {"sw20",
+     "ab",
+     0b100,
+     [](__m128 const* r, __m128* p) { sw20(r[0], r[1], p[2]); }},
+    {"sw30",
+     "ab",
+     0b1000,
+     [](__m128 const* r, __m128* p) { sw30(r[0], r[1], p[3]); }},
+    {"sw32",
+     "ab",
+     0b1000,
+     [](__m128 const* r, __m128* p) { p[3] = sw32(r[0], r[1]); }},
+    {"swL2",
+     "acd",
+     0b110,
+     [](__m128 const* r, __m128* p) { swL2(r[0], r[3], r[2], p + 1); }},
+    {"swMM",
+     "abcd",
+     0b110,
+     [](__m128 const* r, __m128* p) {
+         __m128 in[2] = {r[0], r[3]};
+         swMM<false, true, true>(in, r[1], r + 2, p + 1);
+     }},
+    {"swMM_rotor",
+     "abd",
+     0b110,
+     [](__m128 const* r, __m128* p) {
+         __m128 in[2] = {r[0], r[3]};
+         swMM<false, false, true>(in, r[1], nullptr, p + 1);
+     }},
+    {"swMM_rotor_p1",
+     "ab",
+     0b10,
+     [](__m128 const* r, __m128* p) {
+         swMM<false, false, false>(r, r[1], nullptr, p + 1);
+     }},
+    {"swMM_apply",
+     "abcd",
+     0b110,
+     [](__m128 const* r, __m128* p) {
+         swMM_state state;
+         swMM_prepare(r[1], r[2], state);
+         __m128 in[2] = {r[0], r[3]};
+         swMM_apply(state, in, p + 1);
+     }},
+    {"sw012",
+     "abc",
+     0b1,
+     [](__m128 const* r, __m128* p) {
+         sw012<false, true>(r, r[1], r + 2, p);
+     }},
+    {"sw012_rotor",
+     "ab",
+     0b1,
+     [](__m128 const* r, __m128* p) {
+         sw012<false, false>(r, r[1], nullptr, p);
+     }},
+    {"sw012_apply",
+     "abc",
+     0b1,
+     [](__m128 const* r, __m128* p) {
+         sw012_state state;
+         sw012_prepare(r[1], r[2], state);
+         p[0] = sw012_apply(state, r[0]);
+     }},
+    {"sw312",
+     "abc",
+     0b1000,
+     [](__m128 const* r, __m128* p) {
+         sw312<false, true>(r, r[1], r + 2, p + 3);
+     }},
+    {"sw312_rotor",
+     "ab",
+     0b1000,
+     [](__m128 const* r, __m128* p) {
+         sw312<false, false>(r, r[1], nullptr, p + 3);
+     }},
+    {"sw312_apply",
+     "abc",
+     0b1000,
+     [](__m128 const* r, __m128* p) {
+         sw312_state state;
+         sw312_prepare(r[1], r[2], state);
+         p[3] = sw312_apply<true>(state, r[0]);
+     }},
+};
+
+reference const& find_reference(std::string const& name)
+{
+    auto it = std::find_if(
+        std::begin(references),
+        std::end(references),
+        [&](reference const& r) { return name == r.name; });
+    if (it != std::end(references))
+    {
+        return *it;
+    }
+
+    std::string names;
+    for (reference const& r : references)
+    {
+        names += ' ';
+        names += r.name;
+    }
+    throw std::runtime_error("Unknown routine " + name + " (expected one of"
+                             + names + ')');
+}
+
+// Draw a float uniformly from [-1, 1) with xorshift64*, which is much faster
+// than the generators of <random> for the millions of samples needed
+float uniform(uint64_t& state) noexcept
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    auto bits = static_cast<uint32_t>((state * 0x2545f4914f6cdd1d) >> 40);
+    return static_cast<float>(bits) * (2.f / 16777216.f) - 1.f;
+}
+
+std::string blade_name(uint32_t e)
+{
+    if (e == 0)
+    {
+        return "1";
+    }
+
+    std::string out = "e";
+    for (size_t i = 0; i != 9; ++i)
+    {
+        if ((e & (1 << i)) > 0)
+        {
+            out += std::to_string(i);
+        }
+    }
+    return out;
+}
+} // namespace
+
+void check_reference(std::ostream& os,
+                     std::string const& op,
+                     mv const& m,
+                     samples const& values,
+                     size_t count)
+{
+    reference const& ref = find_reference(op);
+    evaluator ev{m};
+    size_t const none = std::numeric_limits<size_t>::max();
+
+    // Register and lane of each variable along with the values bound to it
+    struct input
+    {
+        size_t reg;
+        size_t lane;
+        float const* values;
+    };
+    std::vector<input> inputs;
+    std::string bound;
+    for (std::string const& var : ev.variables())
+    {
+        if (var.size() != 2 || var[1] < '0' || var[1] > '3'
+            || std::strchr(ref.inputs, var[0]) == nullptr)
+        {
+            throw std::runtime_error(var + " is not an input of " + op
+                                     + " (registers " + ref.inputs + ')');
+        }
+
+        input in{static_cast<size_t>(var[0] - 'a'),
+                 static_cast<size_t>(var[1] - '0'),
+                 nullptr};
+        auto it = values.find(var);
+        if (it != values.end())
+        {
+            if (!bound.empty() && it->second.size() != count)
+            {
+                throw std::runtime_error("The values of " + bound + " and "
+                                         + var + " differ in number");
+            }
+            bound     = var;
+            count     = it->second.size();
+            in.values = it->second.data();
+        }
+        inputs.push_back(in);
+    }
+
+    // Coefficient of m stored in each lane of the partitions written
+    struct output
+    {
+        size_t partition;
+        size_t lane;
+        size_t coef;
+        float sign;
+    };
+    std::vector<output> outputs;
+    std::vector<bool> written(ev.blades().size());
+    for (size_t p = 0; p != 4; ++p)
+    {
+        if ((ref.outputs & (1 << p)) == 0)
+        {
+            continue;
+        }
+
+        for (size_t l = 0; l != 4; ++l)
+        {
+            lane_blade lb
+                = klein_lane(static_cast<int>(p), static_cast<int>(l));
+            auto it
+                = std::find(ev.blades().begin(), ev.blades().end(), lb.blade);
+            size_t coef = none;
+            if (it != ev.blades().end())
+            {
+                coef          = it - ev.blades().begin();
+                written[coef] = true;
+            }
+            outputs.push_back({p, l, coef, lb.sign});
+        }
+    }
+    for (size_t j = 0; j != written.size(); ++j)
+    {
+        if (!written[j])
+        {
+            throw std::runtime_error(op + " does not compute the "
+                                     + blade_name(ev.blades()[j])
+                                     + " component");
+        }
+    }
+
+    uint64_t state = 0x9e3779b97f4a7c15;
+
+    // Samples are drawn and compared a chunk at a time
+    constexpr size_t chunk = 4096;
+    std::vector<std::vector<float>> drawn(inputs.size(),
+                                          std::vector<float>(chunk));
+    std::vector<std::vector<float>> results(ev.blades().size(),
+                                            std::vector<float>(chunk));
+    std::vector<float const*> in(inputs.size());
+    std::vector<float*> out;
+    for (auto& r : results)
+    {
+        out.push_back(r.data());
+    }
+
+    float worst            = 0.f;
+    size_t worst_sample    = 0;
+    output worst_output    = {};
+    float worst_expected   = 0.f;
+    float worst_actual     = 0.f;
+    for (size_t first = 0; first < count; first += chunk)
+    {
+        size_t n = std::min(chunk, count - first);
+        for (size_t v = 0; v != inputs.size(); ++v)
+        {
+            if (inputs[v].values != nullptr)
+            {
+                in[v] = inputs[v].values + first;
+                continue;
+            }
+
+            for (size_t i = 0; i != n; ++i)
+            {
+                drawn[v][i] = uniform(state);
+            }
+            in[v] = drawn[v].data();
+        }
+
+        ev.run(in.data(), out.data(), n);
+
+        for (size_t i = 0; i != n; ++i)
+        {
+            alignas(16) float r[4][4] = {};
+            for (size_t v = 0; v != inputs.size(); ++v)
+            {
+                r[inputs[v].reg][inputs[v].lane] = in[v][i];
+            }
+
+            __m128 registers[4];
+            __m128 partitions[4];
+            for (size_t k = 0; k != 4; ++k)
+            {
+                registers[k]  = _mm_load_ps(r[k]);
+                partitions[k] = _mm_setzero_ps();
+            }
+
+            ref.run(registers, partitions);
+
+            alignas(16) float p[4][4];
+            for (size_t k = 0; k != 4; ++k)
+            {
+                _mm_store_ps(p[k], partitions[k]);
+            }
+
+            for (output const& o : outputs)
+            {
+                float expected
+                    = o.coef == none ? 0.f : o.sign * results[o.coef][i];
+                float actual = p[o.partition][o.lane];
+                float difference = std::abs(actual - expected)
+                                   / std::max(1.f, std::abs(expected));
+                if (std::isnan(difference))
+                {
+                    difference = std::numeric_limits<float>::infinity();
+                }
+
+                if (difference > worst)
+                {
+                    worst          = difference;
+                    worst_sample   = first + i;
+                    worst_output   = o;
+                    worst_expected = expected;
+                    worst_actual   = actual;
+                }
+            }
+        }
+    }
+
+    if (worst > reference_tolerance)
+    {
+        std::ostringstream message;
+        message << op << " differs by " << worst << " in lane "
+                << worst_output.lane << " of p" << worst_output.partition
+                << " of sample " << worst_sample << " (expected "
+                << worst_expected << ", computed " << worst_actual << ')';
+        throw std::runtime_error(message.str());
+    }
+
+    os << "# " << op << ": " << count << " samples, max difference " << worst
+       << '\n';
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ga.hpp"
+#include "numeric.hpp"
+
+#include <iostream>
+#include <string>
+
+// Largest difference permitted between a Klein routine and an expression,
+// relative to the magnitude of the expected value where it exceeds one
+constexpr float reference_tolerance = 1e-4f;
+
+// Compare the multivector m against the sandwich routine of
+// klein/detail/x86/x86_sandwich.hpp named op (e.g. sw312) over count samples
+// and print the largest difference found.
+//
+// As with emit_kernel, each variable of m must be named by a register and a
+// lane. The registers a through d are passed to the routine as the arguments
+// of the same name in its implementation, and the partitions it writes are
+// compared with the components of m. Variables bound in values take those
+// values, in which case there are as many samples as values. The others are
+// drawn uniformly from [-1, 1] with a fixed seed so that the results are
+// reproducible, and lanes without a variable are zero.
+//
+// Throws std::runtime_error if op is unknown, if m does not match its
+// inputs and outputs, or if any difference exceeds reference_tolerance.
+void check_reference(std::ostream& os,
+                     std::string const& op,
+                     mv const& m,
+                     samples const& values,
+                     size_t count);
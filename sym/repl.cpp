@@ -1,8 +1,13 @@
 #include "repl.hpp"
 
+#include "codegen.hpp"
+#include "numeric.hpp"
 #include "parser.hpp"
+#include "reference.hpp"
+#include "schedule.hpp"
 
 #include <iostream>
+#include <sstream>
 #include <string>
 
 enum codes
@@ -15,65 +20,207 @@ void repl::run()
 {
     // Allow specification of algebra
     algebra a{3, 0, 1};
+    bindings b;
+    samples s;
     for (std::string line; std::getline(std::cin, line);)
     {
-        if (line.empty())
+        eval(line, a, b, s, std::cout, std::cerr);
+    }
+}
+
+void repl::eval(std::string const& line,
+                algebra const& a,
+                bindings& b,
+                samples& s,
+                std::ostream& out,
+                std::ostream& err)
+{
+    if (line.empty())
+    {
+        out << std::endl;
+        return;
+    }
+
+    // Skip lines that only contain whitespace or commas
+    bool should_parse  = false;
+    bool issue_command = false;
+    for (auto c : line)
+    {
+        if (std::isspace(c))
         {
-            std::cout << std::endl;
             continue;
         }
+        else if (c == '#')
+        {
+            // Lines that begin with a # are comments
+            // Echo them in the output
+            out << line;
+            break;
+        }
+        else if (c == '.')
+        {
+            // Lines that start with a . are commands
+            issue_command = true;
+            break;
+        }
+        else
+        {
+            should_parse = true;
+        }
+    }
 
-        // Skip lines that only contain whitespace or commas
-        bool should_parse  = false;
-        bool issue_command = false;
-        for (auto c : line)
+    if (issue_command)
+    {
+        try
         {
-            if (std::isspace(c))
-            {
-                continue;
-            }
-            else if (c == '#')
-            {
-                // Lines that begin with a # are comments
-                // Echo them in the output
-                std::cout << line;
-                break;
-            }
-            else if (c == '.')
-            {
-                // Lines that start with a . are commands
-                issue_command = true;
-                break;
-            }
-            else
-            {
-                should_parse = true;
-            }
+            command(line, a, b, s, out);
+        }
+        catch (const std::runtime_error& e)
+        {
+            err << e.what() << '\n';
+        }
+        return;
+    }
+    else if (!should_parse)
+    {
+        out << std::endl;
+        return;
+    }
+
+    try
+    {
+        mv result = parse(line, a, &b);
+        out << result << std::endl;
+    }
+    catch (const std::runtime_error& e)
+    {
+        err << e.what() << '\n';
+    }
+}
+
+void repl::command(std::string const& line,
+                   algebra const& a,
+                   bindings& b,
+                   samples& s,
+                   std::ostream& out)
+{
+    std::istringstream is{line};
+    std::string cmd;
+    is >> cmd;
+
+    if (cmd == ".break")
+    {
+        break_lines = !break_lines;
+        return;
+    }
+    else if (cmd == ".schedule")
+    {
+        // .schedule <expr>
+        std::string expr;
+        std::getline(is, expr);
+        mv result = parse(expr, a, &b);
+        out << "# expanded: " << expanded_cost(result) << '\n';
+        std::ostringstream program;
+        program_stats stats = emit_program(program, result);
+        out << "# scheduled: " << stats << '\n' << program.str();
+        return;
+    }
+    else if (cmd == ".values")
+    {
+        // .values <var> = <value> ...
+        std::string name;
+        std::string eq;
+        is >> name >> eq;
+        if (name.empty() || eq != "=")
+        {
+            throw std::runtime_error("Expected .values <var> = <value> ...");
         }
 
-        if (issue_command)
+        std::vector<float> values;
+        for (std::string token; is >> token;)
         {
-            // TODO replace with an actual command parser
-            if (line == ".break")
+            std::istringstream value{token};
+            float f;
+            if (!(value >> f) || !value.eof())
             {
-                break_lines = !break_lines;
+                throw std::runtime_error("Invalid value " + token);
             }
-            continue;
+            values.push_back(f);
         }
-        else if (!should_parse)
+
+        // A variable is either bound to a multivector or to values
+        b.erase(name);
+        if (values.empty())
         {
-            std::cout << std::endl;
-            continue;
+            s.erase(name);
         }
-
-        try
+        else
         {
-            mv result = parse(line, a);
-            std::cout << result << std::endl;
+            s.insert_or_assign(name, std::move(values));
         }
-        catch (const std::runtime_error& e)
+        return;
+    }
+    else if (cmd == ".eval")
+    {
+        // .eval <expr>
+        std::string expr;
+        std::getline(is, expr);
+        print_samples(out, parse(expr, a, &b), s);
+        return;
+    }
+    else if (cmd == ".check")
+    {
+        // .check <routine> [<samples>] = <expr>
+        std::string routine;
+        std::string eq;
+        is >> routine >> eq;
+        size_t count = 1000000;
+        if (!eq.empty() && eq != "=")
         {
-            std::cerr << e.what() << '\n';
+            std::istringstream value{eq};
+            if (!(value >> count) || !value.eof())
+            {
+                throw std::runtime_error("Invalid sample count " + eq);
+            }
+            is >> eq;
         }
+        if (routine.empty() || eq != "=")
+        {
+            throw std::runtime_error(
+                "Expected .check <routine> [<samples>] = <expr>");
+        }
+
+        std::string expr;
+        std::getline(is, expr);
+        check_reference(out, routine, parse(expr, a, &b), s, count);
+        return;
+    }
+    else if (cmd != ".let" && cmd != ".kernel")
+    {
+        throw std::runtime_error("Unknown command " + cmd);
+    }
+
+    // .let <name> = <expr>
+    // .kernel <name> = <expr>
+    std::string name;
+    std::string eq;
+    is >> name >> eq;
+    if (name.empty() || eq != "=")
+    {
+        throw std::runtime_error("Expected " + cmd + " <name> = <expr>");
+    }
+    std::string expr;
+    std::getline(is, expr);
+
+    mv result = parse(expr, a, &b);
+    if (cmd == ".let")
+    {
+        s.erase(name);
+        b.insert_or_assign(name, std::move(result));
+    }
+    else
+    {
+        size_t start = expr.find_first_not_of(' ');
+        emit_kernel(out, name, result, expr.substr(start));
     }
 }
\ No newline at end of file
@@ -1,10 +1,39 @@
 #pragma once
 
+#include "numeric.hpp"
+#include "parser.hpp"
+
+#include <iostream>
+#include <string>
+
 class repl
 {
 public:
     void run();
 
+    // Evaluate a single line of input against the bindings b and the values
+    // of variables s, writing its result to out and any error to err
+    void eval(std::string const& line,
+              algebra const& a,
+              bindings& b,
+              samples& s,
+              std::ostream& out,
+              std::ostream& err);
+
 private:
+    // Lines starting with a . are commands:
+    //   .let <name> = <expr>     binds the result of expr to name
+    //   .kernel <name> = <expr>  prints an SSE kernel evaluating expr
+    //   .schedule <expr>         prints a factored straight-line program
+    //   .values <var> = <v> ...  binds values to a variable (none to unbind)
+    //   .eval <expr>             prints the value of expr for each value
+    //   .check <routine> [<samples>] = <expr>
+    //                            compares expr against a Klein routine
+    void command(std::string const& line,
+                 algebra const& a,
+                 bindings& b,
+                 samples& s,
+                 std::ostream& out);
+
     bool break_lines = false;
 };
\ No newline at end of file
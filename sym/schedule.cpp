@@ -0,0 +1,425 @@
+#include "schedule.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+std::ostream& operator<<(std::ostream& os, program_stats const& s) noexcept
+{
+    os << s.muls << " muls, " << s.adds << " adds";
+    return os;
+}
+
+program_stats expanded_cost(mv const& m) noexcept
+{
+    program_stats out;
+    for (auto&& [e, p] : m.terms)
+    {
+        for (auto&& [mon, coef] : p.terms)
+        {
+            int deg = 0;
+            for (int8_t d : mon.exponents)
+            {
+                deg += std::abs(d);
+            }
+
+            if (deg > 0)
+            {
+                out.muls += deg - 1;
+                if (std::abs(coef) != 1.f)
+                {
+                    ++out.muls;
+                }
+            }
+        }
+        out.adds += static_cast<int>(p.terms.size()) - 1;
+    }
+    return out;
+}
+
+namespace
+{
+enum class op
+{
+    variable,
+    constant,
+    mul,
+    add,
+    sub,
+    neg
+};
+
+struct node
+{
+    op type;
+    size_t lhs = 0;
+    size_t rhs = 0;
+    float value = 0.f;
+    std::string name;
+};
+
+// A node along with a numeric factor that is yet to be applied to it. Scales
+// are propagated upwards so that they can be merged or folded into
+// subtractions.
+struct scaled
+{
+    size_t id;
+    float scale;
+};
+
+// Expression graph in which every node is unique
+class graph
+{
+public:
+    std::vector<node> nodes;
+
+    size_t variable(std::string const& name)
+    {
+        return intern({op::variable, 0, 0, 0.f, name});
+    }
+
+    size_t constant(float value)
+    {
+        return intern({op::constant, 0, 0, value, {}});
+    }
+
+    size_t binary(op type, size_t lhs, size_t rhs)
+    {
+        if ((type == op::mul || type == op::add) && rhs < lhs)
+        {
+            std::swap(lhs, rhs);
+        }
+        return intern({type, lhs, rhs, 0.f, {}});
+    }
+
+    // The node multiplied by the magnitude of its scale
+    size_t apply_magnitude(scaled s)
+    {
+        float scale = std::abs(s.scale);
+        if (nodes[s.id].type == op::constant)
+        {
+            return constant(nodes[s.id].value * scale);
+        }
+        else if (scale == 1.f)
+        {
+            return s.id;
+        }
+        return binary(op::mul, constant(scale), s.id);
+    }
+
+    // The node multiplied by its scale
+    size_t apply(scaled s)
+    {
+        size_t out = apply_magnitude(s);
+        if (s.scale < 0.f)
+        {
+            return intern({op::neg, out, 0, 0.f, {}});
+        }
+        return out;
+    }
+
+    scaled monomial(mon const& m, float coef)
+    {
+        size_t out  = 0;
+        bool first = true;
+        for (auto&& [var, deg] : m.factors())
+        {
+            for (int i = 0; i != deg; ++i)
+            {
+                size_t v = variable(var_name(var));
+                out      = first ? v : binary(op::mul, out, v);
+                first    = false;
+            }
+        }
+
+        if (first)
+        {
+            return {constant(1.f), coef};
+        }
+        return {out, coef};
+    }
+
+    scaled sum(std::vector<scaled> terms)
+    {
+        // Leading with a positive term avoids a negation. If there is none,
+        // the negation is deferred to the caller instead.
+        std::stable_partition(terms.begin(), terms.end(), [](scaled const& s) {
+            return s.scale > 0.f;
+        });
+        float sign = terms.front().scale < 0.f ? -1.f : 1.f;
+
+        size_t out = apply_magnitude(terms.front());
+        for (size_t i = 1; i != terms.size(); ++i)
+        {
+            out = binary(terms[i].scale * sign > 0.f ? op::add : op::sub,
+                         out,
+                         apply_magnitude(terms[i]));
+        }
+        return {out, sign};
+    }
+
+    scaled factor(poly const& p)
+    {
+        // Terms are visited in a fixed order so that the program does not
+        // depend on the layout of the polynomial
+        auto terms = p.sorted();
+        if (terms.size() == 1)
+        {
+            return monomial(terms.front()->first, terms.front()->second);
+        }
+
+        // Pull out a numeric factor common to all terms
+        float c = std::abs(terms.front()->second);
+        if (c != 1.f && std::all_of(terms.begin(), terms.end(), [c](auto t) {
+                return std::abs(t->second) == c;
+            }))
+        {
+            poly q;
+            for (auto t : terms)
+            {
+                q.push(t->first, t->second / c);
+            }
+            scaled out = factor(q);
+            out.scale *= c;
+            return out;
+        }
+
+        // Find the variable occurring in the most terms
+        // Ties are broken by name
+        std::map<std::string, std::pair<int, var_id>> counts;
+        for (auto t : terms)
+        {
+            for (auto&& [var, deg] : t->first.factors())
+            {
+                if (deg > 0)
+                {
+                    auto& count = counts[var_name(var)];
+                    ++count.first;
+                    count.second = var;
+                }
+            }
+        }
+
+        var_id x = 0;
+        int best = 1;
+        for (auto&& [name, count] : counts)
+        {
+            if (count.first > best)
+            {
+                x    = count.second;
+                best = count.first;
+            }
+        }
+
+        if (best == 1)
+        {
+            std::vector<scaled> monomials;
+            for (auto t : terms)
+            {
+                monomials.push_back(monomial(t->first, t->second));
+            }
+            return sum(std::move(monomials));
+        }
+
+        // p = x q + r
+        poly q;
+        poly r;
+        for (auto t : terms)
+        {
+            if (t->first.exponents[x] > 0)
+            {
+                mon reduced = t->first;
+                reduced.push(x, -1);
+                q.push(reduced, t->second);
+            }
+            else
+            {
+                r.push(t->first, t->second);
+            }
+        }
+
+        scaled xq = factor(q);
+        if (nodes[xq.id].type == op::constant)
+        {
+            xq.scale *= nodes[xq.id].value;
+            xq.id = variable(var_name(x));
+        }
+        else
+        {
+            xq.id = binary(op::mul, variable(var_name(x)), xq.id);
+        }
+        if (r.terms.empty())
+        {
+            return xq;
+        }
+        return sum({xq, factor(r)});
+    }
+
+private:
+    size_t intern(node n)
+    {
+        auto key = std::make_tuple(n.type, n.lhs, n.rhs, n.value, n.name);
+        auto it  = ids_.find(key);
+        if (it != ids_.end())
+        {
+            return it->second;
+        }
+
+        nodes.push_back(std::move(n));
+        ids_.emplace(std::move(key), nodes.size() - 1);
+        return nodes.size() - 1;
+    }
+
+    std::map<std::tuple<op, size_t, size_t, float, std::string>, size_t> ids_;
+};
+
+std::string literal(float f)
+{
+    std::ostringstream os;
+    os << f;
+    return os.str();
+}
+
+std::string blade(uint32_t e)
+{
+    if (e == 0)
+    {
+        return "scalar";
+    }
+
+    std::string out = "e";
+    for (size_t i = 0; i != 9; ++i)
+    {
+        if ((e & (1 << i)) > 0)
+        {
+            out += std::to_string(i);
+        }
+    }
+    return out;
+}
+
+// Emits the operations of a graph in depth-first order
+class scheduler
+{
+public:
+    scheduler(graph const& g, std::ostream& os)
+        : g_{g}
+        , os_{os}
+        , names_(g.nodes.size())
+        , uses_(g.nodes.size())
+    {}
+
+    void use(size_t id)
+    {
+        if (uses_[id]++ > 0)
+        {
+            return;
+        }
+
+        node const& n = g_.nodes[id];
+        if (n.type != op::variable && n.type != op::constant)
+        {
+            use(n.lhs);
+            if (n.type != op::neg)
+            {
+                use(n.rhs);
+            }
+        }
+    }
+
+    // Emit the node id (and the nodes it depends on) if needed and return the
+    // name of its value. A node used only by the output is given the name of
+    // the output.
+    std::string emit(size_t id, std::string const& output = {})
+    {
+        if (!names_[id].empty())
+        {
+            return names_[id];
+        }
+
+        node const& n = g_.nodes[id];
+        if (n.type == op::variable)
+        {
+            return n.name;
+        }
+        else if (n.type == op::constant)
+        {
+            return literal(n.value);
+        }
+
+        // Operands are emitted before the operation itself
+        std::string lhs = emit(n.lhs);
+        std::string rhs = n.type == op::neg ? std::string{} : emit(n.rhs);
+        std::string name
+            = output.empty() || uses_[id] > 1 ? "t" + std::to_string(temps_++)
+                                              : output;
+        os_ << name << " = ";
+
+        switch (n.type)
+        {
+        case op::mul:
+            os_ << lhs << " * " << rhs;
+            ++stats.muls;
+            break;
+        case op::add:
+            os_ << lhs << " + " << rhs;
+            ++stats.adds;
+            break;
+        case op::sub:
+            os_ << lhs << " - " << rhs;
+            ++stats.adds;
+            break;
+        case op::neg:
+            os_ << '-' << lhs;
+            ++stats.adds;
+            break;
+        default:
+            break;
+        }
+        os_ << '\n';
+
+        names_[id] = name;
+        return name;
+    }
+
+    program_stats stats;
+
+private:
+    graph const& g_;
+    std::ostream& os_;
+    std::vector<std::string> names_;
+    std::vector<int> uses_;
+    int temps_ = 0;
+};
+} // namespace
+
+program_stats emit_program(std::ostream& os, mv const& m)
+{
+    graph g;
+    std::vector<std::pair<std::string, size_t>> outputs;
+    for (auto&& [e, p] : m.terms)
+    {
+        outputs.emplace_back(blade(e), g.apply(g.factor(p)));
+    }
+
+    scheduler s{g, os};
+    for (auto&& [name, id] : outputs)
+    {
+        s.use(id);
+    }
+
+    for (auto&& [name, id] : outputs)
+    {
+        std::string value = s.emit(id, name);
+        if (value != name)
+        {
+            os << name << " = " << value << '\n';
+        }
+    }
+
+    return s.stats;
+}
\ No newline at end of file
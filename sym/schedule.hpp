@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ga.hpp"
+
+#include <iostream>
+
+// Operation counts of a straight-line program
+struct program_stats
+{
+    int muls = 0;
+    int adds = 0; // Additions, subtractions, and negations
+};
+
+std::ostream& operator<<(std::ostream& os, program_stats const& s) noexcept;
+
+// Cost of evaluating the polynomials of m as the expanded sums of monomials
+// they are stored as
+program_stats expanded_cost(mv const& m) noexcept;
+
+// Print a straight-line program evaluating the coefficients of m, one
+// operation per line, and return its cost.
+//
+// Each polynomial is factored Horner-style by repeatedly pulling out the
+// variable occurring in the most terms (e.g. a b + a c + d becomes
+// a (b + c) + d) along with numeric factors common to all terms. The
+// resulting expressions of all coefficients are merged into a single graph
+// in which identical subexpressions (such as a product b0 c1 or a factored
+// sum shared by several coefficients) are computed once. Operations are
+// scheduled depth-first, in the order of the coefficients, so that values
+// are consumed shortly after they are produced.
+program_stats emit_program(std::ostream& os, mv const& m);
\ No newline at end of file
@@ -1,9 +1,15 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
+#include "codegen.hpp"
 #include "ga.hpp"
+#include "numeric.hpp"
 #include "parser.hpp"
 #include "poly.hpp"
+#include "reference.hpp"
+#include "schedule.hpp"
+
+#include <sstream>
 
 TEST_CASE("monomial-product")
 {
@@ -18,8 +24,8 @@ TEST_CASE("monomial-product")
     // ab
     mon m3 = m1 * m2;
 
-    CHECK_EQ(m3.factors["a"], 1);
-    CHECK_EQ(m3.factors["b"], 1);
+    CHECK_EQ(m3.exponent("a"), 1);
+    CHECK_EQ(m3.exponent("b"), 1);
 }
 
 TEST_CASE("polynomial")
@@ -77,6 +83,38 @@ TEST_CASE("polynomial")
         CHECK_EQ(p3.terms.find(a2)->second, 1.f);
         CHECK_EQ(p3.terms.find(b2)->second, -1.f);
     }
+
+    SUBCASE("cancellation")
+    {
+        // (a + b)^8 has 9 terms, which grows the table and displaces entries
+        // from their home slots
+        poly p3 = p_one;
+        for (int i = 0; i != 8; ++i)
+        {
+            p3 *= p1;
+        }
+        CHECK_EQ(p3.terms.size(), 9);
+
+        // Removing every other term must leave the rest reachable
+        poly p4 = p3;
+        for (auto t : p3.sorted())
+        {
+            if (t->first.exponent("a") % 2 == 0)
+            {
+                p4.push(t->first, -t->second);
+            }
+        }
+        CHECK_EQ(p4.terms.size(), 4);
+        for (auto t : p3.sorted())
+        {
+            bool odd = t->first.exponent("a") % 2 == 1;
+            CHECK_EQ(p4.terms.find(t->first) != p4.terms.end(), odd);
+        }
+
+        std::ostringstream os;
+        os << p4;
+        CHECK_EQ(os.str(), "(8a b^7 + 56a^3 b^5 + 56a^5 b^3 + 8a^7 b)");
+    }
 }
 
 TEST_CASE("ga")
@@ -216,6 +254,20 @@ TEST_CASE("parser")
         CHECK_EQ(mv1.terms[0b101].terms.begin()->second, -1.f);
     }
 
+    SUBCASE("bindings")
+    {
+        bindings b;
+        b.emplace("r", parse("2 + 3e12 + 4e31", pga));
+        b.emplace("p", parse("5e0 + 7e1 + 11e2", pga));
+        mv mv1 = parse("r * p * ~r", pga, &b);
+        CHECK_EQ(mv1.terms[1].terms.begin()->second, 145.f);
+        CHECK_EQ(mv1.terms[0b1000].terms.begin()->second, 376.f);
+
+        // Unbound identifiers remain scalar variables
+        mv mv2 = parse("r * q", pga, &b);
+        CHECK_EQ(mv2.terms.size(), 3);
+    }
+
     SUBCASE("rotor")
     {
         mv mv1 = parse(
@@ -225,4 +277,163 @@ TEST_CASE("parser")
         CHECK_EQ(mv1.terms[0b100].terms.begin()->second, 37.f);
         CHECK_EQ(mv1.terms[0b1000].terms.begin()->second, 376.f);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("codegen")
+{
+    algebra pga{3, 0, 1};
+
+    SUBCASE("identity")
+    {
+        std::ostringstream os;
+        kernel_stats s
+            = emit_kernel(os, "k", parse("a0 e0 + a1 e1 + a2 e2 + a3 e3", pga));
+        CHECK_EQ(s.total(), 0);
+        CHECK_NE(os.str().find("(__m128 a, __m128& p0_out)"), std::string::npos);
+        CHECK_NE(os.str().find("p0_out = a;"), std::string::npos);
+    }
+
+    SUBCASE("swizzle")
+    {
+        std::ostringstream os;
+        kernel_stats s = emit_kernel(
+            os, "k", parse("a1 e123 + a0 e032 + a3 e013 + a2 e021", pga));
+        CHECK_EQ(s.swizzles, 1);
+        CHECK_EQ(s.xors, 0);
+        CHECK_EQ(s.total(), 1);
+        CHECK_NE(os.str().find("KLN_SWIZZLE(a, 2, 3, 0, 1)"), std::string::npos);
+    }
+
+    SUBCASE("shared-swizzles")
+    {
+        // Both sums read a in place and the scalar lane of b broadcast
+        std::ostringstream os;
+        kernel_stats s = emit_kernel(
+            os,
+            "k",
+            parse("(a0 e0 + a1 e1 + a2 e2 + a3 e3) * b0 + "
+                  "(a0 e0123 + a1 e01 + a2 e02 + a3 e03) * b0",
+                  pga));
+        CHECK_EQ(s.swizzles, 1);
+        CHECK_EQ(s.muls, 1);
+        CHECK_EQ(s.total(), 2);
+        CHECK_NE(os.str().find("p2_out"), std::string::npos);
+    }
+
+    SUBCASE("motor-point")
+    {
+        // Squares of the rotor components are shared between the lanes
+        std::ostringstream os;
+        kernel_stats s = emit_kernel(
+            os,
+            "k",
+            parse("(b0 + b1 e23 + b2 e31 + b3 e12) * (a0 e123 + a1 e032 + a2 "
+                  "e013 + a3 e021) * (b0 - b1 e23 - b2 e31 - b3 e12)",
+                  pga));
+        CHECK_GT(s.fmas, 0);
+        CHECK_LT(s.total_fma(), s.total());
+        CHECK_NE(os.str().find("_mm_mul_ps(b, b)"), std::string::npos);
+    }
+}
+
+TEST_CASE("schedule")
+{
+    algebra pga{3, 0, 1};
+
+    SUBCASE("horner")
+    {
+        // a c + a d + b c + b d = a (c + d) + b (c + d)
+        mv mv1 = parse("(a + b) * (c + d)", pga);
+        CHECK_EQ(expanded_cost(mv1).muls, 4);
+        CHECK_EQ(expanded_cost(mv1).adds, 3);
+
+        std::ostringstream os;
+        program_stats s = emit_program(os, mv1);
+        CHECK_EQ(s.muls, 2);
+        CHECK_EQ(s.adds, 2);
+        CHECK_NE(os.str().find("t0 = c + d\n"), std::string::npos);
+    }
+
+    SUBCASE("common-factor")
+    {
+        // 2 a b - 2 a c = 2 (a (b - c))
+        std::ostringstream os;
+        program_stats s = emit_program(os, parse("2 * a * b e0 - 2 * a * c e0", pga));
+        CHECK_EQ(s.muls, 2);
+        CHECK_EQ(s.adds, 1);
+    }
+
+    SUBCASE("shared-products")
+    {
+        std::ostringstream os;
+        program_stats s
+            = emit_program(os, parse("a * b e0 + a * b e1 - a * b e2", pga));
+        CHECK_EQ(s.muls, 1);
+        CHECK_EQ(s.adds, 1);
+        CHECK_NE(os.str().find("e2 = -t0\n"), std::string::npos);
+    }
+
+    SUBCASE("motor-point")
+    {
+        std::ostringstream os;
+        mv mv1 = parse(
+            "(b0 + b1 e23 + b2 e31 + b3 e12 + c1 e01 + c2 e02 + c3 e03 + c0 "
+            "e0123) * (a0 e123 + a1 e032 + a2 e013 + a3 e021) * (b0 - b1 e23 - "
+            "b2 e31 - b3 e12 - c1 e01 - c2 e02 - c3 e03 + c0 e0123)",
+            pga);
+        program_stats s = emit_program(os, mv1);
+        CHECK_LT(s.muls, expanded_cost(mv1).muls / 2);
+        CHECK_LE(s.adds, expanded_cost(mv1).adds);
+    }
+}
+
+TEST_CASE("numeric")
+{
+    algebra pga{3, 0, 1};
+
+    SUBCASE("evaluate")
+    {
+        samples s;
+        s["a"] = {1.f, 2.f, -1.f};
+        s["b"] = {3.f, 0.5f, 2.f};
+
+        std::ostringstream os;
+        print_samples(os, parse("a * b e0 + a e1 - b e1 + 2", pga), s);
+        CHECK_EQ(os.str(),
+                 "2 + 3 e0 + -2 e1\n2 + 1 e0 + 1.5 e1\n2 + -2 e0 + -3 e1\n");
+    }
+
+    SUBCASE("shared-products")
+    {
+        // a b c extends a b
+        evaluator ev{parse("a * b e0 + a * b * c e1", pga)};
+        CHECK_EQ(ev.variables().size(), 3);
+        CHECK_EQ(ev.blades().size(), 2);
+
+        // Enough samples to span a partial block
+        std::vector<float> values(100, 2.f);
+        float const* inputs[] = {values.data(), values.data(), values.data()};
+        std::vector<float> e0(100);
+        std::vector<float> e1(100);
+        float* outputs[] = {e0.data(), e1.data()};
+        ev.run(inputs, outputs, 100);
+        CHECK_EQ(e0[99], 4.f);
+        CHECK_EQ(e1[99], 8.f);
+    }
+
+    SUBCASE("reference")
+    {
+        std::ostringstream os;
+        check_reference(
+            os,
+            "sw312",
+            parse("(b0 + b1 e23 + b2 e31 + b3 e12 + c1 e01 + c2 e02 + c3 e03 + "
+                  "c0 e0123) * (a0 e123 + a1 e032 + a2 e013 + a3 e021) * (b0 - "
+                  "b1 e23 - b2 e31 - b3 e12 - c1 e01 - c2 e02 - c3 e03 + c0 "
+                  "e0123)",
+                  pga),
+            {},
+            1000);
+        CHECK_EQ(os.str().find("# sw312: 1000 samples"), 0);
+    }
+}
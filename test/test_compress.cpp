@@ -0,0 +1,75 @@
+#include <doctest/doctest.h>
+
+#include <klein/klein.hpp>
+
+#include <cmath>
+
+using namespace kln;
+
+namespace
+{
+motor make_motor(size_t i)
+{
+    float f = static_cast<float>(i);
+    rotor r{0.7f * f - 4.f, std::sin(f), std::cos(3.f * f), 0.5f - 0.1f * f};
+    translator t{0.2f * f - 3.f, std::cos(f), 1.f, std::sin(2.f * f)};
+    return t * r;
+}
+
+float max_difference(motor const& a, motor const& b)
+{
+    float const* fa = reinterpret_cast<float const*>(&a);
+    float const* fb = reinterpret_cast<float const*>(&b);
+    float out       = 0.f;
+    for (size_t i = 0; i != 8; ++i)
+    {
+        float d = std::abs(fa[i] - fb[i]);
+        out     = d > out ? d : out;
+    }
+    return out;
+}
+} // namespace
+
+TEST_CASE("compressed-motor-size")
+{
+    CHECK_EQ(sizeof(compressed_motor), 12);
+}
+
+TEST_CASE("compressed-motor-round-trip")
+{
+    // 37 exercises full blocks and a partial block for every SIMD width
+    constexpr size_t count = 37;
+    motor in[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        in[i] = make_motor(i);
+    }
+    // Each rotor component can be the dropped one
+    in[0] = motor{translator{2.f, 1.f, 0.f, 0.f}};
+    in[1] = rotor{kln::pi, 1.f, 0.f, 0.f} * translator{1.f, 0.f, 1.f, 0.f};
+    in[2] = rotor{kln::pi, 0.f, 1.f, 0.f} * translator{1.f, 0.f, 0.f, 1.f};
+    in[3] = rotor{kln::pi, 0.f, 0.f, 1.f} * translator{1.f, 1.f, 1.f, 1.f};
+    // A negative scalar
+    in[4] = -in[5];
+
+    compressed_motor packed[count];
+    encode(in, packed, count, 8.f);
+    motor out[count];
+    decode(packed, out, count, 8.f);
+
+    point p{1.f, -2.f, 3.f};
+    for (size_t i = 0; i != count; ++i)
+    {
+        // The decoded motor may have the opposite sign
+        float dot = out[i].scalar() * in[i].scalar() + out[i].e23() * in[i].e23()
+                    + out[i].e31() * in[i].e31() + out[i].e12() * in[i].e12();
+        motor m = dot < 0.f ? -out[i] : out[i];
+        CHECK_LT(max_difference(m, in[i]), 2e-4f);
+
+        point expected = in[i](p);
+        point actual   = out[i](p);
+        CHECK_EQ(actual.x(), doctest::Approx(expected.x()).epsilon(1e-3));
+        CHECK_EQ(actual.y(), doctest::Approx(expected.y()).epsilon(1e-3));
+        CHECK_EQ(actual.z(), doctest::Approx(expected.z()).epsilon(1e-3));
+    }
+}
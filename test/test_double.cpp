@@ -0,0 +1,196 @@
+#include <doctest/doctest.h>
+
+#include <klein/double.hpp>
+#include <klein/klein.hpp>
+
+#include <cmath>
+
+using namespace kln;
+
+TEST_CASE("double-swizzle")
+{
+    __m128 a        = _mm_set_ps(4.f, 3.f, 2.f, 1.f);
+    detail::f64x4 b = detail::f64_set(4.0, 3.0, 2.0, 1.0);
+
+    float af[4];
+    double bd[4];
+    _mm_storeu_ps(af, KLN_SWIZZLE(a, 1, 3, 2, 0));
+    detail::f64_storeu(bd, detail::f64_swizzle<1, 3, 2, 0>(b));
+    for (size_t i = 0; i != 4; ++i)
+    {
+        CHECK_EQ(bd[i], static_cast<double>(af[i]));
+    }
+
+    _mm_storeu_ps(af, KLN_SWIZZLE(a, 0, 0, 0, 2));
+    detail::f64_storeu(bd, detail::f64_swizzle<0, 0, 0, 2>(b));
+    for (size_t i = 0; i != 4; ++i)
+    {
+        CHECK_EQ(bd[i], static_cast<double>(af[i]));
+    }
+
+    // 2*2 + 3*3 + 4*4
+    CHECK_EQ(detail::f64_lane0(detail::f64_hi_dp(b, b)), 29.0);
+    detail::f64_storeu(bd, detail::f64_dp_bc(b, b));
+    CHECK_EQ(bd[0], 30.0);
+    CHECK_EQ(bd[3], 30.0);
+}
+
+TEST_CASE("double-motor-point")
+{
+    d::motor m{1.0, 4.0, 3.0, 2.0, 5.0, 6.0, 7.0, 8.0};
+    d::point p1{-1.0, 1.0, 2.0};
+    d::point p2 = m(p1);
+    CHECK_EQ(p2.x(), -12.0);
+    CHECK_EQ(p2.y(), -86.0);
+    CHECK_EQ(p2.z(), -86.0);
+    CHECK_EQ(p2.w(), 30.0);
+
+    d::point ps[3] = {p1, p1, p1};
+    m(ps, ps, 3);
+    CHECK_EQ(ps[2].x(), -12.0);
+    CHECK_EQ(ps[2].w(), 30.0);
+}
+
+TEST_CASE("double-motor-plane")
+{
+    d::motor m{1.0, 4.0, 3.0, 2.0, 5.0, 6.0, 7.0, 8.0};
+    d::plane p1{3.0, 2.0, 1.0, -1.0};
+    d::plane p2 = m(p1);
+    CHECK_EQ(p2.x(), 78.0);
+    CHECK_EQ(p2.y(), 60.0);
+    CHECK_EQ(p2.z(), 54.0);
+    CHECK_EQ(p2.d(), 358.0);
+}
+
+TEST_CASE("double-matches-float")
+{
+    motor mf{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    motor nf{2.f, -1.f, 3.f, 1.f, 4.f, -2.f, 1.f, 3.f};
+    d::motor m{mf};
+    d::motor n{nf};
+
+    motor mnf   = mf * nf;
+    d::motor mn = m * n;
+    CHECK_EQ(mn.scalar(), mnf.scalar());
+    CHECK_EQ(mn.e23(), mnf.e23());
+    CHECK_EQ(mn.e31(), mnf.e31());
+    CHECK_EQ(mn.e12(), mnf.e12());
+    CHECK_EQ(mn.e01(), mnf.e01());
+    CHECK_EQ(mn.e02(), mnf.e02());
+    CHECK_EQ(mn.e03(), mnf.e03());
+    CHECK_EQ(mn.e0123(), mnf.e0123());
+
+    line lf{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+    line mlf   = mf(lf);
+    d::line ml = m(d::line{lf});
+    CHECK_EQ(ml.e01(), mlf.e01());
+    CHECK_EQ(ml.e02(), mlf.e02());
+    CHECK_EQ(ml.e03(), mlf.e03());
+    CHECK_EQ(ml.e23(), mlf.e23());
+    CHECK_EQ(ml.e31(), mlf.e31());
+    CHECK_EQ(ml.e12(), mlf.e12());
+
+    rotor rf{_mm_set_ps(2.f, -1.f, 3.f, 1.f)};
+    translator tf;
+    tf.p2_ = _mm_set_ps(3.f, -2.f, 1.f, 0.f);
+    d::rotor r{rf};
+    d::translator t{tf};
+
+    motor rtf   = rf * tf;
+    d::motor rt = r * t;
+    CHECK_EQ(rt.e01(), rtf.e01());
+    CHECK_EQ(rt.e03(), rtf.e03());
+    CHECK_EQ(rt.e0123(), rtf.e0123());
+
+    motor trf   = tf * rf;
+    d::motor tr = t * r;
+    CHECK_EQ(tr.e02(), trf.e02());
+    CHECK_EQ(tr.e0123(), trf.e0123());
+
+    motor rmf   = rf * mf;
+    d::motor rm = r * m;
+    CHECK_EQ(rm.e12(), rmf.e12());
+    CHECK_EQ(rm.e03(), rmf.e03());
+
+    motor mrf   = mf * rf;
+    d::motor mr = m * r;
+    CHECK_EQ(mr.e31(), mrf.e31());
+    CHECK_EQ(mr.e02(), mrf.e02());
+
+    motor tmf   = tf * mf;
+    d::motor tm = t * m;
+    CHECK_EQ(tm.e01(), tmf.e01());
+    CHECK_EQ(tm.e0123(), tmf.e0123());
+
+    motor mtf   = mf * tf;
+    d::motor mt = m * t;
+    CHECK_EQ(mt.e03(), mtf.e03());
+    CHECK_EQ(mt.e0123(), mtf.e0123());
+
+    rotor rrf   = rf * rotor{_mm_set_ps(1.f, 2.f, -2.f, 3.f)};
+    d::rotor rr = r * d::rotor{rotor{_mm_set_ps(1.f, 2.f, -2.f, 3.f)}};
+    CHECK_EQ(rr.scalar(), rrf.scalar());
+    CHECK_EQ(rr.e23(), rrf.e23());
+    CHECK_EQ(rr.e31(), rrf.e31());
+    CHECK_EQ(rr.e12(), rrf.e12());
+
+    point pf{-1.f, 1.f, 2.f};
+    point rpf   = rf(pf);
+    d::point rp = r(d::point{pf});
+    CHECK_EQ(rp.x(), rpf.x());
+    CHECK_EQ(rp.y(), rpf.y());
+    CHECK_EQ(rp.z(), rpf.z());
+    CHECK_EQ(rp.w(), rpf.w());
+
+    point tpf   = tf(pf);
+    d::point tp = t(d::point{pf});
+    CHECK_EQ(tp.x(), tpf.x());
+    CHECK_EQ(tp.y(), tpf.y());
+    CHECK_EQ(tp.z(), tpf.z());
+
+    plane qf{3.f, 2.f, 1.f, -1.f};
+    plane tqf   = tf(qf);
+    d::plane tq = t(d::plane{qf});
+    CHECK_EQ(tq.x(), tqf.x());
+    // The single precision kernel divides by the scalar approximately
+    CHECK_EQ(tq.d(), doctest::Approx(tqf.d()));
+    CHECK_EQ(tq.d(), 3.0);
+
+    line tlf   = tf(lf);
+    d::line tl = t(d::line{lf});
+    CHECK_EQ(tl.e01(), tlf.e01());
+    CHECK_EQ(tl.e02(), tlf.e02());
+    CHECK_EQ(tl.e03(), tlf.e03());
+}
+
+TEST_CASE("double-normalize")
+{
+    d::motor m{1.0, 4.0, 3.0, 2.0, 5.0, 6.0, 7.0, 8.0};
+    m.normalize();
+    d::motor id = m * ~m;
+    CHECK_EQ(id.scalar(), doctest::Approx(1.0).epsilon(1e-15));
+    CHECK_EQ(id.e23(), doctest::Approx(0.0).epsilon(1e-15));
+    CHECK_EQ(id.e0123(), doctest::Approx(0.0).epsilon(1e-15));
+    CHECK_EQ(id.e01(), doctest::Approx(0.0).epsilon(1e-15));
+}
+
+TEST_CASE("double-large-coordinates")
+{
+    // Orbit a point 10^7 units from the origin by a quarter turn. Adjacent
+    // floats are a unit apart at this magnitude, so the fractional offsets
+    // are only representable in double precision.
+    d::translator t{1e7, 1.0, 0.0, 0.0};
+    d::rotor r{1.5707963267948966, 0.0, 0.0, 1.0};
+    d::motor m = r * t;
+
+    d::point p{0.125, 0.375, 0.0};
+    d::point q = m(p);
+    CHECK_LT(std::abs(q.x() - 0.375), 1e-6);
+    CHECK_LT(std::abs(q.y() + 1e7 + 0.125), 1e-6);
+    CHECK_EQ(q.z(), 0.0);
+
+    // Conjugating with the reverse recovers the original point
+    d::point back = (~m)(q);
+    CHECK_EQ(back.x(), doctest::Approx(0.125).epsilon(1e-9));
+    CHECK_EQ(back.y(), doctest::Approx(0.375).epsilon(1e-9));
+}
@@ -124,4 +124,228 @@ TEST_CASE("multivector-ep")
         dual p1p2 = p1 ^ p2;
         CHECK_EQ(p1p2.e0123(), -16.f);
     }
-}
\ No newline at end of file
+
+    SUBCASE("indexed meets")
+    {
+        plane planes[4] = {{1.f, 0.f, 0.f, -1.f},
+                           {0.f, 1.f, 0.f, 2.f},
+                           {0.f, 0.f, 1.f, -3.f},
+                           {1.f, 2.f, -1.f, 0.5f}};
+        uint32_t pairs[6]   = {0, 1, 1, 2, 3, 0};
+        uint32_t triples[6] = {0, 1, 2, 3, 1, 2};
+
+        line lines[3];
+        meet(planes, pairs, lines, 3);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            line l = planes[pairs[2 * i]] ^ planes[pairs[2 * i + 1]];
+            CHECK_EQ(lines[i].e01(), doctest::Approx(l.e01()));
+            CHECK_EQ(lines[i].e02(), doctest::Approx(l.e02()));
+            CHECK_EQ(lines[i].e03(), doctest::Approx(l.e03()));
+            CHECK_EQ(lines[i].e23(), doctest::Approx(l.e23()));
+            CHECK_EQ(lines[i].e31(), doctest::Approx(l.e31()));
+            CHECK_EQ(lines[i].e12(), doctest::Approx(l.e12()));
+        }
+
+        point corners[2];
+        meet(planes, triples, corners, 2);
+        for (size_t i = 0; i != 2; ++i)
+        {
+            point p = planes[triples[3 * i]] ^ planes[triples[3 * i + 1]]
+                      ^ planes[triples[3 * i + 2]];
+            CHECK_EQ(corners[i].e123(), doctest::Approx(p.e123()));
+            CHECK_EQ(corners[i].e032(), doctest::Approx(p.e032()));
+            CHECK_EQ(corners[i].e013(), doctest::Approx(p.e013()));
+            CHECK_EQ(corners[i].e021(), doctest::Approx(p.e021()));
+        }
+        corners[0].normalize();
+        CHECK_EQ(corners[0].x(), doctest::Approx(1.f));
+        CHECK_EQ(corners[0].y(), doctest::Approx(-2.f));
+        CHECK_EQ(corners[0].z(), doctest::Approx(3.f));
+
+        // Meet planes with the lines computed above
+        uint32_t plane_line[6] = {2, 0, 0, 1, 3, 2};
+        point points[3];
+        meet(planes, lines, plane_line, points, 3);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            point p = planes[plane_line[2 * i]] ^ lines[plane_line[2 * i + 1]];
+            CHECK_EQ(points[i].e123(), doctest::Approx(p.e123()));
+            CHECK_EQ(points[i].e032(), doctest::Approx(p.e032()));
+            CHECK_EQ(points[i].e013(), doctest::Approx(p.e013()));
+            CHECK_EQ(points[i].e021(), doctest::Approx(p.e021()));
+        }
+
+        uint32_t plane_point[4] = {3, 0, 0, 2};
+        float e0123[2];
+        meet(planes, points, plane_point, e0123, 2);
+        for (size_t i = 0; i != 2; ++i)
+        {
+            dual d
+                = planes[plane_point[2 * i]] ^ points[plane_point[2 * i + 1]];
+            CHECK_EQ(e0123[i], doctest::Approx(d.e0123()));
+        }
+    }
+}
+
+TEST_CASE("raycast-plane")
+{
+    // z = 1
+    plane p{0.f, 0.f, 1.f, -1.f};
+
+    constexpr size_t count = 37;
+    line lines[count];
+    point origins[count];
+    float dz[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float x    = static_cast<float>(i % 5) - 2.f;
+        float y    = static_cast<float>(i % 3) - 1.f;
+        dz[i]      = static_cast<float>(i % 4) - 1.5f;
+        if (i == 7)
+        {
+            // Parallel to the plane
+            dz[i] = 0.f;
+        }
+        origins[i] = point{x, y, -1.f};
+        lines[i]   = origins[i] & point{x + 0.5f, y - 0.25f, -1.f + dz[i]};
+    }
+
+    line_soa rays{lines, count};
+    point_soa starts{origins, count};
+    CHECK_EQ(rays.get(5).e12(), lines[5].e12());
+    CHECK_EQ(rays.get(5).e01(), lines[5].e01());
+
+    ray_hits hits;
+    raycast(rays, starts, p, hits);
+    CHECK_EQ(hits.size(), count);
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        bool expected = dz[i] > 0.f;
+        CHECK_EQ(hits.hit(i), expected);
+        if (expected)
+        {
+            float t = 2.f / dz[i];
+            CHECK_EQ(hits.t()[i], doctest::Approx(t));
+            point h = hits.points().get(i);
+            CHECK_EQ(h.x(), doctest::Approx(origins[i].x() + 0.5f * t));
+            CHECK_EQ(h.y(), doctest::Approx(origins[i].y() - 0.25f * t));
+            CHECK_EQ(h.z(), doctest::Approx(1.f));
+            CHECK_EQ(h.w(), 1.f);
+        }
+        else
+        {
+            CHECK_EQ(hits.t()[i], 0.f);
+            CHECK_EQ(hits.points().w()[i], 0.f);
+        }
+    }
+
+    // Padding lanes remain zeroed
+    CHECK_EQ(hits.points().x()[count], 0.f);
+    CHECK_EQ(hits.points().w()[count], 0.f);
+
+    // Only hits closer than t_max are reported (t = 4/3 and t = 4)
+    raycast(rays, starts, p, hits, 2.f);
+    for (size_t i = 0; i != count; ++i)
+    {
+        CHECK_EQ(hits.hit(i), dz[i] > 1.f);
+    }
+}
+
+TEST_CASE("raycast-planes")
+{
+    constexpr size_t count = 21;
+    line lines[count];
+    point origins[count];
+    plane planes[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f    = static_cast<float>(i);
+        origins[i] = point{0.5f * f - 3.f, 1.f, -0.25f * f};
+        lines[i]   = origins[i] & point{-1.f, 0.1f * f, 2.f};
+        planes[i]  = plane{1.f, 0.5f * f - 4.f, 2.f, 0.3f * f};
+    }
+
+    line_soa rays{lines, count};
+    point_soa starts{origins, count};
+    plane_soa targets{planes, count};
+    ray_hits hits;
+    raycast(rays, starts, targets, hits);
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        point m = planes[i] ^ lines[i];
+        m.normalize();
+
+        // Parameter along the ray in units of the direction o & p
+        float n_o = planes[i].x() * origins[i].x()
+                    + planes[i].y() * origins[i].y()
+                    + planes[i].z() * origins[i].z() + planes[i].d();
+        float n_m = planes[i].x() * lines[i].e23()
+                    + planes[i].y() * lines[i].e31()
+                    + planes[i].z() * lines[i].e12();
+        float t   = -n_o / n_m;
+
+        CHECK_EQ(hits.hit(i), t >= 0.f);
+        if (t >= 0.f)
+        {
+            point h = hits.points().get(i);
+            CHECK_EQ(h.x(), doctest::Approx(m.x()));
+            CHECK_EQ(h.y(), doctest::Approx(m.y()));
+            CHECK_EQ(h.z(), doctest::Approx(m.z()));
+            CHECK_EQ(hits.t()[i], doctest::Approx(t));
+        }
+    }
+}
+
+TEST_CASE("raycast-triangle")
+{
+    point a{0.f, 0.f, 0.f};
+    point b{2.f, 0.f, 0.f};
+    point c{0.f, 2.f, 0.f};
+    triangle tri{a, b, c};
+
+    // The edge planes evaluate to the barycentric coordinates
+    plane e0 = tri.edge(0);
+    CHECK_EQ(e0.d(), doctest::Approx(1.f));
+    CHECK_EQ(e0.x() * 2.f + e0.d(), doctest::Approx(0.f));
+
+    // Vertical rays over a grid around the triangle, cast downwards from
+    // z = 1 and upwards from z = -1
+    constexpr size_t count = 50;
+    line lines[count];
+    point origins[count];
+    float xs[count];
+    float ys[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        xs[i]      = static_cast<float>(i % 5) * 0.75f - 0.5f;
+        ys[i]      = static_cast<float>(i / 5 % 5) * 0.75f - 0.5f;
+        float z    = i < 25 ? 1.f : -1.f;
+        origins[i] = point{xs[i], ys[i], z};
+        lines[i]   = origins[i] & point{xs[i], ys[i], z * 0.5f};
+    }
+
+    line_soa rays{lines, count};
+    point_soa starts{origins, count};
+    ray_hits hits;
+    raycast(rays, starts, tri, hits);
+
+    size_t hit_count = 0;
+    for (size_t i = 0; i != count; ++i)
+    {
+        bool inside = xs[i] >= 0.f && ys[i] >= 0.f && xs[i] + ys[i] <= 2.f;
+        CHECK_EQ(hits.hit(i), inside);
+        if (inside)
+        {
+            ++hit_count;
+            point h = hits.points().get(i);
+            CHECK_EQ(h.x(), doctest::Approx(xs[i]));
+            CHECK_EQ(h.y(), doctest::Approx(ys[i]));
+            CHECK_EQ(h.z(), doctest::Approx(0.f));
+            CHECK_EQ(hits.t()[i], doctest::Approx(2.f));
+        }
+    }
+    CHECK_EQ(hit_count, 12);
+}
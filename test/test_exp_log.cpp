@@ -135,3 +135,123 @@ TEST_CASE("ideal-motor-step")
     CHECK_EQ(result.e03(), doctest::Approx(m1.e03()));
     CHECK_EQ(result.e0123(), doctest::Approx(m1.e0123()));
 }
+
+
+TEST_CASE("motor-exp-log-batch")
+{
+    // 19 exercises both full blocks and the zero padded tail for every
+    // SIMD width
+    motor ms[19];
+    for (size_t i = 0; i != 19; ++i)
+    {
+        float f = static_cast<float>(i);
+        rotor r{0.4f * f - 3.f, 0.3f + f, -3.f, 1.f - 0.5f * f};
+        translator t{12.f - f, -2.f, 0.4f * f, 1.f};
+        ms[i] = r * t;
+    }
+    // A pure translation and the identity take the early out paths
+    ms[5]  = motor{translator{1.f, 1.f, 2.f, 3.f}};
+    ms[17] = motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+
+    line ls[19];
+    log(ms, ls, 19);
+    for (size_t i = 0; i != 19; ++i)
+    {
+        line expected = log(ms[i]);
+        CHECK_EQ(ls[i].e23(), doctest::Approx(expected.e23()));
+        CHECK_EQ(ls[i].e31(), doctest::Approx(expected.e31()));
+        CHECK_EQ(ls[i].e12(), doctest::Approx(expected.e12()));
+        CHECK_EQ(ls[i].e01(), doctest::Approx(expected.e01()));
+        CHECK_EQ(ls[i].e02(), doctest::Approx(expected.e02()));
+        CHECK_EQ(ls[i].e03(), doctest::Approx(expected.e03()));
+    }
+
+    // Exponentiate in place
+    motor* out = reinterpret_cast<motor*>(ls);
+    exp(ls, out, 19);
+    for (size_t i = 0; i != 19; ++i)
+    {
+        CHECK_EQ(out[i].scalar(), doctest::Approx(ms[i].scalar()));
+        CHECK_EQ(out[i].e23(), doctest::Approx(ms[i].e23()));
+        CHECK_EQ(out[i].e31(), doctest::Approx(ms[i].e31()));
+        CHECK_EQ(out[i].e12(), doctest::Approx(ms[i].e12()));
+        CHECK_EQ(out[i].e01(), doctest::Approx(ms[i].e01()));
+        CHECK_EQ(out[i].e02(), doctest::Approx(ms[i].e02()));
+        CHECK_EQ(out[i].e03(), doctest::Approx(ms[i].e03()));
+        CHECK_EQ(out[i].e0123(), doctest::Approx(ms[i].e0123()));
+    }
+}
+
+TEST_CASE("motor-slerp-free")
+{
+    rotor r1{kln::pi * 0.5f, 0, 0, 1.f};
+    translator t1{1.f, 0.f, 0.f, 1.f};
+    motor m1 = r1 * t1;
+
+    rotor r2{kln::pi * 0.5f, 0.3f, -3.f, 1.f};
+    translator t2{12.f, -2.f, 0.4f, 1.f};
+    motor m2 = r2 * t2;
+
+    motor start = slerp(m1, m2, 0.f);
+    motor end   = slerp(m1, m2, 1.f);
+    // The sign of the endpoint is irrelevant; -m2 is the same transform
+    motor half  = slerp(m1, -m2, 0.5f);
+    motor step  = exp(log(m2 * ~m1) * 0.5f);
+    motor half2 = step * m1;
+
+    CHECK_EQ(start.scalar(), doctest::Approx(m1.scalar()));
+    CHECK_EQ(start.e01(), doctest::Approx(m1.e01()));
+    CHECK_EQ(end.scalar(), doctest::Approx(m2.scalar()));
+    CHECK_EQ(end.e12(), doctest::Approx(m2.e12()));
+    CHECK_EQ(end.e03(), doctest::Approx(m2.e03()));
+    CHECK_EQ(half.scalar(), doctest::Approx(half2.scalar()));
+    CHECK_EQ(half.e31(), doctest::Approx(half2.e31()));
+    CHECK_EQ(half.e02(), doctest::Approx(half2.e02()));
+    CHECK_EQ(half.e0123(), doctest::Approx(half2.e0123()));
+}
+
+TEST_CASE("motor-track")
+{
+    motor keys[3];
+    keys[0] = motor{translator{1.f, 1.f, 0.f, 0.f}};
+    keys[1] = rotor{kln::pi * 0.5f, 0.3f, -3.f, 1.f}
+              * translator{12.f, -2.f, 0.4f, 1.f};
+    keys[2] = rotor{kln::pi * 0.25f, 0, 0, 1.f} * translator{1.f, 0, 1.f, 0};
+    float times[3] = {0.f, 1.f, 3.f};
+    motor_track track{keys, times, 3};
+    CHECK_EQ(track.size(), 3);
+
+    // Samples before, at, between, and past the keyframes
+    float samples[7] = {-1.f, 0.f, 0.25f, 1.f, 2.5f, 3.f, 4.f};
+    motor expected[7]
+        = {keys[0],
+           keys[0],
+           slerp(keys[0], keys[1], 0.25f),
+           keys[1],
+           slerp(keys[1], keys[2], 0.75f),
+           keys[2],
+           keys[2]};
+
+    motor batch[7];
+    track.sample(samples, batch, 7);
+    for (size_t i = 0; i != 7; ++i)
+    {
+        motor single = track.sample(samples[i]);
+        CHECK_EQ(single.scalar(), doctest::Approx(expected[i].scalar()));
+        CHECK_EQ(single.e23(), doctest::Approx(expected[i].e23()));
+        CHECK_EQ(single.e31(), doctest::Approx(expected[i].e31()));
+        CHECK_EQ(single.e12(), doctest::Approx(expected[i].e12()));
+        CHECK_EQ(single.e01(), doctest::Approx(expected[i].e01()));
+        CHECK_EQ(single.e02(), doctest::Approx(expected[i].e02()));
+        CHECK_EQ(single.e03(), doctest::Approx(expected[i].e03()));
+        CHECK_EQ(single.e0123(), doctest::Approx(expected[i].e0123()));
+
+        CHECK_EQ(batch[i].scalar(), doctest::Approx(expected[i].scalar()));
+        CHECK_EQ(batch[i].e12(), doctest::Approx(expected[i].e12()));
+        CHECK_EQ(batch[i].e01(), doctest::Approx(expected[i].e01()));
+        CHECK_EQ(batch[i].e0123(), doctest::Approx(expected[i].e0123()));
+    }
+
+    // Clamping past the end reproduces the last keyframe exactly
+    CHECK_EQ(batch[6], keys[2]);
+}
@@ -34,6 +34,16 @@ TEST_CASE("multivector-gp")
         plane p1{1.f, 2.f, 3.f, 4.f};
         motor m = p1 / p1;
         CHECK_EQ(m.scalar(), doctest::Approx(1.f));
+#ifdef KLEIN_FMA
+        // A fused product doesn't cancel exactly with its rounded counterpart
+        CHECK_EQ(m.e12(), doctest::Approx(0.f));
+        CHECK_EQ(m.e31(), doctest::Approx(0.f));
+        CHECK_EQ(m.e23(), doctest::Approx(0.f));
+        CHECK_EQ(m.e01(), doctest::Approx(0.f));
+        CHECK_EQ(m.e02(), doctest::Approx(0.f));
+        CHECK_EQ(m.e03(), doctest::Approx(0.f));
+        CHECK_EQ(m.e0123(), doctest::Approx(0.f));
+#else
         CHECK_EQ(m.e12(), 0.f);
         CHECK_EQ(m.e31(), 0.f);
         CHECK_EQ(m.e23(), 0.f);
@@ -41,6 +51,7 @@ TEST_CASE("multivector-gp")
         CHECK_EQ(m.e02(), 0.f);
         CHECK_EQ(m.e03(), 0.f);
         CHECK_EQ(m.e0123(), 0.f);
+#endif
     }
 
     SUBCASE("plane*point")
@@ -99,9 +110,16 @@ TEST_CASE("multivector-gp")
         branch b{2.f, 1.f, 3.f};
         rotor r = b / b;
         CHECK_EQ(r.scalar(), doctest::Approx(1.f));
+#ifdef KLEIN_FMA
+        // A fused product doesn't cancel exactly with its rounded counterpart
+        CHECK_EQ(r.e23(), doctest::Approx(0.f));
+        CHECK_EQ(r.e31(), doctest::Approx(0.f));
+        CHECK_EQ(r.e12(), doctest::Approx(0.f));
+#else
         CHECK_EQ(r.e23(), 0.f);
         CHECK_EQ(r.e31(), 0.f);
         CHECK_EQ(r.e12(), 0.f);
+#endif
     }
 
     SUBCASE("line*line")
@@ -131,9 +149,16 @@ TEST_CASE("multivector-gp")
         line l{1.f, -2.f, 2.f, -3.f, 3.f, -4.f};
         motor m = l / l;
         CHECK_EQ(m.scalar(), doctest::Approx(1.f));
+#ifdef KLEIN_FMA
+        // A fused product doesn't cancel exactly with its rounded counterpart
+        CHECK_EQ(m.e12(), doctest::Approx(0.f));
+        CHECK_EQ(m.e31(), doctest::Approx(0.f));
+        CHECK_EQ(m.e23(), doctest::Approx(0.f));
+#else
         CHECK_EQ(m.e12(), 0.f);
         CHECK_EQ(m.e31(), 0.f);
         CHECK_EQ(m.e23(), 0.f);
+#endif
         CHECK_EQ(m.e01(), doctest::Approx(0.f));
         CHECK_EQ(m.e02(), doctest::Approx(0.f));
         CHECK_EQ(m.e03(), doctest::Approx(0.f));
@@ -299,12 +324,103 @@ TEST_CASE("multivector-gp")
         motor m1{2, 3, 4, 5, 6, 7, 8, 9};
         motor m2 = m1 / m1;
         CHECK_EQ(m2.scalar(), doctest::Approx(1.f));
+#ifdef KLEIN_FMA
+        // A fused product doesn't cancel exactly with its rounded counterpart
+        CHECK_EQ(m2.e23(), doctest::Approx(0.f));
+        CHECK_EQ(m2.e31(), doctest::Approx(0.f));
+        CHECK_EQ(m2.e12(), doctest::Approx(0.f));
+        CHECK_EQ(m2.e01(), doctest::Approx(0.f));
+#else
         CHECK_EQ(m2.e23(), 0.f);
         CHECK_EQ(m2.e31(), 0.f);
         CHECK_EQ(m2.e12(), 0.f);
         CHECK_EQ(m2.e01(), 0.f);
+#endif
         CHECK_EQ(m2.e02(), doctest::Approx(0.f));
         CHECK_EQ(m2.e03(), doctest::Approx(0.f));
         CHECK_EQ(m2.e0123(), doctest::Approx(0.f));
     }
+}
+
+namespace
+{
+// Runs tasks serially in reverse order to verify that tasks handed to an
+// executor are independent of one another
+struct reverse_executor
+{
+    size_t task_count = 0;
+
+    template <typename F>
+    void operator()(size_t count, F const& task)
+    {
+        task_count += count;
+        for (size_t i = count; i != 0; --i)
+        {
+            task(i - 1);
+        }
+    }
+};
+} // namespace
+
+TEST_CASE("hierarchy-propagate")
+{
+    // Two trees, with nodes of different depths interleaved:
+    //   0 -> 1 -> 3 -> 5
+    //   0 -> 2
+    //   4 -> 6
+    uint32_t parents[7] = {
+        hierarchy::no_parent, 0, 0, 1, hierarchy::no_parent, 3, 4};
+    hierarchy h{parents, 7};
+    CHECK_EQ(h.size(), 7);
+    CHECK_EQ(h.levels(), 4);
+    CHECK_EQ(h.level_size(0), 2);
+    CHECK_EQ(h.level_size(1), 3);
+    CHECK_EQ(h.level_size(2), 1);
+    CHECK_EQ(h.level_size(3), 1);
+
+    motor locals[7];
+    for (size_t i = 0; i != 7; ++i)
+    {
+        float f   = static_cast<float>(i);
+        locals[i] = motor{1.f, 0.5f * f, -1.f, 2.f, f, 1.f, -2.f, 0.f};
+    }
+
+    // Reference serial parent-to-child loop
+    motor expected[7];
+    for (size_t i = 0; i != 7; ++i)
+    {
+        expected[i] = parents[i] == hierarchy::no_parent
+                          ? locals[i]
+                          : expected[parents[i]] * locals[i];
+    }
+
+    SUBCASE("serial")
+    {
+        motor worlds[7];
+        h.propagate(locals, worlds);
+        for (size_t i = 0; i != 7; ++i)
+        {
+            CHECK_EQ(worlds[i].scalar(), expected[i].scalar());
+            CHECK_EQ(worlds[i].e12(), expected[i].e12());
+            CHECK_EQ(worlds[i].e01(), expected[i].e01());
+            CHECK_EQ(worlds[i].e0123(), expected[i].e0123());
+        }
+    }
+
+    SUBCASE("parallel")
+    {
+        reverse_executor exec;
+
+        motor worlds[7];
+        h.propagate(locals, worlds, exec, 1);
+        // Only the two widest levels are split
+        CHECK_EQ(exec.task_count, 5);
+        for (size_t i = 0; i != 7; ++i)
+        {
+            CHECK_EQ(worlds[i].scalar(), expected[i].scalar());
+            CHECK_EQ(worlds[i].e23(), expected[i].e23());
+            CHECK_EQ(worlds[i].e03(), expected[i].e03());
+            CHECK_EQ(worlds[i].e0123(), expected[i].e0123());
+        }
+    }
 }
\ No newline at end of file
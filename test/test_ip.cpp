@@ -150,5 +150,70 @@ TEST_CASE("multivector-ip")
         CHECK_EQ(p4.x(), doctest::Approx(2.f));
         CHECK_EQ(p4.y(), doctest::Approx(0.f));
         CHECK_EQ(p4.z(), doctest::Approx(0.f));
+
+        point p5 = project(p1, l);
+        p5.normalize();
+        CHECK_EQ(p5.e123(), doctest::Approx(1.f));
+        CHECK_EQ(p5.x(), doctest::Approx(2.f));
+        CHECK_EQ(p5.y(), doctest::Approx(0.f));
+        CHECK_EQ(p5.z(), doctest::Approx(0.f));
+    }
+
+    SUBCASE("project point to plane")
+    {
+        point p1{2.f, 3.f, -1.f};
+        // x + 2y - 2z - 1 = 0
+        plane p{1.f, 2.f, -2.f, -1.f};
+        point p2 = project(p1, p);
+        p2.normalize();
+
+        // The signed distance is (2 + 6 + 2 - 1) / 3 = 3
+        CHECK_EQ(p2.e123(), doctest::Approx(1.f));
+        CHECK_EQ(p2.x(), doctest::Approx(1.f));
+        CHECK_EQ(p2.y(), doctest::Approx(1.f));
+        CHECK_EQ(p2.z(), doctest::Approx(1.f));
+    }
+
+    SUBCASE("project points (array)")
+    {
+        point points[5] = {{2.f, 3.f, -1.f},
+                           {0.f, 0.f, 0.f},
+                           {-1.f, 4.f, 2.f},
+                           {1.f, 1.f, 1.f},
+                           {5.f, -2.f, 0.5f}};
+        plane planes[5] = {{1.f, 2.f, -2.f, -1.f},
+                           {0.f, 0.f, 1.f, 3.f},
+                           {3.f, -1.f, 2.f, 0.f},
+                           {1.f, 2.f, -2.f, -1.f},
+                           {-2.f, 0.5f, 1.f, 4.f}};
+        line l{1.f, -2.f, 0.5f, 3.f, 1.f, -1.f};
+
+        point to_plane[5];
+        point to_planes[5];
+        point to_line[5];
+        project(points, planes[0], to_plane, 5);
+        project(points, planes, to_planes, 5);
+        project(points, l, to_line, 5);
+
+        auto check = [](point a, point b) {
+            CHECK_EQ(a.e123(), doctest::Approx(b.e123()));
+            CHECK_EQ(a.e032(), doctest::Approx(b.e032()));
+            CHECK_EQ(a.e013(), doctest::Approx(b.e013()));
+            CHECK_EQ(a.e021(), doctest::Approx(b.e021()));
+        };
+
+        for (size_t i = 0; i != 5; ++i)
+        {
+            check(to_plane[i], point{(points[i] | planes[0]) ^ planes[0]});
+            check(to_planes[i], point{(points[i] | planes[i]) ^ planes[i]});
+            check(to_line[i], point{(points[i] | l) ^ l});
+        }
+
+        // In place
+        project(points, planes, points, 5);
+        for (size_t i = 0; i != 5; ++i)
+        {
+            check(points[i], to_planes[i]);
+        }
     }
 }
\ No newline at end of file
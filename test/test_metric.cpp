@@ -2,6 +2,9 @@
 
 #include <klein/klein.hpp>
 
+#include <cmath>
+#include <vector>
+
 using namespace kln;
 
 TEST_CASE("measure-point-to-point")
@@ -41,6 +44,67 @@ TEST_CASE("measure-point-to-line")
     CHECK_EQ(distance, doctest::Approx(std::sqrt(2.f)));
 }
 
+TEST_CASE("measure-point-distances")
+{
+    // x + 2y - 2z - 1 = 0
+    plane p{1.f, 2.f, -2.f, -1.f};
+    line l = point{0.f, 0.f, 0.f} & point{1.f, 0.f, 0.f};
+
+    CHECK_EQ(signed_distance(point{2.f, 3.f, -1.f}, p), doctest::Approx(3.f));
+    CHECK_EQ(signed_distance(point{0.f, 0.f, 0.f}, p),
+             doctest::Approx(-1.f / 3.f));
+    CHECK_EQ(distance(point{2.f, 3.f, -4.f}, l), doctest::Approx(5.f));
+
+    // Enough points to leave a partial register with any SoA width
+    point points[19];
+    plane planes[19];
+    for (size_t i = 0; i != 19; ++i)
+    {
+        float f   = static_cast<float>(i);
+        points[i] = point{f - 9.f, 0.5f * f, 3.f - 0.25f * f};
+        planes[i] = plane{1.f - 0.1f * f, 2.f, f - 4.f, 0.5f * f};
+    }
+    line l2 = points[3] & point{1.f, -2.f, 0.5f};
+
+    float to_plane[19];
+    float to_planes[19];
+    float to_line[19];
+    signed_distance(points, p, to_plane, 19);
+    signed_distance(points, planes, to_planes, 19);
+    distance(points, l2, to_line, 19);
+
+    point_soa points_soa{points, 19};
+    plane_soa planes_soa{planes, 19};
+    std::vector<float> to_plane_soa(points_soa.stride());
+    std::vector<float> to_planes_soa(points_soa.stride());
+    std::vector<float> to_line_soa(points_soa.stride());
+    signed_distance(points_soa, p, to_plane_soa.data());
+    signed_distance(points_soa, planes_soa, to_planes_soa.data());
+    distance(points_soa, l2, to_line_soa.data());
+
+    for (size_t i = 0; i != 19; ++i)
+    {
+        float x = points[i].x();
+        float y = points[i].y();
+        float z = points[i].z();
+
+        float d = (x + 2.f * y - 2.f * z - 1.f) / 3.f;
+        CHECK_EQ(to_plane[i], doctest::Approx(d));
+        CHECK_EQ(to_plane_soa[i], doctest::Approx(d));
+
+        plane q = planes[i];
+        d       = (q.x() * x + q.y() * y + q.z() * z + q.d())
+            / std::sqrt(q.x() * q.x() + q.y() * q.y() + q.z() * q.z());
+        CHECK_EQ(to_planes[i], doctest::Approx(d));
+        CHECK_EQ(to_planes_soa[i], doctest::Approx(d));
+
+        // points[3] lies on the line
+        d = i == 3 ? 0.f : (points[i] & l2).norm() / l2.norm();
+        CHECK_EQ(to_line[i], doctest::Approx(d).epsilon(1e-4));
+        CHECK_EQ(to_line_soa[i], doctest::Approx(d).epsilon(1e-4));
+    }
+}
+
 TEST_CASE("euler-angles")
 {
     // Make 3 rotors about the x, y, and z-axes.
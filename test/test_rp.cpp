@@ -43,4 +43,54 @@ TEST_CASE("multivector-rp")
         CHECK_EQ(-p123.e1() + p123.e2() * 5.f + p123.e3() * 2.f + p123.e0(), 0.f);
         CHECK_EQ(p123.e1() * 2.f - p123.e2() - p123.e3() * 4.f + p123.e0(), 0.f);
     }
+
+    SUBCASE("indexed joins")
+    {
+        point points[4] = {{0.f, 0.f, 0.f},
+                           {1.f, 0.f, 0.f},
+                           {0.f, 1.f, 0.f},
+                           {2.f, -1.f, 3.f}};
+        uint32_t edges[6]     = {0, 1, 1, 2, 3, 0};
+        uint32_t triangles[6] = {0, 1, 2, 3, 2, 1};
+
+        line lines[3];
+        join(points, edges, lines, 3);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            line l = points[edges[2 * i]] & points[edges[2 * i + 1]];
+            CHECK_EQ(lines[i].e01(), doctest::Approx(l.e01()));
+            CHECK_EQ(lines[i].e02(), doctest::Approx(l.e02()));
+            CHECK_EQ(lines[i].e03(), doctest::Approx(l.e03()));
+            CHECK_EQ(lines[i].e23(), doctest::Approx(l.e23()));
+            CHECK_EQ(lines[i].e31(), doctest::Approx(l.e31()));
+            CHECK_EQ(lines[i].e12(), doctest::Approx(l.e12()));
+        }
+
+        plane planes[2];
+        join(points, triangles, planes, 2);
+        for (size_t i = 0; i != 2; ++i)
+        {
+            plane p = points[triangles[3 * i]] & points[triangles[3 * i + 1]]
+                      & points[triangles[3 * i + 2]];
+            CHECK_EQ(planes[i].e0(), doctest::Approx(p.e0()));
+            CHECK_EQ(planes[i].e1(), doctest::Approx(p.e1()));
+            CHECK_EQ(planes[i].e2(), doctest::Approx(p.e2()));
+            CHECK_EQ(planes[i].e3(), doctest::Approx(p.e3()));
+        }
+        // The first triangle is counter-clockwise when viewed from +z
+        CHECK_LT(planes[0].e3(), 0.f);
+
+        // Join points with edge lines
+        uint32_t pairs[6] = {3, 0, 3, 1, 2, 0};
+        plane to_lines[3];
+        join(points, lines, pairs, to_lines, 3);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            plane p = points[pairs[2 * i]] & lines[pairs[2 * i + 1]];
+            CHECK_EQ(to_lines[i].e0(), doctest::Approx(p.e0()));
+            CHECK_EQ(to_lines[i].e1(), doctest::Approx(p.e1()));
+            CHECK_EQ(to_lines[i].e2(), doctest::Approx(p.e2()));
+            CHECK_EQ(to_lines[i].e3(), doctest::Approx(p.e3()));
+        }
+    }
 }
\ No newline at end of file
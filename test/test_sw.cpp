@@ -1,6 +1,13 @@
 #include <doctest/doctest.h>
 
 #include <klein/klein.hpp>
+#include <klein/parallel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 using namespace kln;
 
@@ -54,6 +61,64 @@ TEST_CASE("reflect-point")
     CHECK_EQ(p3.e123(), 14.f);
 }
 
+TEST_CASE("reflect-variadic")
+{
+    plane p{3.f, 2.f, 1.f, -1.f};
+
+    plane planes[3]
+        = {{1.f, 2.f, -1.f, -3.f}, {0.f, 1.f, 0.f, 2.f}, {-2.f, 4.f, 1.f, 5.f}};
+    plane planes2[3];
+    p(planes, planes2, 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        CHECK_EQ(planes2[i], p(planes[i]));
+    }
+    p(planes, planes, 3);
+    CHECK_EQ(planes[0].e0(), 30.f);
+    CHECK_EQ(planes[0].e1(), 22.f);
+    CHECK_EQ(planes[0].e2(), -4.f);
+    CHECK_EQ(planes[0].e3(), 26.f);
+
+    line lines[2]
+        = {{1.f, -2.f, 3.f, 6.f, 5.f, -4.f}, {-1.f, 0.f, 2.f, 1.f, 3.f, 2.f}};
+    line lines2[2];
+    p(lines, lines2, 2);
+    for (size_t i = 0; i != 2; ++i)
+    {
+        line l = p(lines[i]);
+        CHECK_EQ(lines2[i].e01(), l.e01());
+        CHECK_EQ(lines2[i].e02(), l.e02());
+        CHECK_EQ(lines2[i].e03(), l.e03());
+        CHECK_EQ(lines2[i].e12(), l.e12());
+        CHECK_EQ(lines2[i].e31(), l.e31());
+        CHECK_EQ(lines2[i].e23(), l.e23());
+    }
+    p(lines, lines, 2);
+    CHECK_EQ(lines[0].e01(), 28.f);
+    CHECK_EQ(lines[0].e02(), -72.f);
+    CHECK_EQ(lines[0].e03(), 32.f);
+    CHECK_EQ(lines[0].e12(), 104.f);
+    CHECK_EQ(lines[0].e31(), 26.f);
+    CHECK_EQ(lines[0].e23(), 60.f);
+
+    point points[3] = {{4.f, -2.f, -1.f}, {0.f, 0.f, 0.f}, {1.f, 2.f, 3.f}};
+    point points2[3];
+    p(points, points2, 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        point q = p(points[i]);
+        CHECK_EQ(points2[i].x(), q.x());
+        CHECK_EQ(points2[i].y(), q.y());
+        CHECK_EQ(points2[i].z(), q.z());
+        CHECK_EQ(points2[i].w(), q.w());
+    }
+    p(points, points, 3);
+    CHECK_EQ(points[0].e021(), -26.f);
+    CHECK_EQ(points[0].e013(), -52.f);
+    CHECK_EQ(points[0].e032(), 20.f);
+    CHECK_EQ(points[0].e123(), 14.f);
+}
+
 TEST_CASE("rotor-line")
 {
     // Make an unnormalized rotor to verify correctness
@@ -76,7 +141,12 @@ TEST_CASE("rotor-point")
     rotor r{kln::pi * 0.5f, 0, 0, 1.f};
     point p1{1, 0, 0};
     point p2 = r(p1);
+#ifdef KLEIN_FMA
+    // A fused product doesn't cancel exactly with its rounded counterpart
+    CHECK_EQ(p2.x(), doctest::Approx(0.f));
+#else
     CHECK_EQ(p2.x(), 0.f);
+#endif
     CHECK_EQ(p2.y(), doctest::Approx(-1.f));
     CHECK_EQ(p2.z(), 0.f);
 }
@@ -107,6 +177,121 @@ TEST_CASE("translator-line")
     CHECK_EQ(l2.e23(), -6.f);
 }
 
+TEST_CASE("translator-variadic")
+{
+    float data[4] = {0.f, -5.f, -2.f, 2.f};
+    translator t;
+    t.load_normalized(data);
+
+    point points[3] = {{1.f, 0.f, 0.f}, {-1.f, 2.f, 3.f}, {4.f, -2.f, -1.f}};
+    point points2[3];
+    t(points, points2, 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        point q = t(points[i]);
+        CHECK_EQ(points2[i].x(), q.x());
+        CHECK_EQ(points2[i].y(), q.y());
+        CHECK_EQ(points2[i].z(), q.z());
+        CHECK_EQ(points2[i].w(), q.w());
+    }
+
+    plane planes[2] = {{3.f, 2.f, 1.f, -1.f}, {1.f, 2.f, -1.f, -3.f}};
+    plane planes2[2];
+    t(planes, planes2, 2);
+    for (size_t i = 0; i != 2; ++i)
+    {
+        CHECK_EQ(planes2[i], t(planes[i]));
+    }
+
+    line lines[2]
+        = {{-1.f, 2.f, -3.f, -6.f, 5.f, 4.f}, {1.f, 0.f, 2.f, 1.f, 3.f, 2.f}};
+    t(lines, lines, 2);
+    CHECK_EQ(lines[0].e01(), 35.f);
+    CHECK_EQ(lines[0].e02(), -14.f);
+    CHECK_EQ(lines[0].e03(), 71.f);
+    CHECK_EQ(lines[0].e12(), 4.f);
+    CHECK_EQ(lines[0].e31(), 5.f);
+    CHECK_EQ(lines[0].e23(), -6.f);
+
+    // In place application matches the out of place result
+    t(points, points, 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        CHECK_EQ(points[i].x(), points2[i].x());
+        CHECK_EQ(points[i].y(), points2[i].y());
+        CHECK_EQ(points[i].z(), points2[i].z());
+        CHECK_EQ(points[i].w(), points2[i].w());
+    }
+}
+
+TEST_CASE("transform-vertices")
+{
+    struct vertex
+    {
+        float position[3];
+        float normal[3];
+        float tangent[3];
+        float uv[2];
+    };
+
+    motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    m.normalize();
+
+    vertex vertices[3];
+    for (size_t i = 0; i != 3; ++i)
+    {
+        float f     = static_cast<float>(i);
+        vertices[i] = {{-1.f + f, 1.f, 2.f * f},
+                       {0.f, 1.f, f},
+                       {1.f, -f, 0.5f},
+                       {f, 2.f}};
+    }
+    vertex original[3] = {vertices[0], vertices[1], vertices[2]};
+
+    size_t directions[2]
+        = {offsetof(vertex, normal), offsetof(vertex, tangent)};
+    transform_vertices(m,
+                       vertices,
+                       3,
+                       sizeof(vertex),
+                       offsetof(vertex, position),
+                       directions,
+                       2);
+
+    for (size_t i = 0; i != 3; ++i)
+    {
+        vertex const& v = original[i];
+        point p = m(point{v.position[0], v.position[1], v.position[2]});
+        // The float constructor of direction normalizes, so set the register
+        direction n = m(direction{
+            _mm_set_ps(v.normal[2], v.normal[1], v.normal[0], 0.f)});
+        direction t = m(direction{
+            _mm_set_ps(v.tangent[2], v.tangent[1], v.tangent[0], 0.f)});
+
+        CHECK_EQ(vertices[i].position[0], doctest::Approx(p.x()));
+        CHECK_EQ(vertices[i].position[1], doctest::Approx(p.y()));
+        CHECK_EQ(vertices[i].position[2], doctest::Approx(p.z()));
+        CHECK_EQ(vertices[i].normal[0], doctest::Approx(n.x()));
+        CHECK_EQ(vertices[i].normal[1], doctest::Approx(n.y()));
+        CHECK_EQ(vertices[i].normal[2], doctest::Approx(n.z()));
+        CHECK_EQ(vertices[i].tangent[0], doctest::Approx(t.x()));
+        CHECK_EQ(vertices[i].tangent[1], doctest::Approx(t.y()));
+        CHECK_EQ(vertices[i].tangent[2], doctest::Approx(t.z()));
+        // Other attributes are untouched
+        CHECK_EQ(vertices[i].uv[0], v.uv[0]);
+        CHECK_EQ(vertices[i].uv[1], v.uv[1]);
+    }
+
+    // Rotate the normals only
+    rotor r{kln::pi * 0.5f, 0.f, 0.f, 1.f};
+    transform_vertices(
+        r, original, 3, sizeof(vertex), no_attribute, directions, 1);
+    CHECK_EQ(original[0].position[0], -1.f);
+    CHECK_EQ(original[0].normal[0], doctest::Approx(1.f));
+    CHECK_EQ(original[0].normal[1], doctest::Approx(0.f));
+    CHECK_EQ(original[0].tangent[0], 1.f);
+}
+
 TEST_CASE("construct-motor")
 {
     rotor r{kln::pi * 0.5f, 0, 0, 1.f};
@@ -114,14 +299,23 @@ TEST_CASE("construct-motor")
     motor m = r * t;
     point p1{1, 0, 0};
     point p2 = m(p1);
+#ifdef KLEIN_FMA
+    // A fused product doesn't cancel exactly with its rounded counterpart
+    CHECK_EQ(p2.x(), doctest::Approx(0.f));
+#else
     CHECK_EQ(p2.x(), 0.f);
+#endif
     CHECK_EQ(p2.y(), doctest::Approx(-1.f));
     CHECK_EQ(p2.z(), doctest::Approx(1.f));
 
     // Rotation and translation about the same axis commutes
     m  = t * r;
     p2 = m(p1);
+#ifdef KLEIN_FMA
+    CHECK_EQ(p2.x(), doctest::Approx(0.f));
+#else
     CHECK_EQ(p2.x(), 0.f);
+#endif
     CHECK_EQ(p2.y(), doctest::Approx(-1.f));
     CHECK_EQ(p2.z(), doctest::Approx(1.f));
 
@@ -232,6 +426,168 @@ TEST_CASE("motor-line-variadic")
     }
 }
 
+TEST_CASE("motor-prepared")
+{
+    motor m{2.f, 4.f, 3.f, -1.f, -5.f, 6.f, 2.f, -3.f};
+    prepared_motor pm = m.prepare();
+
+    plane planes[2] = {{3.f, 2.f, 1.f, -1.f}, {-1.f, 0.5f, 2.f, 4.f}};
+    line lines[2]
+        = {{-1.f, 2.f, -3.f, -6.f, 5.f, 4.f}, {1.f, 0.f, 2.f, 1.f, 3.f, 2.f}};
+    point points[2] = {{-1.f, 1.f, 2.f}, {4.f, -2.f, 0.5f}};
+    direction directions[2]
+        = {direction{_mm_set_ps(2.f, 1.f, -1.f, 0.f)},
+           direction{_mm_set_ps(0.f, -3.f, 1.f, 0.f)}};
+
+    for (size_t i = 0; i != 2; ++i)
+    {
+        CHECK_EQ(pm(planes[i]), m(planes[i]));
+
+        line l1 = pm(lines[i]);
+        line l2 = m(lines[i]);
+        CHECK_EQ(l1.e01(), l2.e01());
+        CHECK_EQ(l1.e02(), l2.e02());
+        CHECK_EQ(l1.e03(), l2.e03());
+        CHECK_EQ(l1.e12(), l2.e12());
+        CHECK_EQ(l1.e31(), l2.e31());
+        CHECK_EQ(l1.e23(), l2.e23());
+
+        point p1 = pm(points[i]);
+        point p2 = m(points[i]);
+        CHECK_EQ(p1.x(), p2.x());
+        CHECK_EQ(p1.y(), p2.y());
+        CHECK_EQ(p1.z(), p2.z());
+        CHECK_EQ(p1.w(), p2.w());
+
+        direction d1 = pm(directions[i]);
+        direction d2 = m(directions[i]);
+        CHECK_EQ(d1.x(), d2.x());
+        CHECK_EQ(d1.y(), d2.y());
+        CHECK_EQ(d1.z(), d2.z());
+    }
+
+    // Array overloads applied in place
+    plane planes2[2] = {m(planes[0]), m(planes[1])};
+    pm(planes, planes, 2);
+    CHECK_EQ(planes[1], planes2[1]);
+
+    line line2 = m(lines[1]);
+    pm(lines, lines, 2);
+    CHECK_EQ(lines[1].e01(), line2.e01());
+    CHECK_EQ(lines[1].e12(), line2.e12());
+
+    point point2 = m(points[1]);
+    pm(points, points, 2);
+    CHECK_EQ(points[1].x(), point2.x());
+    CHECK_EQ(points[1].z(), point2.z());
+
+    direction direction2 = m(directions[1]);
+    pm(directions, directions, 2);
+    CHECK_EQ(directions[1].x(), direction2.x());
+    CHECK_EQ(directions[1].y(), direction2.y());
+}
+
+TEST_CASE("parallel-transform")
+{
+    motor m{2.f, 4.f, 3.f, -1.f, -5.f, 6.f, 2.f, -3.f};
+    m.normalize();
+
+    // Several tiles followed by a partial tile
+    size_t count = 5 * parallel::tile_bytes / sizeof(point) + 7;
+    std::vector<point> points(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f   = static_cast<float>(i % 101);
+        points[i] = point{f, -0.5f * f, 2.f};
+    }
+    std::vector<point> expected(count);
+    m(points.data(), expected.data(), count);
+
+    auto mismatches = [&](std::vector<point> const& out) {
+        size_t n = 0;
+        for (size_t i = 0; i != count; ++i)
+        {
+            if (out[i].x() != expected[i].x() || out[i].y() != expected[i].y()
+                || out[i].z() != expected[i].z())
+            {
+                ++n;
+            }
+        }
+        return n;
+    };
+
+    parallel::thread_pool pool{4};
+    CHECK_EQ(pool.size(), 4);
+    std::vector<point> out(count);
+    parallel::transform(pool, m, points.data(), out.data(), count);
+    CHECK_EQ(mismatches(out), 0);
+
+    // The pool is reusable
+    std::fill(out.begin(), out.end(), point{});
+    parallel::transform(pool, m, points.data(), out.data(), count);
+    CHECK_EQ(mismatches(out), 0);
+
+    // In place through a user-supplied executor
+    size_t tiles = 0;
+    auto serial  = [&](size_t n, parallel::job const& j) {
+        tiles = n;
+        for (size_t i = 0; i != n; ++i)
+        {
+            j(i);
+        }
+    };
+    parallel::transform(serial, m, points.data(), points.data(), count);
+    CHECK_GT(tiles, 1);
+    CHECK_EQ(mismatches(points), 0);
+}
+
+TEST_CASE("parallel-tiles")
+{
+    // Element size, misalignment of the output, and whether tile boundaries
+    // can be aligned. The last misalignment is not a multiple of
+    // gcd(24, 64) = 8, so no element of that output starts a cache line.
+    size_t cases[5][3]
+        = {{16, 16, 1}, {32, 0, 1}, {48, 16, 1}, {12, 4, 1}, {24, 4, 0}};
+    size_t count = 10000;
+
+    for (auto const& c : cases)
+    {
+        size_t size     = c[0];
+        uintptr_t base  = 4096 + c[1];
+        void const* out = reinterpret_cast<void const*>(base);
+
+        std::vector<int> hits(count, 0);
+        size_t misaligned = 0;
+        parallel::for_each_tile(
+            [](size_t n, parallel::job const& j) {
+                for (size_t i = 0; i != n; ++i)
+                {
+                    j(i);
+                }
+            },
+            count,
+            size,
+            out,
+            [&](size_t begin, size_t end) {
+                if (begin != 0 && (base + begin * size) % 64 != 0)
+                {
+                    ++misaligned;
+                }
+                for (size_t i = begin; i != end; ++i)
+                {
+                    ++hits[i];
+                }
+            });
+
+        CHECK_EQ(std::count(hits.begin(), hits.end(), 1),
+                 static_cast<std::ptrdiff_t>(count));
+        if (c[2] != 0)
+        {
+            CHECK_EQ(misaligned, 0);
+        }
+    }
+}
+
 TEST_CASE("motor-origin")
 {
     rotor r{kln::pi * 0.5f, 0, 0, 1.f};
@@ -274,6 +630,44 @@ TEST_CASE("motor-to-matrix-3x4")
     CHECK_EQ(buf[3], 1.f);
 }
 
+TEST_CASE("motor-to-matrix-3x4-batch")
+{
+    motor ms[3];
+    ms[0] = motor{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    ms[1] = motor{2.f, -1.f, 3.f, 1.f, 4.f, -2.f, 1.f, 3.f};
+    ms[2] = motor{translator{3.f, 1.f, 0.f, 2.f}};
+    for (motor& m : ms)
+    {
+        m.normalize();
+    }
+
+    // One extra float allows for the misaligned (non-streaming) case
+    alignas(16) float buf[3 * 12 + 1];
+    for (size_t offset = 0; offset != 2; ++offset)
+    {
+        float* out = buf + offset;
+        to_mat3x4(ms, out, 3);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            mat3x4 expected = ms[i].as_mat3x4();
+            for (size_t row = 0; row != 3; ++row)
+            {
+                for (size_t col = 0; col != 4; ++col)
+                {
+#ifdef KLEIN_FMA
+                    // The kernels may be contracted differently
+                    CHECK_EQ(out[12 * i + 4 * row + col],
+                             doctest::Approx(expected.data[4 * col + row]));
+#else
+                    CHECK_EQ(out[12 * i + 4 * row + col],
+                             expected.data[4 * col + row]);
+#endif
+                }
+            }
+        }
+    }
+}
+
 TEST_CASE("normalize-motor")
 {
     motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
@@ -322,4 +716,352 @@ TEST_CASE("normalize-rotor")
     CHECK_EQ(norm.e12(), doctest::Approx(0.f));
     CHECK_EQ(norm.e31(), doctest::Approx(0.f));
     CHECK_EQ(norm.e23(), doctest::Approx(0.f));
-}
\ No newline at end of file
+}
+
+TEST_CASE("motor-point-soa")
+{
+    motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    point ps[19];
+    for (size_t i = 0; i != 19; ++i)
+    {
+        ps[i] = point{-1.f, 1.f, 2.f};
+    }
+    point_soa batch{ps, 19};
+    m(batch, batch);
+    CHECK_EQ(batch.size(), 19);
+
+    for (size_t i = 0; i != 19; ++i)
+    {
+        point p = batch.get(i);
+        CHECK_EQ(p.x(), -12.f);
+        CHECK_EQ(p.y(), -86.f);
+        CHECK_EQ(p.z(), -86.f);
+        CHECK_EQ(p.w(), 30.f);
+    }
+
+    // Padding lanes remain zeroed after application
+    CHECK_EQ(batch.w()[19], 0.f);
+
+    point ps2[19];
+    batch.store(ps2);
+    CHECK_EQ(ps2[18].x(), -12.f);
+    CHECK_EQ(ps2[18].w(), 30.f);
+}
+
+TEST_CASE("motor-plane-soa")
+{
+    motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    plane ps[5];
+    for (size_t i = 0; i != 5; ++i)
+    {
+        ps[i] = plane{3.f, 2.f, 1.f, -1.f};
+    }
+    plane_soa batch{ps, 5};
+    plane_soa out;
+    m(batch, out);
+    CHECK_EQ(out.size(), 5);
+
+    for (size_t i = 0; i != 5; ++i)
+    {
+        plane p = out.get(i);
+        CHECK_EQ(p.x(), 78.f);
+        CHECK_EQ(p.y(), 60.f);
+        CHECK_EQ(p.z(), 54.f);
+        CHECK_EQ(p.d(), 358.f);
+    }
+
+    // Streams are 64-byte aligned
+    CHECK_EQ(reinterpret_cast<uintptr_t>(out.x()) % 64, 0);
+
+    // An output that keeps a wider stride from an earlier size
+    plane_soa wide{40};
+    m(batch, wide);
+    CHECK_EQ(wide.size(), 5);
+    CHECK_NE(wide.stride(), batch.stride());
+    plane p = wide.get(4);
+    CHECK_EQ(p.x(), 78.f);
+    CHECK_EQ(p.y(), 60.f);
+    CHECK_EQ(p.z(), 54.f);
+    CHECK_EQ(p.d(), 358.f);
+}
+
+TEST_CASE("rotor-point-soa")
+{
+    rotor r{kln::pi * 0.5f, 0, 0, 1.f};
+    point_soa batch{1};
+    batch.set(0, point{1, 0, 0});
+    r(batch, batch);
+    point p = batch.get(0);
+    CHECK_EQ(p.x(), doctest::Approx(0.f));
+    CHECK_EQ(p.y(), doctest::Approx(-1.f));
+    CHECK_EQ(p.z(), 0.f);
+}
+
+TEST_CASE("motor-soa-compose")
+{
+    motor as[19];
+    motor bs[19];
+    for (size_t i = 0; i != 19; ++i)
+    {
+        float f = static_cast<float>(i % 5);
+        as[i]   = motor{1.f, 4.f - f, 3.f, 2.f + f, 5.f, 6.f, 7.f - f, 8.f};
+        bs[i]   = motor{2.f, -1.f, 3.f + f, 1.f, 4.f, -2.f + f, 1.f, 3.f};
+    }
+    motor_soa a{as, 19};
+    motor_soa b{bs, 19};
+    motor_soa ab = a * b;
+    CHECK_EQ(ab.size(), 19);
+
+    // Padding lanes remain zeroed after composition
+    CHECK_EQ(ab.e0123()[19], 0.f);
+
+    motor out[19];
+    ab.store(out);
+    for (size_t i = 0; i != 19; ++i)
+    {
+        motor expected = as[i] * bs[i];
+        CHECK_EQ(out[i].scalar(), expected.scalar());
+        CHECK_EQ(out[i].e12(), expected.e12());
+        CHECK_EQ(out[i].e31(), expected.e31());
+        CHECK_EQ(out[i].e23(), expected.e23());
+        CHECK_EQ(out[i].e01(), expected.e01());
+        CHECK_EQ(out[i].e02(), expected.e02());
+        CHECK_EQ(out[i].e03(), expected.e03());
+        CHECK_EQ(out[i].e0123(), expected.e0123());
+    }
+
+    // In place composition
+    compose(a, b, a);
+    motor m = a.get(18);
+    CHECK_EQ(m.e0123(), out[18].e0123());
+    CHECK_EQ(m.e23(), out[18].e23());
+}
+
+TEST_CASE("motor-soa-point")
+{
+    motor_soa ms{19};
+    point_soa ps{19};
+    for (size_t i = 0; i != 19; ++i)
+    {
+        float f = static_cast<float>(i % 3);
+        ms.set(i, motor{1.f, 4.f, 3.f - f, 2.f, 5.f + f, 6.f, 7.f, 8.f});
+        ps.set(i, point{-1.f, 1.f + f, 2.f});
+    }
+    ms(ps, ps);
+
+    point p = ps.get(0);
+    CHECK_EQ(p.x(), -12.f);
+    CHECK_EQ(p.y(), -86.f);
+    CHECK_EQ(p.z(), -86.f);
+    CHECK_EQ(p.w(), 30.f);
+
+    for (size_t i = 0; i != 19; ++i)
+    {
+        float f        = static_cast<float>(i % 3);
+        motor m        = motor{1.f, 4.f, 3.f - f, 2.f, 5.f + f, 6.f, 7.f, 8.f};
+        point expected = m(point{-1.f, 1.f + f, 2.f});
+        p              = ps.get(i);
+        CHECK_EQ(p.x(), expected.x());
+        CHECK_EQ(p.y(), expected.y());
+        CHECK_EQ(p.z(), expected.z());
+        CHECK_EQ(p.w(), expected.w());
+    }
+}
+
+TEST_CASE("motor-soa-plane")
+{
+    motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    motor_soa ms{5};
+    plane_soa ps{5};
+    for (size_t i = 0; i != 5; ++i)
+    {
+        ms.set(i, m);
+        ps.set(i, plane{3.f, 2.f, 1.f, -1.f});
+    }
+    plane_soa out;
+    ms(ps, out);
+    CHECK_EQ(out.size(), 5);
+
+    for (size_t i = 0; i != 5; ++i)
+    {
+        plane p = out.get(i);
+        CHECK_EQ(p.x(), 78.f);
+        CHECK_EQ(p.y(), 60.f);
+        CHECK_EQ(p.z(), 54.f);
+        CHECK_EQ(p.d(), 358.f);
+    }
+}
+
+namespace
+{
+// The cube [-1, 1]^3 with some planes scaled to exercise normalization
+frustum unit_cube()
+{
+    return frustum{plane{1.f, 0.f, 0.f, 1.f},
+                   plane{-2.f, 0.f, 0.f, 2.f},
+                   plane{0.f, 1.f, 0.f, 1.f},
+                   plane{0.f, -1.f, 0.f, 1.f},
+                   plane{0.f, 0.f, 3.f, 3.f},
+                   plane{0.f, 0.f, -1.f, 1.f}};
+}
+
+bool visible_bit(uint32_t const* mask, size_t i)
+{
+    return (mask[i / 32] >> (i % 32)) & 1;
+}
+} // namespace
+
+TEST_CASE("cull-spheres")
+{
+    frustum f = unit_cube();
+    CHECK_EQ(f[1].x(), doctest::Approx(-1.f));
+
+    constexpr size_t count = 37;
+    sphere_soa spheres{count};
+    for (size_t i = 0; i != count; ++i)
+    {
+        spheres.set(i, point{-3.f + 0.2f * i, 0.5f, 0.f}, 0.5f);
+    }
+    CHECK_EQ(spheres.center(3).x(), doctest::Approx(-2.4f));
+
+    uint32_t visible[2] = {~0u, ~0u};
+    cull(f, spheres, visible);
+    for (size_t i = 0; i != count; ++i)
+    {
+        CHECK_EQ(visible_bit(visible, i), i >= 8 && i <= 22);
+    }
+    // Bits past the final sphere are cleared
+    CHECK_EQ(visible[1] >> (count % 32), 0);
+
+    point centers[3] = {{0.f, 0.f, 0.f}, {0.f, 0.f, 5.f}, {0.f, 0.f, -1.4f}};
+    float radii[3]   = {0.1f, 4.5f, 0.3f};
+    sphere_soa loaded{centers, radii, 3};
+    CHECK_EQ(loaded.radius()[1], 4.5f);
+    cull(f, loaded, visible);
+    CHECK_EQ(visible[0], 0b011);
+}
+
+TEST_CASE("cull-aabbs")
+{
+    frustum f = unit_cube();
+
+    constexpr size_t count = 21;
+    point mins[count];
+    point maxs[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float x = -3.f + 0.3f * i;
+        mins[i] = point{x - 0.25f, -0.5f, -0.1f};
+        maxs[i] = point{x + 0.25f, 0.5f, 0.1f};
+    }
+    aabb_soa boxes{mins, maxs, count};
+    CHECK_EQ(boxes.hx()[0], doctest::Approx(0.25f));
+    CHECK_EQ(boxes.hy()[0], doctest::Approx(0.5f));
+
+    uint32_t visible = ~0u;
+    cull(f, boxes, &visible);
+    for (size_t i = 0; i != count; ++i)
+    {
+        float x = -3.f + 0.3f * i;
+        CHECK_EQ(visible_bit(&visible, i), x >= -1.25f && x <= 1.25f);
+    }
+    CHECK_EQ(visible >> count, 0);
+}
+
+TEST_CASE("cull-motor")
+{
+    frustum f = unit_cube();
+
+    // Model space bounds at the origin, moved by one motor per instance
+    constexpr size_t count = 19;
+    motor_soa motors{count};
+    sphere_soa spheres{count};
+    aabb_soa boxes{count};
+    for (size_t i = 0; i != count; ++i)
+    {
+        rotor r{i % 2 == 0 ? 0.f : pi * 0.5f, 0.f, 0.f, 1.f};
+        translator t{-2.f + 0.25f * i, 1.f, 0.2f, 0.f};
+        motors.set(i, t * r);
+        spheres.set(i, point{0.5f, 0.f, 0.f}, 0.25f);
+        boxes.set(i, point{-1.f, -0.1f, -0.1f}, point{1.f, 0.1f, 0.1f});
+    }
+
+    uint32_t sphere_visible = 0;
+    uint32_t box_visible    = 0;
+    cull(f, motors, spheres, &sphere_visible);
+    cull(f, motors, boxes, &box_visible);
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        motor m = motors.get(i);
+        point c = m(point{0.5f, 0.f, 0.f});
+        bool in = true;
+        for (size_t j = 0; j != 6; ++j)
+        {
+            plane p = f[j];
+            float e = p.x() * c.x() + p.y() * c.y() + p.z() * c.z() + p.d();
+            in      = in && e >= -0.25f;
+        }
+        CHECK_EQ(visible_bit(&sphere_visible, i), in);
+
+        // Rotating by pi/2 about z swaps the x and y extents of the box
+        point o     = m(point{0.f, 0.f, 0.f});
+        float hx    = i % 2 == 0 ? 1.f : 0.1f;
+        float hy    = i % 2 == 0 ? 0.1f : 1.f;
+        bool box_in = std::abs(o.x()) <= 1.f + hx
+                      && std::abs(o.y()) <= 1.f + hy;
+        CHECK_EQ(visible_bit(&box_visible, i), box_in);
+    }
+}
+
+TEST_CASE("skin-rigid")
+{
+    motor palette[2] = {motor{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f},
+                        motor{2.f, -1.f, 3.f, 1.f, 4.f, -2.f, 1.f, 3.f}};
+    uint32_t indices[5] = {0, 0, 1, 1, 0};
+    point ps[5];
+    for (size_t i = 0; i != 5; ++i)
+    {
+        ps[i] = point{-1.f + i, 1.f, 2.f - i};
+    }
+
+    point out[5];
+    skin(palette, indices, ps, out, 5);
+
+    for (size_t i = 0; i != 5; ++i)
+    {
+        point expected = palette[indices[i]](ps[i]);
+        CHECK_EQ(out[i].x(), expected.x());
+        CHECK_EQ(out[i].y(), expected.y());
+        CHECK_EQ(out[i].z(), expected.z());
+        CHECK_EQ(out[i].w(), expected.w());
+    }
+    CHECK_EQ(out[0].x(), -12.f);
+    CHECK_EQ(out[0].y(), -86.f);
+    CHECK_EQ(out[0].z(), -86.f);
+    CHECK_EQ(out[0].w(), 30.f);
+}
+
+TEST_CASE("skin-blend")
+{
+    motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};
+    m.normalize();
+    // The second motor performs the same action as the first with the
+    // opposite sign and must not cancel it when blended
+    motor palette[2] = {m, -m};
+    uint32_t indices[8] = {0, 1, 0, 0, 1, 0, 0, 0};
+    float weights[8]    = {0.25f, 0.75f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f};
+    point ps[2]         = {point{-1.f, 1.f, 2.f}, point{3.f, -2.f, 1.f}};
+
+    point out[2];
+    skin(palette, indices, weights, ps, out, 2);
+
+    for (size_t i = 0; i != 2; ++i)
+    {
+        point expected = m(ps[i]);
+        CHECK_EQ(out[i].x(), doctest::Approx(expected.x()));
+        CHECK_EQ(out[i].y(), doctest::Approx(expected.y()));
+        CHECK_EQ(out[i].z(), doctest::Approx(expected.z()));
+        CHECK_EQ(out[i].w(), doctest::Approx(expected.w()));
+    }
+}